@@ -27,6 +27,62 @@ set(WHISPER_BUILD_SERVER OFF CACHE BOOL "Build whisper server" FORCE)
 # because WHISPER_BUILD_EXAMPLES is OFF.
 # Java bindings are not built by default in the main CMakeLists.txt.
 
+# ------------------------------------------------------------------------------
+# CPU backend tuning
+#
+# whisper.cpp v1.5.4 compiles its ggml kernels for one fixed x86 SIMD level
+# (AVX/AVX2/FMA/F16C unless disabled) and has no runtime kernel selection.
+# VOXSCRIPT_WHISPER_CPU_LEVEL picks that level; the plugin checks the host
+# CPU against it at runtime (WhisperSystemInfo) and refuses to load models
+# instead of crashing with an illegal instruction. Shipping one binary per
+# level is the supported way to cover old and new CPUs.
+#
+#   SSE3    - any x86-64 CPU, slowest
+#   AVX     - Sandy Bridge and later
+#   AVX2    - Haswell / Zen and later (default, whisper.cpp's own default)
+#   AVX512  - AVX2 plus AVX-512F/BW/VL kernels (Skylake-X, Ice Lake, Zen 4)
+#   NATIVE  - -march=native, for local builds only
+# ------------------------------------------------------------------------------
+set(VOXSCRIPT_WHISPER_CPU_LEVEL "AVX2" CACHE STRING "Minimum x86 SIMD level for whisper.cpp (SSE3, AVX, AVX2, AVX512, NATIVE)")
+set_property(CACHE VOXSCRIPT_WHISPER_CPU_LEVEL PROPERTY STRINGS SSE3 AVX AVX2 AVX512 NATIVE)
+
+option(VOXSCRIPT_WHISPER_OPENBLAS "Use OpenBLAS for whisper.cpp matrix products (non-Apple)" OFF)
+
+# Numeric level for the runtime check (-1 = not checked)
+set(VOXSCRIPT_WHISPER_CPU_LEVEL_ID -1)
+
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86)$" AND NOT (APPLE AND UniversalBinary))
+    if(VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "SSE3")
+        set(VOXSCRIPT_WHISPER_CPU_LEVEL_ID 0)
+        set(WHISPER_NO_AVX  ON CACHE BOOL "" FORCE)
+        set(WHISPER_NO_AVX2 ON CACHE BOOL "" FORCE)
+        set(WHISPER_NO_FMA  ON CACHE BOOL "" FORCE)
+        set(WHISPER_NO_F16C ON CACHE BOOL "" FORCE)
+    elseif(VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "AVX")
+        set(VOXSCRIPT_WHISPER_CPU_LEVEL_ID 1)
+        set(WHISPER_NO_AVX  OFF CACHE BOOL "" FORCE)
+        set(WHISPER_NO_AVX2 ON CACHE BOOL "" FORCE)
+        set(WHISPER_NO_FMA  ON CACHE BOOL "" FORCE)
+        set(WHISPER_NO_F16C OFF CACHE BOOL "" FORCE)
+    elseif(VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "AVX2" OR VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "AVX512")
+        set(VOXSCRIPT_WHISPER_CPU_LEVEL_ID 2)
+        set(WHISPER_NO_AVX  OFF CACHE BOOL "" FORCE)
+        set(WHISPER_NO_AVX2 OFF CACHE BOOL "" FORCE)
+        set(WHISPER_NO_FMA  OFF CACHE BOOL "" FORCE)
+        set(WHISPER_NO_F16C OFF CACHE BOOL "" FORCE)
+        if(VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "AVX512")
+            set(VOXSCRIPT_WHISPER_CPU_LEVEL_ID 3)
+        endif()
+    endif()
+
+    message(STATUS "whisper.cpp: CPU level ${VOXSCRIPT_WHISPER_CPU_LEVEL}")
+endif()
+
+if(VOXSCRIPT_WHISPER_OPENBLAS AND NOT APPLE)
+    set(WHISPER_OPENBLAS ON CACHE BOOL "Enable OpenBLAS" FORCE)
+    message(STATUS "whisper.cpp: OpenBLAS enabled")
+endif()
+
 # Enable Metal acceleration on macOS (optional, but recommended)
 if(APPLE)
     set(WHISPER_METAL ON CACHE BOOL "Enable Metal acceleration" FORCE)
@@ -36,6 +92,19 @@ endif()
 # Fetch the content (download if not already present)
 FetchContent_MakeAvailable(whisper)
 
+# Extra kernel flags whisper.cpp has no option for
+if(TARGET whisper AND VOXSCRIPT_WHISPER_CPU_LEVEL_ID GREATER_EQUAL 0)
+    if(VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "AVX512")
+        if(MSVC)
+            target_compile_options(whisper PRIVATE /arch:AVX512)
+        else()
+            target_compile_options(whisper PRIVATE -mavx512f -mavx512bw -mavx512vl)
+        endif()
+    endif()
+elseif(TARGET whisper AND VOXSCRIPT_WHISPER_CPU_LEVEL STREQUAL "NATIVE" AND NOT MSVC)
+    target_compile_options(whisper PRIVATE -march=native)
+endif()
+
 # Create alias target for easier linking
 if(TARGET whisper)
     add_library(whisper::whisper ALIAS whisper)
@@ -37,6 +37,19 @@ VoxScriptAudioProcessorEditor::VoxScriptAudioProcessorEditor (VoxScriptAudioProc
     araStatusLabel.setColour (juce::Label::textColourId, juce::Colours::grey);
     addAndMakeVisible (araStatusLabel);
     updateARAStatus();
+
+    // Load policy: item ids are the RealtimeLoadGovernor::Policy values + 1
+    loadPolicyBox.addItem ("Transcribe: Aggressive", (int) RealtimeLoadGovernor::Policy::Aggressive + 1);
+    loadPolicyBox.addItem ("Transcribe: Balanced", (int) RealtimeLoadGovernor::Policy::Balanced + 1);
+    loadPolicyBox.addItem ("Transcribe: When stopped", (int) RealtimeLoadGovernor::Policy::BackgroundOnly + 1);
+    loadPolicyBox.setTooltip ("How much transcription runs while the host plays");
+    loadPolicyBox.onChange = [this]
+    {
+        if (auto* controller = processorRef.getVoxScriptDocumentController())
+            controller->setTranscriptionLoadPolicy ((RealtimeLoadGovernor::Policy) (loadPolicyBox.getSelectedId() - 1));
+    };
+    addAndMakeVisible (loadPolicyBox);
+    updateLoadPolicy();
     
     // Add views
     addAndMakeVisible (scriptView);
@@ -94,6 +107,9 @@ void VoxScriptAudioProcessorEditor::resized()
     // ARA status in top-right of header
     auto statusBounds = headerBounds.removeFromRight (200).reduced (10, 15);
     araStatusLabel.setBounds (statusBounds);
+
+    // Load policy in top-left
+    loadPolicyBox.setBounds (headerBounds.removeFromLeft (200).reduced (10, 12));
     
     // Split remaining space between script and detail views
     auto splitY = static_cast<int> (bounds.getHeight() * splitRatio);
@@ -111,13 +127,25 @@ void VoxScriptAudioProcessorEditor::resized()
 void VoxScriptAudioProcessorEditor::transcriptionUpdated (juce::ARAAudioSource* source)
 {
     DBG ("Editor: Transcription updated notification received");
-    juce::ignoreUnused (source);
     
     // Update the script view with transcription from document controller
     if (auto* controller = processorRef.getVoxScriptDocumentController())
     {
         scriptView.setTranscription (controller->getTranscription());
         scriptView.setStatus (controller->getTranscriptionStatus());
+        updateLoadPolicy(); // May have come with a restored document
+
+        // Spectrogram computed by the transcription worker, if it has one.
+        // Deferred updates name no source; show the one that finished last.
+        std::optional<AudioSourceID> id;
+
+        if (source != nullptr)
+            id = controller->getStore().findAudioSourceID (source);
+        else if (auto last = controller->getLastCompletedSourceID(); last != 0)
+            id = last;
+
+        if (id.has_value())
+            detailView.setSpectrogram (controller->getSpectrogramService().find (*id));
     }
 }
 
@@ -138,4 +166,12 @@ void VoxScriptAudioProcessorEditor::updateARAStatus()
     }
 }
 
+void VoxScriptAudioProcessorEditor::updateLoadPolicy()
+{
+    if (auto* controller = processorRef.getVoxScriptDocumentController())
+        loadPolicyBox.setSelectedId ((int) controller->getTranscriptionLoadPolicy() + 1, juce::dontSendNotification);
+    else
+        loadPolicyBox.setEnabled (false);
+}
+
 } // namespace VoxScript
@@ -62,12 +62,16 @@ private:
     
     juce::Label headerLabel;
     juce::Label araStatusLabel;
+    juce::ComboBox loadPolicyBox; // Transcription during playback, see RealtimeLoadGovernor::Policy
     
     // Splitter between script and detail views
     float splitRatio { 0.65f };  // 65% for script view, 35% for detail view
     
     // Phase I helper
     void updateARAStatus();
+
+    /** Show the document's load policy in loadPolicyBox. */
+    void updateLoadPolicy();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoxScriptAudioProcessorEditor)
 };
@@ -13,6 +13,7 @@
 #include "VoxScriptAudioSource.h"
 #include "VoxScriptPlaybackRenderer.h"
 #include "../util/VoxLogger.h"
+#include <algorithm>
 
 namespace VoxScript
 {
@@ -35,6 +36,9 @@ VoxScriptDocumentController::~VoxScriptDocumentController()
     if (controllerAlive)
         controllerAlive->store(false);
 
+    // Cancel a warm-up that has not finished yet
+    modelWarmup.reset();
+
     DBG ("================================================");
     DBG ("VOXSCRIPT: Document Controller DESTROYED");
     DBG ("================================================");
@@ -57,6 +61,7 @@ void VoxScriptDocumentController::ensureTranscriptionInfraInitialised()
     DBG ("VoxScriptDocumentController: Initialising Transcription Infrastructure (Lazy)");
 
     // Mission 3: Initialize TranscriptionJobQueue
+    jobQueue.setSpectrogramService(&spectrogramService);
     jobQueue.initialise(&documentStore);
     
     auto alive = controllerAlive;
@@ -69,10 +74,15 @@ void VoxScriptDocumentController::ensureTranscriptionInfraInitialised()
         if (!alive || !alive->load())
             return;
              
+        lastCompletedSourceID.store(id);
         storeDirty.store(true);
     });
     
     // Mission 2: Audio Cache configured (WhisperEngine setup removed as it is now internal to worker)
+
+    // Opt-in: load the model now instead of inside the first job
+    if (WhisperModelWarmup::isEnabledByEnvironment())
+        warmUpTranscriptionModel();
 }
 
 //==============================================================================
@@ -96,34 +106,11 @@ void VoxScriptDocumentController::didAddAudioSourceToDocument (juce::ARADocument
     
     ensureTranscriptionInfraInitialised();
     
-    // Mission 3: Enqueue transcription immediately if possible
+    // Mission 3: Enqueue transcription if possible
     // Note: Audio source usually doesn't have sample access enabled yet creates.
-    // However, if it does, we can queue it.
-    
+    // However, if it does, we can queue it (at the end of the host's edit cycle).
     if (audioSource->isSampleAccessEnabled())
-    {
-        AudioSourceID id = documentStore.getOrCreateAudioSourceID(audioSource);
-        
-        // Extract audio to temp file immediately
-        // Note: This blocks momentarily but ensures we have a file before background job starts
-        // or we could push this to the background too? 
-        // Mission says: "extract to temp WAV immediately ... enqueue job with audioFile only"
-        
-        // Ensure availability in cache first (optional, but good for other parts of app)
-        audioCache.ensureCached(audioSource, audioSource);
-        
-        juce::File jobFile = AudioExtractor::extractToTempWAV(audioSource, audioCache);
-        
-        if (jobFile.existsAsFile())
-        {
-            TranscriptionJob job;
-            job.sourceID = id;
-            job.audioFile = jobFile;
-            
-            DBG ("VoxScriptDocumentController: Enqueuing initial transcription for source " + juce::String(id));
-            jobQueue.enqueueTranscription(job);
-        }
-    }
+        enqueueTranscriptionForSource(audioSource);
     
     // Mission 4: Signal that we are ready for background work
     // We only enable this after the source is fully added and infra is ready.
@@ -148,9 +135,13 @@ void VoxScriptDocumentController::doDestroyAudioSource (
         
         // Cancel pending jobs
         jobQueue.cancelForAudioSource(id);
+        scheduledSourceRanges.erase(id);
+        deferredTranscriptionSources.erase(std::remove(deferredTranscriptionSources.begin(), deferredTranscriptionSources.end(), audioSource),
+                                           deferredTranscriptionSources.end());
     
         // Remove from cache (by pointer, which is what the cache expects)
         audioCache.remove(audioSource);
+        spectrogramService.invalidate(id);
         
         // Remove from store by ID and cleanup mapping
         documentStore.removeAudioSourceByID(id);
@@ -207,7 +198,8 @@ juce::ARAPlaybackRegion* VoxScriptDocumentController::doCreatePlaybackRegion (
         // Check if we have transcription
         const auto* sequence = documentStore.makeSnapshot().getSequence(id);
         
-        if (sequence == nullptr || sequence->getWordCount() == 0)
+        // Also when the last session left its work unfinished (crash, or closed mid-transcription)
+        if (sequence == nullptr || sequence->getWordCount() == 0 || jobQueue.hasJournaledWork(getJournalID(audioSource)))
         {
              if (audioSource->isSampleAccessEnabled())
              {
@@ -235,6 +227,112 @@ juce::ARAPlaybackRenderer* VoxScriptDocumentController::doCreatePlaybackRenderer
     return new VoxScriptPlaybackRenderer (getDocumentController());
 }
 
+juce::ARAEditorView* VoxScriptDocumentController::doCreateEditorView() noexcept
+{
+    auto* editorView = new juce::ARAEditorView (getDocumentController());
+    editorView->addListener (this);
+    return editorView;
+}
+
+void VoxScriptDocumentController::willBeginEditing (juce::ARADocument* document)
+{
+    juce::ignoreUnused (document);
+    hostIsEditing = true;
+}
+
+void VoxScriptDocumentController::didEndEditing (juce::ARADocument* document)
+{
+    hostIsEditing = false;
+
+    // One extraction per source, however many notifications asked for it
+    auto requested = std::move (deferredTranscriptionSources);
+    deferredTranscriptionSources.clear();
+
+    for (auto* audioSource : requested)
+        enqueueTranscriptionForSource (audioSource);
+
+    // Regions moved onto audio that was deferred: transcribe it now
+    for (auto* audioSource : document->getAudioSources<juce::ARAAudioSource>())
+    {
+        auto id = documentStore.findAudioSourceID (audioSource);
+        if (!id.has_value())
+            continue;
+
+        auto scheduled = scheduledSourceRanges.find (*id);
+        if (scheduled == scheduledSourceRanges.end())
+            continue;
+
+        auto used = getUsedSourceRanges (audioSource);
+        if (used.isEmpty())
+            used = { { 0.0, getSourceDurationSeconds (audioSource) } };
+
+        if (!SourceRanges::covers (scheduled->second, used))
+            enqueueTranscriptionForSource (audioSource);
+    }
+
+    // Region positions only change inside an edit cycle
+    for (auto* audioSource : document->getAudioSources<juce::ARAAudioSource>())
+        if (documentStore.findAudioSourceID (audioSource).has_value())
+            updateSourcePlacement (audioSource);
+}
+
+void VoxScriptDocumentController::onNewSelection (const juce::ARAViewSelection& viewSelection)
+{
+    transcriptionFocus.selectedSources.clear();
+
+    for (auto* region : viewSelection.getPlaybackRegions<juce::ARAPlaybackRegion>())
+    {
+        auto* audioSource = region->getAudioModification<juce::ARAAudioModification>()->getAudioSource<juce::ARAAudioSource>();
+
+        if (auto id = documentStore.findAudioSourceID (audioSource))
+            transcriptionFocus.selectedSources.insert (*id);
+    }
+
+    jobQueue.setFocus (transcriptionFocus);
+}
+
+void VoxScriptDocumentController::onHideRegionSequences (const std::vector<juce::ARARegionSequence*>& regionSequences)
+{
+    // A source is hidden if none of its regions is on a visible track
+    std::set<juce::ARARegionSequence*> hidden (regionSequences.begin(), regionSequences.end());
+    std::set<juce::ARAAudioSource*> candidates;
+
+    for (auto* sequence : regionSequences)
+        for (auto* region : sequence->getPlaybackRegions<juce::ARAPlaybackRegion>())
+            candidates.insert (region->getAudioModification<juce::ARAAudioModification>()->getAudioSource<juce::ARAAudioSource>());
+
+    transcriptionFocus.hiddenSources.clear();
+
+    for (auto* audioSource : candidates)
+    {
+        bool visible = false;
+
+        for (auto* modification : audioSource->getAudioModifications<juce::ARAAudioModification>())
+            for (auto* region : modification->getPlaybackRegions<juce::ARAPlaybackRegion>())
+                visible = visible || hidden.count (region->getRegionSequence<juce::ARARegionSequence>()) == 0;
+
+        if (auto id = documentStore.findAudioSourceID (audioSource); id.has_value() && !visible)
+            transcriptionFocus.hiddenSources.insert (*id);
+    }
+
+    jobQueue.setFocus (transcriptionFocus);
+}
+
+void VoxScriptDocumentController::updateSourcePlacement(juce::ARAAudioSource* source)
+{
+    auto id = documentStore.findAudioSourceID(source);
+    if (!id.has_value())
+        return;
+
+    juce::Array<juce::Range<double>> ranges;
+
+    for (auto* modification : source->getAudioModifications<juce::ARAAudioModification>())
+        for (auto* region : modification->getPlaybackRegions<juce::ARAPlaybackRegion>())
+            ranges.add({ region->getStartInPlaybackTime(), region->getEndInPlaybackTime() });
+
+    jobQueue.setSourcePlacement(*id, ranges);
+}
+
 //==============================================================================
 // State Persistence
 //==============================================================================
@@ -255,6 +353,17 @@ bool VoxScriptDocumentController::doRestoreObjectsFromStream (juce::ARAInputStre
         if (documentStore.deserialize(data.getData(), data.getSize()))
         {
             DBG ("VOXSCRIPT: Document store deserialized successfully.");
+
+            // The project's load policy, if it was saved with one
+            if (const auto policyName = documentStore.getLoadPolicyName(); policyName.isNotEmpty())
+                jobQueue.getLoadGovernor().setPolicy(RealtimeLoadGovernor::policyFromString(policyName));
+
+            // Sources created before the archive was read get their archived IDs back
+            if (auto* document = getDocumentController()->getDocument<juce::ARADocument>())
+                for (auto* audioSource : document->getAudioSources<juce::ARAAudioSource>())
+                    documentStore.bindRestoredAudioSource(audioSource);
+
+            resumeJournaledWork();
             return true;
         }
     }
@@ -294,20 +403,69 @@ void VoxScriptDocumentController::enqueueTranscriptionForSource(juce::ARAAudioSo
         DBG ("VoxScriptDocumentController: Warning - enqueue requested but sample access disabled");
         return;
     }
-    
+
+    if (hostIsEditing)
+    {
+        // Coalesce: the host may notify several times per source in one cycle
+        if (std::find(deferredTranscriptionSources.begin(), deferredTranscriptionSources.end(), source) == deferredTranscriptionSources.end())
+            deferredTranscriptionSources.push_back(source);
+        return;
+    }
+
+    scheduleTranscription(source);
+}
+
+void VoxScriptDocumentController::scheduleTranscription(juce::ARAAudioSource* source, bool languageChanged)
+{
     AudioSourceID id = documentStore.getOrCreateAudioSourceID(source);
+    const auto usedRanges = getUsedSourceRanges(source);
+
+    // Already waiting for a worker: its extracted audio is still current
+    // (but its language isn't after a change)
+    if (!languageChanged && jobQueue.hasPendingJob(id, usedRanges))
+    {
+        DBG ("VoxScriptDocumentController: Source " + juce::String(id) + " already queued");
+        return;
+    }
     
     // Ensure caching (good practice)
+    const auto cacheStartMs = TranscriptionTrace::now();
     audioCache.ensureCached(source, source);
     
     // Extract to temp WAV immediately
+    const auto extractStartMs = TranscriptionTrace::now();
     juce::File jobFile = AudioExtractor::extractToTempWAV(source, audioCache);
     
     if (jobFile.existsAsFile())
     {
-        TranscriptionJob job;
-        job.sourceID = id;
-        job.audioFile = jobFile;
+        TranscriptionJob job = makeTranscriptionJob(id, jobFile);
+        job.persistentID = getJournalID(source);
+
+        // One pass with the selected model; the worker holding the audio only decodes it again
+        if (languageChanged && job.language.isNotEmpty())
+        {
+            job.redecode = true;
+            job.pass = TranscriptionJob::Pass::Single;
+            job.modelId = getTranscriptionModel();
+            job.refineModelId = {};
+        }
+
+        job.trace.add(TranscriptionStage::CacheFill, cacheStartMs, extractStartMs);
+        job.trace.addUntilNow(TranscriptionStage::Extraction, extractStartMs);
+        job.durationSeconds = getSourceDurationSeconds(source);
+        spectrogramService.invalidate(id); // New content; the worker recomputes it
+        updateSourcePlacement(source);
+
+        // Region-scoped: what the timeline plays first, the rest in the background
+        if (!usedRanges.isEmpty())
+        {
+            job.sourceRanges = usedRanges;
+            job.deferredRanges = SourceRanges::subtract({ { 0.0, job.durationSeconds } }, usedRanges);
+        }
+
+        // What didEndEditing() compares moved regions against
+        scheduledSourceRanges[id] = usedRanges.isEmpty() ? SourceRanges::RangeList { { 0.0, job.durationSeconds } }
+                                                         : usedRanges;
         
         DBG ("VoxScriptDocumentController: Enqueuing transcription request (safe file) for source " + juce::String(id));
         jobQueue.enqueueTranscription(job);
@@ -318,6 +476,144 @@ void VoxScriptDocumentController::enqueueTranscriptionForSource(juce::ARAAudioSo
     }
 }
 
+juce::String VoxScriptDocumentController::getJournalID(const juce::ARAAudioSource* source)
+{
+    return source != nullptr ? juce::String(source->getPersistentID()) : juce::String();
+}
+
+void VoxScriptDocumentController::resumeJournaledWork()
+{
+    auto* document = getDocumentController()->getDocument<juce::ARADocument>();
+    if (document == nullptr)
+        return;
+
+    // Restoring happens inside an edit cycle, so these are extracted in didEndEditing()
+    for (auto* audioSource : document->getAudioSources<juce::ARAAudioSource>())
+    {
+        if (jobQueue.hasJournaledWork(getJournalID(audioSource)))
+        {
+            DBG ("VoxScriptDocumentController: Resuming unfinished transcription of " + getJournalID(audioSource));
+            enqueueTranscriptionForSource(audioSource);
+        }
+    }
+}
+
+TranscriptionJob VoxScriptDocumentController::makeTranscriptionJob(AudioSourceID id, const juce::File& audioFile) const
+{
+    TranscriptionJob job;
+    job.sourceID = id;
+    job.audioFile = audioFile;
+    job.modelId = getTranscriptionModel();
+    job.language = documentStore.getSourceLanguage(id); // Empty until detected once
+
+    // Progressive mode: publish a fast draft first, refine with the selected model afterwards
+    if (twoPassEnabled.load())
+    {
+        auto draftModel = WhisperModelCatalogue::findInstalledForTier(WhisperModelInfo::Tier::Draft);
+        auto targetModel = WhisperModelCatalogue::findModel(job.modelId);
+
+        if (draftModel.isValid() && targetModel.isValid()
+            && draftModel.id != targetModel.id
+            && draftModel.relativeSpeed > targetModel.relativeSpeed)
+        {
+            job.pass = TranscriptionJob::Pass::Draft;
+            job.refineModelId = job.modelId;
+            job.modelId = draftModel.id;
+        }
+    }
+
+    return job;
+}
+
+SourceRanges::RangeList VoxScriptDocumentController::getUsedSourceRanges(juce::ARAAudioSource* source)
+{
+    const double duration = getSourceDurationSeconds(source);
+    SourceRanges::RangeList used;
+
+    for (auto* modification : source->getAudioModifications<juce::ARAAudioModification>())
+    {
+        for (auto* region : modification->getPlaybackRegions<juce::ARAPlaybackRegion>())
+        {
+            const juce::Range<double> range (region->getStartInAudioModificationTime() - regionPaddingSeconds,
+                                             region->getEndInAudioModificationTime() + regionPaddingSeconds);
+            used.add(range.getIntersectionWith({ 0.0, duration }));
+        }
+    }
+
+    used = SourceRanges::normalise(used, regionMergeGapSeconds);
+
+    if (used.isEmpty() || duration <= 0.0 || SourceRanges::getTotalLength(used) >= wholeSourceCoverage * duration)
+        return {};
+
+    return used;
+}
+
+double VoxScriptDocumentController::getSourceDurationSeconds(const juce::ARAAudioSource* source)
+{
+    if (source == nullptr || source->getSampleRate() <= 0.0)
+        return 0.0;
+
+    return static_cast<double>(source->getSampleCount()) / source->getSampleRate();
+}
+
+void VoxScriptDocumentController::warmUpTranscriptionModel()
+{
+    // The first job runs the draft model when progressive mode is active
+    auto job = makeTranscriptionJob(0, {});
+    auto info = WhisperModelCatalogue::resolve(job.modelId);
+
+    if (!info.isValid())
+        return;
+
+    if (modelWarmup != nullptr && modelWarmup->getModelInfo().id == info.id)
+        return;
+
+    DBG ("VoxScriptDocumentController: Warming up model " + info.id);
+    modelWarmup = std::make_unique<WhisperModelWarmup>(info);
+    modelWarmup->start();
+}
+
+void VoxScriptDocumentController::setTranscriptionModel(const juce::String& modelId)
+{
+    DBG ("VoxScriptDocumentController: Transcription model set to " + modelId);
+    documentStore.setPreferredModelID(modelId);
+}
+
+void VoxScriptDocumentController::setTranscriptionLoadPolicy(RealtimeLoadGovernor::Policy policy)
+{
+    DBG ("VoxScriptDocumentController: Load policy set to " + RealtimeLoadGovernor::toString(policy));
+    documentStore.setLoadPolicyName(RealtimeLoadGovernor::toString(policy));
+    jobQueue.getLoadGovernor().setPolicy(policy);
+}
+
+juce::String VoxScriptDocumentController::getTranscriptionModel() const
+{
+    return WhisperModelCatalogue::resolve(documentStore.getPreferredModelID()).id;
+}
+
+void VoxScriptDocumentController::setSourceLanguage(juce::ARAAudioSource* source, const juce::String& languageCode)
+{
+    if (source == nullptr)
+        return;
+
+    const auto id = documentStore.getOrCreateAudioSourceID(source);
+    const auto code = languageCode.toLowerCase();
+
+    if (documentStore.getSourceLanguage(id) == code)
+        return;
+
+    DBG ("VoxScriptDocumentController: Language of source " + juce::String(id) + " set to '" + code + "'");
+    documentStore.setSourceLanguage(id, code);
+
+    ensureTranscriptionInfraInitialised();
+
+    // Inside an edit cycle it is extracted with the others, as a full pass
+    if (hostIsEditing || !source->isSampleAccessEnabled())
+        enqueueTranscriptionForSource(source);
+    else
+        scheduleTranscription(source, true);
+}
+
 void VoxScriptDocumentController::addListener (Listener* listener)
 {
     listeners.add (listener);
@@ -16,13 +16,17 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <atomic>
+#include <map>
 #include <memory>
+#include <vector>
 #include "../transcription/WhisperEngine.h" // Phase II
+#include "../transcription/WhisperModelWarmup.h"
 #include "../transcription/VoxSequence.h"
 #include "../transcription/AudioExtractor.h" // Phase II
 #include "VoxScriptDocumentStore.h"
 #include "../engine/AudioCache.h" // Mission 2
 #include "../engine/TranscriptionJobQueue.h" // Mission 3
+#include "../engine/MelSpectrogramService.h"
 
 namespace VoxScript
 {
@@ -41,7 +45,8 @@ namespace VoxScript
  * From PDF Section 3.1.1: "It receives notifications from the host when audio 
  * clips are added, removed, or modified in the DAW timeline."
  */
-class VoxScriptDocumentController : public juce::ARADocumentControllerSpecialisation
+class VoxScriptDocumentController : public juce::ARADocumentControllerSpecialisation,
+                                    private juce::ARAEditorView::Listener
 {
 public:
     //==========================================================================
@@ -103,6 +108,25 @@ public:
      * This is called by JUCE/ARA when the plugin is bound to ARA
      */
     juce::ARAPlaybackRenderer* doCreatePlaybackRenderer() noexcept override;
+
+    /**
+     * Factory method: create the editor view
+     * We listen to its selection and hidden tracks to prioritise transcription
+     */
+    juce::ARAEditorView* doCreateEditorView() noexcept override;
+
+    /**
+     * Called when the host starts a batch of edits
+     * Transcription requests are collected until the batch ends
+     */
+    void willBeginEditing (juce::ARADocument* document) override;
+
+    /**
+     * Called when the host has finished a batch of edits
+     * Schedules the transcriptions requested during the batch, once per source,
+     * and refreshes where each source is used (playback regions may have moved)
+     */
+    void didEndEditing (juce::ARADocument* document) override;
     
     //==========================================================================
     // State persistence (for saving/loading projects)
@@ -165,13 +189,112 @@ public:
 
     /** Accessor for the Audio Cache (Mission 2) */
     AudioCache& getAudioCache() { return audioCache; }
+
+    /** Accessor for the per-source log-mel spectrograms (Detail View, VAD) */
+    MelSpectrogramService& getSpectrogramService() { return spectrogramService; }
+
+    /** Source whose transcription finished last, 0 if none yet (deferred updates don't name one). */
+    AudioSourceID getLastCompletedSourceID() const { return lastCompletedSourceID.load(); }
     
     /**
-     * @brief Enqueue a transcription job for the given source.
-     * Thread-safe. Called by VoxScriptAudioSource or internally.
+     * @brief Request transcription of the given source.
+     * Called by VoxScriptAudioSource or internally, on the Message Thread.
+     * Inside a host edit cycle the request is only noted; the audio is cached,
+     * extracted and queued once per source when the cycle ends. A source that
+     * already has a job waiting is not extracted again.
      */
     void enqueueTranscriptionForSource(juce::ARAAudioSource* source);
 
+    /**
+     * @brief Select the whisper model for this document (see WhisperModelCatalogue).
+     * Stored in the document, so it is saved with the project. Applies to jobs
+     * enqueued afterwards; the worker switches models without a restart.
+     */
+    void setTranscriptionModel(const juce::String& modelId);
+
+    /** The model id used for new jobs (resolved against installed models). */
+    juce::String getTranscriptionModel() const;
+
+    /**
+     * @brief Set the spoken language of a source (whisper code, e.g. "de").
+     * Stored in the document, replacing the detected one, and the source is
+     * transcribed again in it. A worker that still holds the source's audio
+     * only re-runs the decoder (see WhisperEngine::redecode()). Empty
+     * forgets the language, so the next job detects it again.
+     */
+    void setSourceLanguage(juce::ARAAudioSource* source, const juce::String& languageCode);
+
+    /**
+     * @brief Preload and prime the transcription model on a background thread.
+     * Called automatically when transcription starts up if VOXSCRIPT_PRELOAD_MODEL=1.
+     * The warm-up is cancelled if the controller is destroyed first.
+     */
+    void warmUpTranscriptionModel();
+
+    /**
+     * @brief Release the transcription model after this much idle time (default 2 min).
+     * It is reloaded on demand by the next job.
+     */
+    void setModelIdleTimeout(juce::RelativeTime timeout) { jobQueue.setModelIdleTimeout(timeout); }
+
+    /**
+     * @brief Transcribe in separate VoxScriptWorker processes (0 = in-process, default).
+     * Keeps whisper's memory out of the host and survives worker crashes; can
+     * also be set with VOXSCRIPT_WORKER_PROCESSES.
+     */
+    void setTranscriptionWorkerProcesses(int numProcesses) { jobQueue.setWorkerProcesses(numProcesses); }
+
+    /**
+     * @brief Report the playback position, so regions near it are transcribed first.
+     * Called by VoxScriptPlaybackRenderer on the audio thread; wait-free.
+     */
+    void setPlayheadPosition(double seconds) noexcept { jobQueue.setPlayheadPosition(seconds); }
+
+    /**
+     * @brief Throttling of transcription while the host plays or bounces (see RealtimeLoadGovernor).
+     * VoxScriptPlaybackRenderer reports its block timing and render mode here.
+     */
+    RealtimeLoadGovernor& getLoadGovernor() noexcept { return jobQueue.getLoadGovernor(); }
+
+    /** True while the host renders offline; transcription is paused meanwhile. */
+    bool isHostRenderingOffline() const noexcept { return jobQueue.getLoadGovernor().isRenderingOffline(); }
+
+    /**
+     * @brief How much transcription may run during playback: aggressive,
+     * balanced (default) or background-only. Set from the editor's header;
+     * stored in the document, so it is saved with the project.
+     * VOXSCRIPT_LOAD_POLICY sets it for documents that have none.
+     */
+    void setTranscriptionLoadPolicy(RealtimeLoadGovernor::Policy policy);
+    RealtimeLoadGovernor::Policy getTranscriptionLoadPolicy() const noexcept { return jobQueue.getLoadGovernor().getPolicy(); }
+
+    /**
+     * @brief Per-stage latency of finished transcription jobs (see TranscriptionMetrics).
+     * A summary is logged when the document closes.
+     */
+    TranscriptionMetrics& getTranscriptionMetrics() noexcept { return jobQueue.getMetrics(); }
+
+    /**
+     * @brief Write a Chrome/Perfetto trace of every job to this file (empty = stop).
+     * Can also be set with VOXSCRIPT_TRACE_FILE.
+     */
+    void setTranscriptionTraceFile(const juce::File& file) { jobQueue.getMetrics().setTraceFile(file); }
+
+    /**
+     * @brief Process-wide memory budget for cached audio and models (0 = unlimited).
+     * Shared by all VoxScript instances; can also be set with VOXSCRIPT_MEMORY_BUDGET_MB.
+     */
+    void setMemoryBudgetMB(int megabytes) { memoryBudget->setBudgetBytes((juce::int64) megabytes * 1024 * 1024); }
+
+    /**
+     * @brief Enable progressive transcription (default on).
+     * When a faster Draft-tier model is installed, new sources are first
+     * transcribed with it and published immediately; a background pass with
+     * the selected model then refines the result in place.
+     */
+    void setTwoPassTranscriptionEnabled(bool shouldBeEnabled) { twoPassEnabled.store(shouldBeEnabled); }
+    bool isTwoPassTranscriptionEnabled() const noexcept { return twoPassEnabled.load(); }
+
     //==========================================================================
     // Mission 4: Crash Prevention
     /** 
@@ -183,6 +306,43 @@ public:
     private:
     void ensureTranscriptionInfraInitialised();
 
+    //==========================================================================
+    // ARAEditorView::Listener (host selection and hidden tracks -> job priorities)
+    void onNewSelection (const juce::ARAViewSelection& viewSelection) override;
+    void onHideRegionSequences (const std::vector<juce::ARARegionSequence*>& regionSequences) override;
+
+    /** Tell the job queue where a source's playback regions are. */
+    void updateSourcePlacement(juce::ARAAudioSource* source);
+
+    /**
+     * The expensive part of enqueueTranscriptionForSource(): cache, extract, queue.
+     * languageChanged: only the language differs from the last transcription,
+     * so a waiting job is replaced and the audio may be re-decoded.
+     */
+    void scheduleTranscription(juce::ARAAudioSource* source, bool languageChanged = false);
+
+    /**
+     * Source ranges the playback regions play, padded by regionPaddingSeconds.
+     * Empty (the whole source) if they cover most of it or there are no regions.
+     */
+    static SourceRanges::RangeList getUsedSourceRanges(juce::ARAAudioSource* source);
+
+    static constexpr double regionPaddingSeconds = 1.0;     // Context for words cut by a region edge
+    static constexpr double regionMergeGapSeconds = 5.0;    // Closer ranges are transcribed as one
+    static constexpr double wholeSourceCoverage = 0.75;     // Above this share, transcribe everything
+
+    /** Build a job for an extracted source, choosing single or draft+refine passes. */
+    TranscriptionJob makeTranscriptionJob(AudioSourceID id, const juce::File& audioFile) const;
+
+    /** Source length in seconds (0 if unknown); lets the queue batch short takes. */
+    static double getSourceDurationSeconds(const juce::ARAAudioSource* source);
+
+    /** The host's persistent ID of a source; identifies it in the TranscriptionJournal across sessions. */
+    static juce::String getJournalID(const juce::ARAAudioSource* source);
+
+    /** Re-request sources whose transcription the last session left unfinished. */
+    void resumeJournaledWork();
+
     //==========================================================================
     juce::ListenerList<Listener> listeners;
     
@@ -191,6 +351,9 @@ public:
 
     // Mission 2: Audio Cache
     AudioCache audioCache;
+
+    // Shared log-mel spectrograms (display, VAD, language probe); outlives jobQueue
+    MelSpectrogramService spectrogramService;
     
     // Mission 3: Transcription Job Queue
     TranscriptionJobQueue jobQueue;
@@ -200,6 +363,25 @@ public:
     // Mission 4: Readiness Flag
     std::atomic<bool> araReadyForBackgroundWork { false };
     std::atomic<bool> storeDirty { false };
+    std::atomic<AudioSourceID> lastCompletedSourceID { 0 };
+
+    // Source ranges scheduled per source so far (Message Thread; empty = whole source)
+    std::map<AudioSourceID, SourceRanges::RangeList> scheduledSourceRanges;
+
+    // Requests collected during a host edit cycle, in order (Message Thread)
+    bool hostIsEditing = false;
+    std::vector<juce::ARAAudioSource*> deferredTranscriptionSources;
+
+    // Selection and hidden tracks in the host (Message Thread)
+    TranscriptionFocus transcriptionFocus;
+
+    // Progressive (draft + refine) transcription
+    std::atomic<bool> twoPassEnabled { true };
+
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
+
+    // Optional model preload (opt-in)
+    std::unique_ptr<WhisperModelWarmup> modelWarmup;
 
     // Phase II/III: Transcription and Audio Extraction
     WhisperEngine whisperEngine;
@@ -27,38 +27,23 @@ AudioSourceID VoxScriptDocumentStore::getOrCreateAudioSourceID(const ARA::PlugIn
         return runtimeIt->second;
     }
 
-    // 2. If not, try to look up by persistent ID (restoration scenario)
-    // ARA gives us a persistent ID (usually a string or hash from the host)
-    // We assume getPersistentID() returns a string-convertible pointer or similar.
-    // In strict ARA, it's a void*, but JUCE Wrappers often provide a String adaptation.
-    // If not using JUCE's expanded ARA classes, we have to rely on the raw ARA API.
-    // NOTE: For this implementation, we will try to use the host's provided ID if valid,
-    // otherwise fallback to a generated ID. Since we are in JUCE/ARA context, let's assume
-    // we can get a meaningful string ID or we use the pointer address as a temporary key if needed,
-    // but relying on pointer address for persistence is wrong.
-    //
-    // However, since we are implementing the *Store* logic, we will generate our own internal ID
-    // and map the HOST's persistent ID to it.
-    
-    juce::String persistentID;
-    
-    // Attempt to get a stable ID from the host.
-    // Note: In pure ARA, we might need the ObjectRef. For now, we will assume
-    // the caller might have restored this. But for a fresh session:
-    // FIXME: Proper persistent ID retrieval from ARA host to be implemented.
-    // if (auto* entry = audioSource->getDocument()->getAudioSourcePersistencyIndexEntry(audioSource))
-    // {
-    //      // ...
-    // }
-    
-    // Simple implementation: Generate a new ID if we don't have one mapped via bindRestoredAudioSource.
-    // If bindRestoredAudioSource was called, it would have populated persistentIdMap.
-    
-    // We need a key to check persistentIdMap. Ideally, the Host provides this key.
-    // If we can't get a key from the host, we generate a new one.
-    
+    // 2. If not, look it up by the host's persistent ID (restoration scenario),
+    // so a restored project finds its archived transcriptions and languages
+    const juce::String persistentID (audioSource->getPersistentID());
+
+    auto persistentIt = persistentIdMap.find(persistentID);
+    if (persistentID.isNotEmpty() && persistentIt != persistentIdMap.end())
+    {
+        runtimeParamsMap[audioSource] = persistentIt->second;
+        return persistentIt->second;
+    }
+
+    // 3. A new source
     AudioSourceID newID = nextAudioSourceID++;
     runtimeParamsMap[audioSource] = newID;
+
+    if (persistentID.isNotEmpty())
+        persistentIdMap[persistentID] = newID;
     
     return newID;
 }
@@ -82,6 +67,11 @@ void VoxScriptDocumentStore::removeAudioSourceByID(AudioSourceID id)
     
     // Remove data
     transcriptions.erase(id);
+    draftSources.erase(id);
+    sourceLanguages.erase(id);
+    generations.erase(id);
+    streamedSources.erase(id);
+    ++revision;
     
     // Remove mapping (Linear scan of map - acceptable for teardown)
     for (auto it = runtimeParamsMap.begin(); it != runtimeParamsMap.end(); )
@@ -91,6 +81,14 @@ void VoxScriptDocumentStore::removeAudioSourceByID(AudioSourceID id)
         else
             ++it;
     }
+
+    for (auto it = persistentIdMap.begin(); it != persistentIdMap.end(); )
+    {
+        if (it->second == id)
+            it = persistentIdMap.erase(it);
+        else
+            ++it;
+    }
 }
 
 void VoxScriptDocumentStore::removeAudioSource(const ARA::PlugIn::AudioSource* audioSource)
@@ -105,10 +103,194 @@ void VoxScriptDocumentStore::removeAudioSource(const ARA::PlugIn::AudioSource* a
     }
 }
 
-void VoxScriptDocumentStore::updateTranscription(AudioSourceID sourceID, const VoxSequence& sequence)
+void VoxScriptDocumentStore::updateTranscription(AudioSourceID sourceID, const VoxSequence& sequence, bool isDraft)
 {
     std::lock_guard<std::mutex> lock(storeMutex);
     transcriptions[sourceID] = sequence;
+    markReplacedLocked(sourceID);
+    ++revision;
+
+    if (isDraft)
+        draftSources.insert(sourceID);
+    else
+        draftSources.erase(sourceID);
+}
+
+namespace
+{
+    bool segmentsMatch(const VoxSegment& a, const VoxSegment& b)
+    {
+        // 10 ms tolerance: whisper timestamps are quantised to 10 ms
+        constexpr double timeTolerance = 0.01;
+
+        return std::abs(a.startTime - b.startTime) < timeTolerance
+            && std::abs(a.endTime - b.endTime) < timeTolerance
+            && a.text.trim() == b.text.trim();
+    }
+}
+
+void VoxScriptDocumentStore::mergeTranscription(AudioSourceID sourceID, const VoxSequence& partial,
+                                                const SourceRanges::RangeList& ranges, bool isDraft)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto& sequence = transcriptions[sourceID];
+    sequence = SourceRanges::splice(sequence, partial, ranges);
+    markReplacedLocked(sourceID);
+    ++revision;
+
+    if (isDraft)
+        draftSources.insert(sourceID);
+    else
+        draftSources.erase(sourceID);
+}
+
+int VoxScriptDocumentStore::applyRefinedTranscription(AudioSourceID sourceID, const VoxSequence& refinedPart,
+                                                      const SourceRanges::RangeList& ranges)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    draftSources.erase(sourceID);
+
+    auto it = transcriptions.find(sourceID);
+    if (it == transcriptions.end())
+    {
+        transcriptions[sourceID] = refinedPart;
+        markReplacedLocked(sourceID);
+        ++revision;
+        return refinedPart.getSegments().size();
+    }
+
+    // A region-scoped refinement leaves the rest of the source as it is
+    const auto refined = ranges.isEmpty() ? refinedPart : SourceRanges::splice(it->second, refinedPart, ranges);
+
+    const auto& draft = it->second;
+
+    // Build the merged sequence: keep draft segments the refinement agrees with
+    VoxSequence merged;
+    int numChanged = 0;
+    int draftIndex = 0;
+
+    for (const auto& refinedSegment : refined.getSegments())
+    {
+        // Skip draft segments that end before this one starts (they were dropped)
+        while (draftIndex < draft.getNumSegments()
+               && draft.getSegmentEnd(draftIndex) <= refinedSegment.startTime
+               && !segmentsMatch(draft.getSegment(draftIndex), refinedSegment))
+            ++draftIndex;
+
+        if (draftIndex < draft.getNumSegments() && segmentsMatch(draft.getSegment(draftIndex), refinedSegment))
+        {
+            merged.addSegment(draft.getSegment(draftIndex));
+            ++draftIndex;
+        }
+        else
+        {
+            merged.addSegment(refinedSegment);
+            ++numChanged;
+        }
+    }
+
+    // Draft segments with no counterpart also count as changes
+    if (merged.getNumSegments() != draft.getNumSegments())
+        numChanged = juce::jmax(numChanged, 1);
+
+    if (numChanged > 0)
+    {
+        it->second = std::move(merged);
+        markReplacedLocked(sourceID);
+        ++revision;
+    }
+
+    return numChanged;
+}
+
+bool VoxScriptDocumentStore::isDraftTranscription(AudioSourceID sourceID) const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return draftSources.count(sourceID) > 0;
+}
+
+uint64_t VoxScriptDocumentStore::beginStreamedTranscription(AudioSourceID sourceID)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    // Never stream over a published result; it stays until the new one replaces it
+    if (transcriptions.count(sourceID) > 0 && streamedSources.count(sourceID) == 0)
+        return 0;
+
+    transcriptions[sourceID].clear();
+    markReplacedLocked(sourceID);
+    streamedSources[sourceID] = generations[sourceID];
+    ++revision;
+
+    return streamedSources[sourceID];
+}
+
+void VoxScriptDocumentStore::appendStreamedSegment(AudioSourceID sourceID, uint64_t streamID, const VoxSegment& segment)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    auto it = streamedSources.find(sourceID);
+    if (it == streamedSources.end() || it->second != streamID)
+        return;
+
+    // Same generation: readers only fetch the new segment
+    transcriptions[sourceID].addSegment(segment);
+    ++revision;
+}
+
+void VoxScriptDocumentStore::discardStreamedTranscription(AudioSourceID sourceID)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    if (streamedSources.erase(sourceID) == 0)
+        return;
+
+    transcriptions.erase(sourceID);
+    generations.erase(sourceID);
+    ++revision;
+}
+
+bool VoxScriptDocumentStore::getTranscriptDelta(AudioSourceID sourceID, uint64_t knownGeneration, int knownSegments,
+                                                TranscriptDelta& delta) const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    auto it = transcriptions.find(sourceID);
+    if (it == transcriptions.end())
+        return false;
+
+    auto generation = generations.find(sourceID);
+    delta.generation = generation != generations.end() ? generation->second : 0;
+
+    const auto& sequence = it->second;
+    const bool isAppend = knownGeneration != 0 && knownGeneration == delta.generation
+                          && knownSegments <= sequence.getNumSegments();
+
+    delta.firstIndex = isAppend ? knownSegments : 0;
+    delta.segments.clearQuick();
+
+    for (int i = delta.firstIndex; i < sequence.getNumSegments(); ++i)
+        delta.segments.add(sequence.getSegment(i));
+
+    return true;
+}
+
+std::vector<AudioSourceID> VoxScriptDocumentStore::getTranscribedSourceIDs() const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    std::vector<AudioSourceID> ids;
+
+    for (const auto& pair : transcriptions)
+        ids.push_back(pair.first);
+
+    return ids;
+}
+
+void VoxScriptDocumentStore::markReplacedLocked(AudioSourceID sourceID)
+{
+    generations[sourceID] = ++lastGeneration;
+    streamedSources.erase(sourceID);
 }
 
 DocumentSnapshot VoxScriptDocumentStore::makeSnapshot() const
@@ -119,6 +301,47 @@ DocumentSnapshot VoxScriptDocumentStore::makeSnapshot() const
     return snapshot;
 }
 
+juce::String VoxScriptDocumentStore::getPreferredModelID() const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return preferredModelID;
+}
+
+void VoxScriptDocumentStore::setPreferredModelID(const juce::String& modelID)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    preferredModelID = modelID;
+}
+
+juce::String VoxScriptDocumentStore::getLoadPolicyName() const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return loadPolicyName;
+}
+
+void VoxScriptDocumentStore::setLoadPolicyName(const juce::String& policyName)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    loadPolicyName = policyName;
+}
+
+juce::String VoxScriptDocumentStore::getSourceLanguage(AudioSourceID sourceID) const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto it = sourceLanguages.find(sourceID);
+    return it != sourceLanguages.end() ? it->second : juce::String();
+}
+
+void VoxScriptDocumentStore::setSourceLanguage(AudioSourceID sourceID, const juce::String& language)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    if (language.isEmpty())
+        sourceLanguages.erase(sourceID);
+    else
+        sourceLanguages[sourceID] = language;
+}
+
 juce::MemoryBlock VoxScriptDocumentStore::serialize() const
 {
     std::lock_guard<std::mutex> lock(storeMutex);
@@ -126,10 +349,16 @@ juce::MemoryBlock VoxScriptDocumentStore::serialize() const
     juce::ValueTree root("VOXSCRIPT_DOC");
     root.setProperty("version", 1, nullptr);
     root.setProperty("nextID", (juce::int64)nextAudioSourceID, nullptr);
+    root.setProperty("modelID", preferredModelID, nullptr);
+    root.setProperty("loadPolicy", loadPolicyName, nullptr);
     
     juce::ValueTree sources("SOURCES");
     for (const auto& pair : transcriptions)
     {
+        // An unfinished stream is redone on the next load
+        if (streamedSources.count(pair.first) > 0)
+            continue;
+
         juce::ValueTree sourceNode("SOURCE");
         sourceNode.setProperty("id", (juce::int64)pair.first, nullptr);
         
@@ -138,6 +367,16 @@ juce::MemoryBlock VoxScriptDocumentStore::serialize() const
         sources.addChild(sourceNode, -1, nullptr);
     }
     root.addChild(sources, -1, nullptr);
+
+    juce::ValueTree languages("LANGUAGES");
+    for (const auto& pair : sourceLanguages)
+    {
+        juce::ValueTree langNode("LANG");
+        langNode.setProperty("id", (juce::int64)pair.first, nullptr);
+        langNode.setProperty("code", pair.second, nullptr);
+        languages.addChild(langNode, -1, nullptr);
+    }
+    root.addChild(languages, -1, nullptr);
     
     // We also need to save the persistent ID map so we can rebind on load
     juce::ValueTree mappings("MAPPINGS");
@@ -166,9 +405,14 @@ bool VoxScriptDocumentStore::deserialize(const void* data, size_t size)
         return false;
         
     nextAudioSourceID = (AudioSourceID)(int64)root.getProperty("nextID", 1);
+    preferredModelID = root.getProperty("modelID", juce::String()).toString();
+    loadPolicyName = root.getProperty("loadPolicy", juce::String()).toString();
     
     // Clear current state
     transcriptions.clear();
+    draftSources.clear();
+    sourceLanguages.clear();
+    streamedSources.clear();
     persistentIdMap.clear();
     runtimeParamsMap.clear();
     
@@ -183,9 +427,20 @@ bool VoxScriptDocumentStore::deserialize(const void* data, size_t size)
         if (seq.fromValueTree(sourceNode.getChildWithName("SEQUENCE")))
         {
             transcriptions[id] = seq;
+            markReplacedLocked(id);
         }
     }
     
+    // Load detected languages (absent in older archives)
+    auto languages = root.getChildWithName("LANGUAGES");
+    for (int i = 0; i < languages.getNumChildren(); ++i)
+    {
+        auto langNode = languages.getChild(i);
+        juce::String code = langNode.getProperty("code");
+        if (code.isNotEmpty())
+            sourceLanguages[(AudioSourceID)(int64)langNode.getProperty("id")] = code;
+    }
+    
     // Load Mappings
     auto mappings = root.getChildWithName("MAPPINGS");
     for (int i = 0; i < mappings.getNumChildren(); ++i)
@@ -195,6 +450,8 @@ bool VoxScriptDocumentStore::deserialize(const void* data, size_t size)
         AudioSourceID id = (AudioSourceID)(int64)mapNode.getProperty("internalID");
         persistentIdMap[pid] = id;
     }
+
+    ++revision;
     
     return true;
 }
@@ -205,16 +462,11 @@ void VoxScriptDocumentStore::bindRestoredAudioSource(const ARA::PlugIn::AudioSou
     
     if (audioSource == nullptr) return;
     
-    // In a real implementation, we would get the host's persistent ID string here.
-    // For now, let's assume we can map the Order Index or similar if available.
-    // THIS IS A STUB for the binding logic logic since getting the exact PersistentID string
-    // depends on the deep ARA integration helper.
-    
-    // WORKAROUND: If we serialized based on order, we might recover.
-    // Ideally: 
-    // juce::String hostID = getHostProvidedID(audioSource);
-    // if (persistentIdMap.count(hostID))
-    //    runtimeParamsMap[audioSource] = persistentIdMap[hostID];
+    // The archive keys everything by the AudioSourceID it had when saved;
+    // the host's persistent ID leads back to it
+    auto it = persistentIdMap.find(juce::String(audioSource->getPersistentID()));
+    if (it != persistentIdMap.end())
+        runtimeParamsMap[audioSource] = it->second;
 }
 
 } // namespace VoxScript
@@ -14,8 +14,12 @@
 #include <ARA_Library/PlugIn/ARAPlug.h>
 #include <optional>
 #include <mutex>
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "../transcription/VoxSequence.h"
+#include "../transcription/SourceRanges.h"
 
 namespace VoxScript
 {
@@ -40,6 +44,18 @@ struct DocumentSnapshot
     }
 };
 
+/**
+ * Segments a reader is missing, from getTranscriptDelta().
+ * If firstIndex is 0 the reader replaces what it has; otherwise the
+ * segments follow the knownSegments it already has.
+ */
+struct TranscriptDelta
+{
+    uint64_t generation = 0;
+    int firstIndex = 0;
+    juce::Array<VoxSegment> segments;
+};
+
 class VoxScriptDocumentStore
 {
 public:
@@ -51,7 +67,8 @@ public:
     
     /**
      * Get or create a stable ID for an ARA Audio Source.
-     * Uses the host-provided persistent ID if available, otherwise generates one.
+     * A source whose host persistent ID is known (restored from the archive,
+     * or seen earlier) gets the ID it had; otherwise a new one is generated.
      */
     AudioSourceID getOrCreateAudioSourceID(const ARA::PlugIn::AudioSource* audioSource);
 
@@ -75,14 +92,101 @@ public:
     
     /**
      * Update the transcription for a specific audio source.
+     * @param isDraft true if this is a fast first pass that a refinement will follow
+     */
+    void updateTranscription(AudioSourceID sourceID, const VoxSequence& sequence, bool isDraft = false);
+
+    /**
+     * Replace the transcription inside some source ranges only (region-scoped jobs).
+     * Segments outside the ranges are kept; see SourceRanges::splice().
+     * @param isDraft true if this is a fast first pass that a refinement will follow
+     */
+    void mergeTranscription(AudioSourceID sourceID, const VoxSequence& partial,
+                            const SourceRanges::RangeList& ranges, bool isDraft = false);
+
+    /**
+     * Merge a refined transcription over the current (draft) one in one step.
+     * Segments whose text and timing are unchanged keep the existing data;
+     * only differing segments are replaced. Clears the draft flag.
+     * @param ranges If not empty, refined only covers these source ranges
+     * @return Number of segments that changed (0 means the store was left untouched)
+     */
+    int applyRefinedTranscription(AudioSourceID sourceID, const VoxSequence& refined,
+                                  const SourceRanges::RangeList& ranges = {});
+
+    /** True while the source only has a draft transcription. */
+    bool isDraftTranscription(AudioSourceID sourceID) const;
+
+    /**
+     * Monotonic counter bumped on every transcription change.
+     * Lets pollers (ScriptView) detect in-place refinements cheaply.
      */
-    void updateTranscription(AudioSourceID sourceID, const VoxSequence& sequence);
+    uint64_t getRevision() const noexcept { return revision.load(); }
     
+    //==============================================================================
+    // Streaming (Thread-safe; called from transcription workers)
+
+    /**
+     * Start streaming the first transcription of a source segment by segment.
+     * Clears what an earlier, unfinished stream left behind.
+     * @return Stream id for appendStreamedSegment(), or 0 if the source
+     *         already has a published transcription (nothing is streamed over it)
+     */
+    uint64_t beginStreamedTranscription(AudioSourceID sourceID);
+
+    /**
+     * Append a finished segment to a streamed transcription. Ignored once
+     * the stream is superseded, e.g. by the final result of the job
+     * (updateTranscription() and friends end the stream).
+     */
+    void appendStreamedSegment(AudioSourceID sourceID, uint64_t streamID, const VoxSegment& segment);
+
+    /** Drop a stream that won't be followed by a result (job failed). No-op once published. */
+    void discardStreamedTranscription(AudioSourceID sourceID);
+
+    /**
+     * Segments of a source a reader doesn't have yet.
+     * Transcripts only grow while streaming; every other change starts a new
+     * generation, which the reader gets as a whole (delta.firstIndex == 0).
+     * @param knownGeneration generation of the reader's copy (0 if none)
+     * @param knownSegments   number of segments in the reader's copy
+     * @return False if the source has no transcription
+     */
+    bool getTranscriptDelta(AudioSourceID sourceID, uint64_t knownGeneration, int knownSegments,
+                            TranscriptDelta& delta) const;
+
+    /** Sources with a transcription (published or streaming), in no particular order. */
+    std::vector<AudioSourceID> getTranscribedSourceIDs() const;
+
     /**
      * Create a snapshot of the current state for the UI.
      * This is thread-safe and lock-free for the reader (after creation).
      */
     DocumentSnapshot makeSnapshot() const;
+
+    //==============================================================================
+    // Document Preferences (Thread-safe, persisted in the ARA archive)
+
+    /**
+     * Model id (see WhisperModelCatalogue) used for new transcriptions of this document.
+     * Empty means the catalogue default.
+     */
+    juce::String getPreferredModelID() const;
+    void setPreferredModelID(const juce::String& modelID);
+
+    /**
+     * Transcription load policy during playback (a RealtimeLoadGovernor::toString() name).
+     * Empty means VOXSCRIPT_LOAD_POLICY or the governor's default.
+     */
+    juce::String getLoadPolicyName() const;
+    void setLoadPolicyName(const juce::String& policyName);
+
+    /**
+     * Spoken language of a source (whisper code, e.g. "de"), detected once on
+     * its first speech window and reused by later jobs. Empty if unknown.
+     */
+    juce::String getSourceLanguage(AudioSourceID sourceID) const;
+    void setSourceLanguage(AudioSourceID sourceID, const juce::String& language);
     
     //==============================================================================
     // Persistence
@@ -109,6 +213,9 @@ private:
     
     // The core data: AudioSourceID -> VoxSequence
     std::unordered_map<AudioSourceID, VoxSequence> transcriptions;
+
+    // Sources whose transcription is a draft awaiting refinement (not persisted)
+    std::unordered_set<AudioSourceID> draftSources;
     
     // Runtime mapping: ARA Pointer -> AudioSourceID
     // This is valid only for the current session lifetime
@@ -118,8 +225,27 @@ private:
     // This is what strictly persists across sessions
     std::unordered_map<juce::String, AudioSourceID> persistentIdMap;
     
+    std::atomic<uint64_t> revision { 0 };
+
+    // Bumped whenever a transcription is replaced rather than appended to
+    std::unordered_map<AudioSourceID, uint64_t> generations;
+    uint64_t lastGeneration = 0;
+
+    // Sources whose transcription is still streamed, with the stream's generation (not persisted)
+    std::unordered_map<AudioSourceID, uint64_t> streamedSources;
+
+    /** A transcription was replaced: new generation, any stream ends. Caller holds storeMutex. */
+    void markReplacedLocked(AudioSourceID sourceID);
+
     // ID Generator
     AudioSourceID nextAudioSourceID = 1;
+
+    // Per-document model selection and load policy
+    juce::String preferredModelID;
+    juce::String loadPolicyName;
+
+    // Detected language per source
+    std::unordered_map<AudioSourceID, juce::String> sourceLanguages;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoxScriptDocumentStore)
 };
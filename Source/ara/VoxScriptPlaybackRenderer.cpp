@@ -18,6 +18,7 @@ namespace VoxScript
 
 VoxScriptPlaybackRenderer::~VoxScriptPlaybackRenderer()
 {
+    setOfflineRender (false);
     juce::Logger::writeToLog ("VoxScriptPlaybackRenderer: Destroyed");
 }
 
@@ -39,7 +40,11 @@ void VoxScriptPlaybackRenderer::prepareToPlay (double sampleRate,
     maxBlockSize = maximumSamplesPerBlock;
     channelCount = numChannels;
     
-    juce::ignoreUnused (precision, alwaysNonRealtime);
+    juce::ignoreUnused (precision);
+    blockTimer.prepare (sampleRate, maximumSamplesPerBlock);
+
+    // A bounce: transcription pauses until this renderer is released
+    setOfflineRender (alwaysNonRealtime == AlwaysNonRealtime::yes);
     
     // Pre-allocate buffer for RT processing (max block size + some safety margin if desired, but exact is fine)
     tempBuffer.setSize (numChannels, maximumSamplesPerBlock);
@@ -50,16 +55,56 @@ void VoxScriptPlaybackRenderer::prepareToPlay (double sampleRate,
 void VoxScriptPlaybackRenderer::releaseResources()
 {
     juce::Logger::writeToLog ("VoxScriptPlaybackRenderer: Release resources");
+
+    setOfflineRender (false);
     
     // Phase III: Clean up processing state
 }
 
+void VoxScriptPlaybackRenderer::setOfflineRender (bool shouldBeOffline)
+{
+    if (preparedForOfflineRender == shouldBeOffline)
+        return;
+
+    auto* controller = juce::ARADocumentControllerSpecialisation::getSpecialisedDocumentController<VoxScriptDocumentController> (getDocumentController());
+    if (controller == nullptr)
+        return;
+
+    if (shouldBeOffline)
+        controller->getLoadGovernor().beginOfflineRender();
+    else
+        controller->getLoadGovernor().endOfflineRender();
+
+    preparedForOfflineRender = shouldBeOffline;
+}
+
 //==============================================================================
 // Main Audio Processing
 
 bool VoxScriptPlaybackRenderer::processBlock (juce::AudioBuffer<float>& buffer,
                                              juce::AudioProcessor::Realtime realtime,
                                              const juce::AudioPlayHead::PositionInfo& positionInfo) noexcept
+{
+    blockTimer.blockStarted();
+
+    auto* controller = juce::ARADocumentControllerSpecialisation::getSpecialisedDocumentController<VoxScriptDocumentController> (getDocumentController());
+
+    // Regions near the playhead are transcribed first
+    if (controller != nullptr)
+        controller->setPlayheadPosition (positionInfo.getTimeInSeconds().orFallback (-1.0));
+
+    renderRegions (buffer, positionInfo);
+
+    // Background transcription backs off when playback runs short of time
+    if (controller != nullptr)
+        blockTimer.blockFinished (controller->getLoadGovernor(), buffer.getNumSamples(), positionInfo.getIsPlaying(),
+                                  realtime == juce::AudioProcessor::Realtime::yes);
+
+    return true;
+}
+
+void VoxScriptPlaybackRenderer::renderRegions (juce::AudioBuffer<float>& buffer,
+                                               const juce::AudioPlayHead::PositionInfo& positionInfo) noexcept
 {
     // Clear buffer first
     buffer.clear();
@@ -68,11 +113,11 @@ bool VoxScriptPlaybackRenderer::processBlock (juce::AudioBuffer<float>& buffer,
     const auto& regions = getPlaybackRegions();
     
     if (regions.empty())
-        return true;
+        return;
     
     // Get current playback sample position from position info
     if (!positionInfo.getTimeInSamples().hasValue())
-        return true;
+        return;
     
     auto playbackSamplePosition = *positionInfo.getTimeInSamples();
     
@@ -145,8 +190,6 @@ bool VoxScriptPlaybackRenderer::processBlock (juce::AudioBuffer<float>& buffer,
             // But strict NO ALLOC in render path.
         }
     }
-    
-    return true;
 }
 
 //==============================================================================
@@ -10,6 +10,7 @@
 #pragma once
                         
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../engine/RealtimeLoadGovernor.h"
 
 namespace VoxScript
 {
@@ -82,6 +83,16 @@ private:
     // Pre-allocated buffer for RT processing
     juce::AudioBuffer<float> tempBuffer;
 
+    // Block timing for the transcription load governor
+    RealtimeLoadGovernor::BlockTimer blockTimer;
+    bool preparedForOfflineRender = false; // Counted by the governor as a running offline render
+
+    /** Tell the load governor whether this renderer is prepared for offline rendering only. */
+    void setOfflineRender (bool shouldBeOffline);
+
+    /** processBlock() without the timing: mix the playback regions into buffer. */
+    void renderRegions (juce::AudioBuffer<float>& buffer, const juce::AudioPlayHead::PositionInfo& positionInfo) noexcept;
+
     /**
      * Helper to calculate the correct sample offset within the Audio Source
      * for a given playback position relative to a region.
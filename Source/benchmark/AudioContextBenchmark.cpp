@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+    AudioContextBenchmark.cpp
+
+    "audioctx": how much the adaptive encoder context (audio_ctx sized to
+    the clip, see WhisperEngine::chooseAudioContext) saves per clip length.
+    Each length is transcribed with the option on and off; the "on" time
+    includes any full-context re-run the engine decides on.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/WhisperEngine.h"
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+void runAudioContext (const juce::ArgumentList& args)
+{
+    WhisperEngine engine;
+    engine.setModel (getModelId (args));
+
+    const auto audio = loadTestAudio (args, engine, WhisperEngine::maxBatchSeconds);
+    const int runs = getRuns (args, 3);
+
+    note ("Model: " + getModelId (args) + ", " + juce::String (runs) + " runs per line");
+
+    for (double seconds : { 2.0, 5.0, 10.0, 20.0, 30.0 })
+    {
+        const auto numSamples = (size_t) (seconds * 16000.0);
+        const int context = WhisperEngine::chooseAudioContext (seconds);
+        const auto label = juce::String (seconds, 0) + " s, ";
+
+        engine.setAdaptiveAudioContext (true);
+        measure (label + "audio_ctx " + (context > 0 ? juce::String (context) : juce::String ("full")), runs,
+                 [&] { engine.processSamples (audio.data(), numSamples); });
+
+        engine.setAdaptiveAudioContext (false);
+        measure (label + "full context", runs,
+                 [&] { engine.processSamples (audio.data(), numSamples); });
+    }
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
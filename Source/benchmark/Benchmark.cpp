@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+    Benchmark.cpp
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/WhisperEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <utility>
+
+#if defined (__GLIBC__)
+ #include <malloc.h>
+#endif
+
+//==============================================================================
+// Allocation counting. With glibc the malloc family itself is replaced, so
+// juce::HeapBlock (AudioBuffer, Array) is counted along with operator new,
+// which allocates through malloc. Elsewhere only operator new is replaced,
+// with the size kept in front of each block so delete knows what it frees.
+
+namespace
+{
+    std::atomic<juce::int64> allocationCount { 0 };
+    std::atomic<juce::int64> allocatedBytes { 0 };
+    std::atomic<juce::int64> liveBytes { 0 };
+    std::atomic<juce::int64> peakLiveBytes { 0 };
+    std::atomic<juce::int64> liveBytesAtReset { 0 };
+
+    void countAllocation (size_t requested, size_t held) noexcept
+    {
+        allocationCount.fetch_add (1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add ((juce::int64) requested, std::memory_order_relaxed);
+        const auto live = liveBytes.fetch_add ((juce::int64) held, std::memory_order_relaxed) + (juce::int64) held;
+
+        auto peak = peakLiveBytes.load (std::memory_order_relaxed);
+        while (live > peak && !peakLiveBytes.compare_exchange_weak (peak, live, std::memory_order_relaxed)) {}
+    }
+
+    void countRelease (size_t held) noexcept
+    {
+        liveBytes.fetch_sub ((juce::int64) held, std::memory_order_relaxed);
+    }
+}
+
+#if defined (__GLIBC__)
+
+// glibc's own entry points, which the replacements below forward to
+extern "C" void* __libc_malloc (size_t);
+extern "C" void* __libc_calloc (size_t, size_t);
+extern "C" void* __libc_realloc (void*, size_t);
+extern "C" void* __libc_memalign (size_t, size_t);
+extern "C" void __libc_free (void*);
+
+namespace
+{
+    constexpr bool countsMalloc = true;
+
+    void* counted (void* ptr, size_t requested) noexcept
+    {
+        if (ptr != nullptr)
+            countAllocation (requested, malloc_usable_size (ptr));
+
+        return ptr;
+    }
+}
+
+extern "C"
+{
+    void* malloc (size_t size)                       { return counted (__libc_malloc (size), size); }
+    void* calloc (size_t count, size_t size)         { return counted (__libc_calloc (count, size), count * size); }
+    void* memalign (size_t alignment, size_t size)   { return counted (__libc_memalign (alignment, size), size); }
+    void* aligned_alloc (size_t alignment, size_t size) { return memalign (alignment, size); }
+
+    int posix_memalign (void** result, size_t alignment, size_t size)
+    {
+        if (alignment % sizeof (void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        *result = memalign (alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    void* realloc (void* ptr, size_t size)
+    {
+        const auto held = ptr != nullptr ? malloc_usable_size (ptr) : 0;
+        auto* result = __libc_realloc (ptr, size);
+
+        // Failed: the old block is still there. Freed (size 0): it is gone.
+        if (result == nullptr && size != 0)
+            return nullptr;
+
+        countRelease (held);
+        return counted (result, size);
+    }
+
+    void free (void* ptr)
+    {
+        if (ptr != nullptr)
+            countRelease (malloc_usable_size (ptr));
+
+        __libc_free (ptr);
+    }
+}
+
+#else
+
+namespace
+{
+    constexpr bool countsMalloc = false;
+    constexpr size_t headerSize = alignof (std::max_align_t);
+
+    void* allocate (size_t size) noexcept
+    {
+        auto* block = static_cast<char*> (std::malloc (size + headerSize));
+
+        if (block == nullptr)
+            return nullptr;
+
+        *reinterpret_cast<size_t*> (block) = size;
+        countAllocation (size, size);
+        return block + headerSize;
+    }
+
+    void release (void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        auto* block = static_cast<char*> (ptr) - headerSize;
+        countRelease (*reinterpret_cast<size_t*> (block));
+        std::free (block);
+    }
+}
+
+void* operator new (std::size_t size)
+{
+    if (auto* ptr = allocate (size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept { return allocate (size); }
+void operator delete (void* ptr) noexcept                        { release (ptr); }
+void operator delete (void* ptr, std::size_t) noexcept           { release (ptr); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept { release (ptr); }
+
+#endif
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+void resetAllocationStats()
+{
+    allocationCount = 0;
+    allocatedBytes = 0;
+    liveBytesAtReset = liveBytes.load();
+    peakLiveBytes = liveBytesAtReset.load();
+}
+
+AllocationStats getAllocationStats()
+{
+    return { allocationCount.load(), allocatedBytes.load(), peakLiveBytes.load() - liveBytesAtReset.load() };
+}
+
+//==============================================================================
+namespace
+{
+    juce::String formatBytes (juce::int64 bytes)
+    {
+        if (bytes >= 1024 * 1024)
+            return juce::String ((double) bytes / (1024.0 * 1024.0), 1) + " MB";
+
+        if (bytes >= 1024)
+            return juce::String ((double) bytes / 1024.0, 1) + " KB";
+
+        return juce::String (bytes) + " B";
+    }
+}
+
+void measure (const juce::String& name, int runs, const std::function<void()>& fn)
+{
+    static bool allocatorNoted = false;
+
+    if (!countsMalloc && !std::exchange (allocatorNoted, true))
+        note ("Heap: operator new only; juce::HeapBlock (AudioBuffer, Array storage) isn't counted on this platform");
+
+    fn(); // Warm-up: first-use allocations, model loads, caches
+
+    std::vector<double> timesMs;
+
+    for (int i = 0; i < juce::jmax (1, runs); ++i)
+    {
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        fn();
+        timesMs.push_back (juce::Time::getMillisecondCounterHiRes() - startMs);
+    }
+
+    std::sort (timesMs.begin(), timesMs.end());
+
+    resetAllocationStats();
+    fn();
+    const auto stats = getAllocationStats();
+
+    std::cout << name.paddedRight (' ', 40)
+              << "  min " << juce::String (timesMs.front(), 3) << " ms"
+              << "  median " << juce::String (timesMs[timesMs.size() / 2], 3) << " ms"
+              << "  allocs " << stats.count
+              << " (" << formatBytes (stats.bytes) << ")"
+              << "  peak +" << formatBytes (stats.peakBytes)
+              << std::endl;
+}
+
+void note (const juce::String& text)
+{
+    std::cout << text << std::endl;
+}
+
+bool countsAllMallocs() noexcept
+{
+    return countsMalloc;
+}
+
+//==============================================================================
+int getRuns (const juce::ArgumentList& args, int defaultRuns)
+{
+    const auto value = args.getValueForOption ("--runs");
+    return value.isNotEmpty() ? juce::jmax (1, value.getIntValue()) : defaultRuns;
+}
+
+juce::String getModelId (const juce::ArgumentList& args)
+{
+    const auto value = args.getValueForOption ("--model");
+    return value.isNotEmpty() ? value : juce::String (WhisperModelCatalogue::defaultModelId);
+}
+
+std::vector<float> loadTestAudio (const juce::ArgumentList& args, WhisperEngine& engine, double minSeconds)
+{
+    const auto minSamples = (size_t) std::ceil (minSeconds * 16000.0);
+    std::vector<float> audio;
+
+    if (args.containsOption ("--audio"))
+    {
+        const auto file = args.getExistingFileForOption ("--audio");
+
+        if (!engine.readPcm16k (file, audio) || audio.empty())
+            juce::ConsoleApplication::fail ("Could not read " + file.getFullPathName());
+
+        note ("Audio: " + file.getFileName() + ", " + juce::String ((double) audio.size() / 16000.0, 1) + " s");
+
+        audio.reserve (juce::jmax (audio.size(), minSamples));
+
+        for (size_t i = 0; audio.size() < minSamples; ++i)
+            audio.push_back (audio[i]);
+    }
+    else
+    {
+        note ("Audio: quiet noise (pass --audio=<file> with speech for realistic timings)");
+
+        juce::Random random (1);
+        audio.resize (minSamples);
+
+        for (auto& sample : audio)
+            sample = (random.nextFloat() * 2.0f - 1.0f) * 0.01f;
+    }
+
+    return audio;
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
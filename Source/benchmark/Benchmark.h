@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    Benchmark.h
+
+    Helpers shared by the VoxScriptBenchmark cases: timing over repeated
+    runs, heap use of one run (the allocator is replaced in Benchmark.cpp,
+    see countsAllMallocs()), and the test audio and model options every
+    whisper case takes.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+namespace VoxScript
+{
+
+class WhisperEngine;
+
+namespace Benchmark
+{
+
+/** Heap activity of the whole process since resetAllocationStats(). */
+struct AllocationStats
+{
+    juce::int64 count = 0;        // Allocations (malloc family, or operator new only)
+    juce::int64 bytes = 0;        // Bytes requested by them
+    juce::int64 peakBytes = 0;    // Highest live heap above the level at the reset
+};
+
+void resetAllocationStats();
+AllocationStats getAllocationStats();
+
+/**
+ * True if the malloc family is counted (glibc), so juce::HeapBlock and C
+ * allocations are included. Otherwise only operator new is, and the
+ * storage of juce::Array and AudioBuffer doesn't show up.
+ */
+bool countsAllMallocs() noexcept;
+
+/**
+ * Run fn once to warm up, then time it over runs, then count the heap use
+ * of one more run, and print one line: name, fastest and median time,
+ * allocations and peak heap growth.
+ */
+void measure (const juce::String& name, int runs, const std::function<void()>& fn);
+
+/** Print a line that isn't a measurement (setup, configuration). */
+void note (const juce::String& text);
+
+//==============================================================================
+// Options
+
+/** --runs=<n>, or defaultRuns. */
+int getRuns (const juce::ArgumentList& args, int defaultRuns);
+
+/** --model=<id>, or WhisperModelCatalogue::defaultModelId. */
+juce::String getModelId (const juce::ArgumentList& args);
+
+/**
+ * At least minSeconds of mono 16 kHz audio: --audio=<file>, looped if it is
+ * shorter, or quiet noise without one. Whisper's timings depend on what it
+ * hears, so use real speech for numbers worth comparing.
+ */
+std::vector<float> loadTestAudio (const juce::ArgumentList& args, WhisperEngine& engine, double minSeconds);
+
+//==============================================================================
+// Cases
+
+/** Inference time per clip length, with and without the adaptive encoder context. */
+void runAudioContext (const juce::ArgumentList& args);
+
+/** The compiled whisper backend and its inference time for one window. */
+void runWhisperBackend (const juce::ArgumentList& args);
+
+/** Time and peak memory of decoding a long file to 16 kHz mono. */
+void runPcmDecode (const juce::ArgumentList& args);
+
+/** Build, copy, iteration and serialisation costs of a long VoxSequence. */
+void runVoxSequence (const juce::ArgumentList& args);
+
+/** Greedy against selective beam and redecode(), with checks of their transcripts. */
+void runRebeam (const juce::ArgumentList& args);
+
+} // namespace Benchmark
+} // namespace VoxScript
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+    PcmDecodeBenchmark.cpp
+
+    "decode": WhisperEngine::readPcm16k, which decodes in blocks straight
+    into the 16 kHz output, against reading the whole file first (full
+    multichannel buffer, mono copy, resampled copy; how the engine read
+    files before). The peak heap growth is the number to watch.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/WhisperEngine.h"
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+namespace
+{
+    /** A stereo 48 kHz 24-bit WAV of a slow sweep, like a long take from a DAW. */
+    bool writeTestFile (const juce::File& file, double seconds)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numChannels = 2;
+
+        std::unique_ptr<juce::FileOutputStream> stream (file.createOutputStream());
+        if (stream == nullptr || !stream->openedOk())
+            return false;
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), sampleRate, numChannels, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        (void) stream.release(); // Owned by the writer now
+
+        constexpr int blockSize = 65536;
+        juce::AudioBuffer<float> block (numChannels, blockSize);
+        const auto totalSamples = (juce::int64) (seconds * sampleRate);
+        double phase = 0.0;
+
+        for (juce::int64 pos = 0; pos < totalSamples; pos += blockSize)
+        {
+            const int numSamples = (int) juce::jmin ((juce::int64) blockSize, totalSamples - pos);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto t = (double) (pos + i) / sampleRate;
+                phase += juce::MathConstants<double>::twoPi * (200.0 + 50.0 * std::sin (t * 0.5)) / sampleRate;
+                block.setSample (0, i, 0.25f * (float) std::sin (phase));
+                block.setSample (1, i, 0.25f * (float) std::cos (phase));
+            }
+
+            if (!writer->writeFromAudioSampleBuffer (block, 0, numSamples))
+                return false;
+        }
+
+        return true;
+    }
+
+    /** The whole-file decode readPcm16k replaced, kept here as the baseline. */
+    bool readWholeFile (const juce::File& file, std::vector<float>& pcmData)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+        if (reader == nullptr)
+            return false;
+
+        const auto numChannels = (int) reader->numChannels;
+        const auto numSamples = (int) reader->lengthInSamples;
+
+        juce::AudioBuffer<float> audioBuffer (numChannels, numSamples);
+        reader->read (&audioBuffer, 0, numSamples, 0, true, true);
+
+        std::vector<float> mono ((size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float sum = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                sum += audioBuffer.getSample (ch, i);
+            mono[(size_t) i] = sum / (float) numChannels;
+        }
+
+        const double ratio = 16000.0 / reader->sampleRate;
+        std::vector<float> resampled ((size_t) (mono.size() * ratio));
+
+        for (size_t i = 0; i < resampled.size(); ++i)
+        {
+            const double srcIndex = (double) i / ratio;
+            const auto idx0 = (size_t) srcIndex;
+            const auto idx1 = juce::jmin (idx0 + 1, mono.size() - 1);
+            const auto frac = (float) (srcIndex - (double) idx0);
+            resampled[i] = mono[idx0] * (1.0f - frac) + mono[idx1] * frac;
+        }
+
+        pcmData = std::move (resampled);
+        return !pcmData.empty();
+    }
+}
+
+void runPcmDecode (const juce::ArgumentList& args)
+{
+    const auto secondsOption = args.getValueForOption ("--seconds");
+    const double seconds = secondsOption.isNotEmpty() ? juce::jmax (1.0, secondsOption.getDoubleValue()) : 600.0;
+    const int runs = getRuns (args, 3);
+
+    juce::TemporaryFile temp (".wav");
+
+    if (!writeTestFile (temp.getFile(), seconds))
+        juce::ConsoleApplication::fail ("Could not write " + temp.getFile().getFullPathName());
+
+    note ("Audio: " + juce::String (seconds, 0) + " s stereo 48 kHz 24-bit WAV, "
+          + juce::String (runs) + " runs per line");
+
+    WhisperEngine engine;
+    std::vector<float> reused;
+
+    measure ("whole file", runs, [&]
+    {
+        std::vector<float> pcm;
+        readWholeFile (temp.getFile(), pcm);
+    });
+
+    measure ("readPcm16k, new output", runs, [&]
+    {
+        std::vector<float> pcm;
+        engine.readPcm16k (temp.getFile(), pcm);
+    });
+
+    // The job queue's case: the engine keeps its output buffer between jobs
+    measure ("readPcm16k, reused output", runs, [&] { engine.readPcm16k (temp.getFile(), reused); });
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+    RebeamBenchmark.cpp
+
+    "rebeam": the greedy pass with and without the selective beam
+    re-decode (see WhisperEngine::setSelectiveBeamSearch), and
+    WhisperEngine::redecode, which runs WhisperWindowDecoder over every
+    window. Each transcript is also checked: segments in order and inside
+    the audio, and an over-long prompt must not break the decoder. A
+    failed check ends the run with an error, so a decoder change that
+    regresses shows up here rather than in a host.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/WhisperEngine.h"
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+namespace
+{
+    /** The test audio as a mono 16 kHz WAV, since redecode() needs a processSync() of a file. */
+    bool writeTestFile (const juce::File& file, std::vector<float>& audio)
+    {
+        std::unique_ptr<juce::FileOutputStream> stream (file.createOutputStream());
+        if (stream == nullptr || !stream->openedOk())
+            return false;
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), 16000.0, 1, 16, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        (void) stream.release(); // Owned by the writer now
+
+        float* channels[] = { audio.data() };
+        const juce::AudioBuffer<float> buffer (channels, 1, (int) audio.size());
+        return writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    /** Fails the run if the transcript is out of order or outside the audio. */
+    void checkTranscript (const juce::String& label, const VoxSequence& sequence, double audioSeconds)
+    {
+        constexpr double tolerance = 0.05;
+        double previousStart = 0.0;
+
+        for (int i = 0; i < sequence.getNumSegments(); ++i)
+        {
+            const double start = sequence.getSegmentStart (i);
+            const double end = sequence.getSegmentEnd (i);
+
+            if (start < previousStart - tolerance || end < start || start < 0.0 || end > audioSeconds + tolerance)
+                juce::ConsoleApplication::fail (label + ": segment " + juce::String (i) + " ("
+                                                + juce::String (start, 2) + " - " + juce::String (end, 2)
+                                                + " s) is out of order or outside the audio");
+
+            previousStart = start;
+        }
+
+        note (label + ": " + juce::String (sequence.getNumSegments()) + " segments, "
+              + juce::String (sequence.getWordCount()) + " words");
+    }
+}
+
+void runRebeam (const juce::ArgumentList& args)
+{
+    WhisperEngine engine;
+    engine.setModel (getModelId (args));
+
+    // Three windows, so the refinement and redecode() cross window edges
+    auto audio = loadTestAudio (args, engine, 3.0 * WhisperEngine::maxBatchSeconds);
+    const double audioSeconds = (double) audio.size() / 16000.0;
+    const int runs = getRuns (args, 1);
+
+    juce::TemporaryFile temp (".wav");
+
+    if (!writeTestFile (temp.getFile(), audio))
+        juce::ConsoleApplication::fail ("Could not write " + temp.getFile().getFullPathName());
+
+    note ("Model: " + getModelId (args) + ", " + juce::String (runs) + " runs per line");
+
+    constexpr AudioSourceID sourceID = 1;
+    VoxSequence greedy, refined, redecoded;
+
+    engine.setSelectiveBeamSearch (false);
+    measure ("greedy", runs, [&] { greedy = engine.processSync (temp.getFile(), sourceID); });
+
+    engine.setSelectiveBeamSearch (true);
+    measure ("greedy + selective beam", runs, [&] { refined = engine.processSync (temp.getFile(), sourceID); });
+
+    // Only the decoder for windows the refinement kept; processSync() again first,
+    // since measure() runs redecode() repeatedly on what the last pass held
+    refined = engine.processSync (temp.getFile(), sourceID);
+
+    if (!engine.holdsAudioOf (sourceID))
+        juce::ConsoleApplication::fail ("The engine doesn't hold the audio of its last pass");
+
+    measure ("redecode", runs, [&] { redecoded = engine.redecode (engine.getLanguage()); });
+
+    checkTranscript ("greedy", greedy, audioSeconds);
+    checkTranscript ("greedy + selective beam", refined, audioSeconds);
+    checkTranscript ("redecode", redecoded, audioSeconds);
+
+    // A prompt longer than the text context is cut to its tail, never overruns it
+    juce::String longPrompt;
+    for (int i = 0; i < 2000; ++i)
+        longPrompt << "word" << i << ' ';
+
+    checkTranscript ("redecode, long prompt", engine.redecode (engine.getLanguage(), longPrompt), audioSeconds);
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
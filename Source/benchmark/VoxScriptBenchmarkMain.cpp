@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+    VoxScriptBenchmarkMain.cpp
+
+    VoxScriptBenchmark: times parts of the transcription pipeline outside a
+    host, so a change can be compared with the build before it. Each case
+    prints one line per measurement (see Benchmark::measure()).
+
+        VoxScriptBenchmark audioctx --model=base.en --audio=speech.wav
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmark.h"
+
+int main (int argc, char* argv[])
+{
+    using namespace VoxScript;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand ("--help|-h", "Usage: VoxScriptBenchmark <case> [--runs=<n>] [--model=<id>] [--audio=<file>]", true);
+
+    app.addCommand ({ "audioctx",
+                      "audioctx [--model=<id>] [--audio=<file>] [--runs=<n>]",
+                      "Inference time per clip length, adaptive encoder context on and off",
+                      "Transcribes 2 to 30 s clips of the audio (quiet noise without --audio).",
+                      [] (const juce::ArgumentList& args) { Benchmark::runAudioContext (args); } });
+
+    app.addCommand ({ "backend",
+                      "backend [--model=<id>] [--audio=<file>] [--runs=<n>]",
+                      "The compiled whisper CPU level and its time for one 30 s window",
+                      "Build once per VOXSCRIPT_WHISPER_CPU_LEVEL to compare the levels on one machine.",
+                      [] (const juce::ArgumentList& args) { Benchmark::runWhisperBackend (args); } });
+
+    app.addCommand ({ "decode",
+                      "decode [--seconds=<n>] [--runs=<n>]",
+                      "Time and peak memory of decoding a long file to 16 kHz mono",
+                      "Writes a stereo 48 kHz WAV of --seconds (default 600) and reads it back.",
+                      [] (const juce::ArgumentList& args) { Benchmark::runPcmDecode (args); } });
+
+    app.addCommand ({ "sequence",
+                      "sequence [--minutes=<n>] [--runs=<n>]",
+                      "Build, copy, iteration and serialisation costs of a long transcript",
+                      "Uses a synthetic transcript of --minutes (default 60), compared with juce::Array<VoxSegment>.",
+                      [] (const juce::ArgumentList& args) { Benchmark::runVoxSequence (args); } });
+
+    app.addCommand ({ "rebeam",
+                      "rebeam [--model=<id>] [--audio=<file>] [--runs=<n>]",
+                      "Selective beam re-decode and WhisperEngine::redecode against the greedy pass",
+                      "Fails if a transcript is out of order, outside the audio, or a long prompt breaks the decoder.",
+                      [] (const juce::ArgumentList& args) { Benchmark::runRebeam (args); } });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+    VoxSequenceBenchmark.cpp
+
+    "sequence": the costs of a long transcript in VoxSequence's column
+    layout, next to the juce::Array<VoxSegment> it used to be, for the
+    operations the plug-in does often: building, copying (every store
+    snapshot), iterating and serialising.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/VoxSequence.h"
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+namespace
+{
+    /** A segment every 4 s with ten words, about what whisper gives for speech. */
+    juce::Array<VoxSegment> makeSegments (double minutes)
+    {
+        static const char* const vocabulary[] = { "the", "take", "again", "from", "bar", "twelve", "louder",
+                                                  "please", "we", "keep", "that", "one", "chorus", "verse" };
+        constexpr double segmentSeconds = 4.0;
+        constexpr int wordsPerSegment = 10;
+
+        juce::Array<VoxSegment> segments;
+        juce::Random random (1);
+
+        for (double start = 0.0; start < minutes * 60.0; start += segmentSeconds)
+        {
+            VoxSegment segment;
+            segment.startTime = start;
+            segment.endTime = start + segmentSeconds;
+
+            for (int w = 0; w < wordsPerSegment; ++w)
+            {
+                VoxWord word;
+                word.startTime = start + w * segmentSeconds / wordsPerSegment;
+                word.endTime = word.startTime + segmentSeconds / wordsPerSegment;
+                word.text = vocabulary[random.nextInt (juce::numElementsInArray (vocabulary))];
+                word.confidence = 0.5f + 0.5f * random.nextFloat();
+
+                segment.text << (w > 0 ? " " : "") << word.text;
+                segment.words.add (word);
+            }
+
+            segments.add (segment);
+        }
+
+        return segments;
+    }
+}
+
+void runVoxSequence (const juce::ArgumentList& args)
+{
+    const auto minutesOption = args.getValueForOption ("--minutes");
+    const double minutes = minutesOption.isNotEmpty() ? juce::jmax (1.0, minutesOption.getDoubleValue()) : 60.0;
+    const int runs = getRuns (args, 10);
+
+    const auto segments = makeSegments (minutes);
+
+    VoxSequence sequence;
+    for (const auto& segment : segments)
+        sequence.addSegment (segment);
+
+    note ("Transcript: " + juce::String (minutes, 0) + " min, " + juce::String (sequence.getNumSegments()) + " segments, "
+          + juce::String (sequence.getNumWords()) + " words, " + juce::String (runs) + " runs per line");
+
+    measure ("build", runs, [&]
+    {
+        VoxSequence built;
+        for (const auto& segment : segments)
+            built.addSegment (segment);
+    });
+
+    // Copies: the peak is what one more snapshot of the transcript holds
+    measure ("copy", runs, [&] { VoxSequence copy (sequence); juce::ignoreUnused (copy); });
+    measure ("copy, Array<VoxSegment> (before)", runs, [&] { juce::Array<VoxSegment> copy (segments); juce::ignoreUnused (copy); });
+
+    juce::int64 checksum = 0;
+
+    measure ("iterate getSegments()", runs, [&]
+    {
+        for (const auto segment : sequence.getSegments())
+            checksum += segment.text.length() + segment.words.size();
+    });
+
+    measure ("iterate Array<VoxSegment> (before)", runs, [&]
+    {
+        for (const auto& segment : segments)
+            checksum += segment.text.length() + segment.words.size();
+    });
+
+    measure ("iterate word columns", runs, [&]
+    {
+        double total = 0.0;
+        for (int i = 0; i < sequence.getNumWords(); ++i)
+            total += (sequence.getWordEnd (i) - sequence.getWordStart (i)) * sequence.getWordConfidence (i);
+        checksum += (juce::int64) total;
+    });
+
+    measure ("getFullText()", runs, [&] { checksum += sequence.getFullText().length(); });
+
+    measure ("toValueTree() + fromValueTree()", runs, [&]
+    {
+        VoxSequence restored;
+        restored.fromValueTree (sequence.toValueTree());
+        checksum += restored.getWordCount();
+    });
+
+    note ("(checksum " + juce::String (checksum) + ")"); // Keeps the loops from being optimised away
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
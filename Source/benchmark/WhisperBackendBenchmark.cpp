@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+    WhisperBackendBenchmark.cpp
+
+    "backend": what the compiled whisper kernels (VOXSCRIPT_WHISPER_CPU_LEVEL,
+    VOXSCRIPT_WHISPER_OPENBLAS) do on this machine. Prints the backend and
+    times one full 30 s window at one thread and at the recommended thread
+    count. Build the app once per CPU level to compare them.
+
+    Part of VoxScript Benchmarks
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../transcription/WhisperEngine.h"
+#include "../transcription/WhisperSystemInfo.h"
+
+namespace VoxScript
+{
+namespace Benchmark
+{
+
+void runWhisperBackend (const juce::ArgumentList& args)
+{
+    note ("Backend: " + WhisperSystemInfo::getBackendDescription());
+
+    juce::String missing;
+    if (!WhisperSystemInfo::isCpuSupported (missing))
+        juce::ConsoleApplication::fail ("This CPU can't run the compiled kernels (missing " + missing + ")");
+
+    WhisperEngine engine;
+    engine.setModel (getModelId (args));
+    engine.setAdaptiveAudioContext (false); // Always the full window, so builds compare like for like
+
+    const auto audio = loadTestAudio (args, engine, WhisperEngine::maxBatchSeconds);
+    const auto numSamples = (size_t) (WhisperEngine::maxBatchSeconds * 16000.0);
+    const int runs = getRuns (args, 3);
+    const int recommended = WhisperSystemInfo::getRecommendedThreadCount();
+
+    note ("Model: " + getModelId (args) + ", " + juce::String (runs) + " runs per line");
+
+    for (int threads : { 1, recommended })
+    {
+        engine.setNumThreads (threads);
+        measure ("30 s window, " + juce::String (threads) + (threads == 1 ? " thread" : " threads"), runs,
+                 [&] { engine.processSamples (audio.data(), numSamples); });
+
+        if (recommended == 1)
+            break;
+    }
+}
+
+} // namespace Benchmark
+} // namespace VoxScript
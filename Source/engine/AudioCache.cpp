@@ -11,6 +11,11 @@
 namespace VoxScript
 {
 
+AudioCache::~AudioCache()
+{
+    clear();
+}
+
 bool AudioCache::ensureCached (AudioCacheID id, const juce::ARAAudioSource* source)
 {
     if (source == nullptr)
@@ -36,6 +41,9 @@ bool AudioCache::ensureCached (AudioCacheID id, const juce::ARAAudioSource* sour
     if (reader == nullptr || reader->lengthInSamples == 0)
         return false;
 
+    // Large sources: let idle models etc. make room before we allocate
+    memoryBudget->requestHeadroom ((juce::int64) reader->numChannels * reader->lengthInSamples * (juce::int64) sizeof (float));
+
     auto newCache = std::make_shared<CachedAudio>();
     newCache->sampleRate = reader->sampleRate;
     newCache->numChannels = (int)reader->numChannels;
@@ -54,7 +62,13 @@ bool AudioCache::ensureCached (AudioCacheID id, const juce::ARAAudioSource* sour
     // 3. Insert into map (Writer Lock)
     {
         const juce::ScopedWriteLock wl (lock);
-        cache[id] = newCache;
+        auto& slot = cache[id];
+
+        if (slot != nullptr)
+            memoryBudget->addUsage (MemoryBudget::Category::AudioCache, -slot->getSizeInBytes());
+
+        slot = newCache;
+        memoryBudget->addUsage (MemoryBudget::Category::AudioCache, newCache->getSizeInBytes());
     }
 
     juce::Logger::writeToLog("AudioCache: Cached " + juce::String(newCache->numSamples) + " samples for ID " + juce::String((uintptr_t)id));
@@ -82,12 +96,22 @@ std::shared_ptr<CachedAudio> AudioCache::get (AudioCacheID id) const
 void AudioCache::remove (AudioCacheID id)
 {
     const juce::ScopedWriteLock wl (lock);
-    cache.erase(id);
+
+    auto it = cache.find(id);
+    if (it != cache.end())
+    {
+        memoryBudget->addUsage (MemoryBudget::Category::AudioCache, -it->second->getSizeInBytes());
+        cache.erase(it);
+    }
 }
 
 void AudioCache::clear()
 {
     const juce::ScopedWriteLock wl (lock);
+
+    for (const auto& entry : cache)
+        memoryBudget->addUsage (MemoryBudget::Category::AudioCache, -entry.second->getSizeInBytes());
+
     cache.clear();
 }
 
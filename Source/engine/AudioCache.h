@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "MemoryBudget.h"
 
 namespace VoxScript
 {
@@ -29,6 +30,12 @@ struct CachedAudio
     juce::int64 numSamples { 0 };
     
     CachedAudio() = default;
+
+    /** Bytes held by the sample buffer (for MemoryBudget accounting). */
+    juce::int64 getSizeInBytes() const noexcept
+    {
+        return (juce::int64) buffer.getNumChannels() * buffer.getNumSamples() * (juce::int64) sizeof (float);
+    }
     
     // Non-copyable to prevent accidental large copies
     CachedAudio(const CachedAudio&) = delete;
@@ -43,12 +50,14 @@ struct CachedAudio
  * 
  * Owns independent copies of audio data from ARA sources.
  * Allows lock-free (or wait-free-ish) access from render thread via tryEnterRead.
+ * Cached bytes are reported to the process-wide MemoryBudget, and new entries
+ * ask it for headroom first (which may unload idle transcription models).
  */
 class AudioCache
 {
 public:
     AudioCache() = default;
-    ~AudioCache() = default;
+    ~AudioCache();
 
     /**
      * @brief Ensures audio for the given source is cached.
@@ -95,6 +104,7 @@ public:
 private:
     std::map<AudioCacheID, std::shared_ptr<CachedAudio>> cache;
     juce::ReadWriteLock lock;
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCache)
 };
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    MelSpectrogramService.cpp
+
+    Part of VoxScript Mission 2: Audio Cache
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "MelSpectrogramService.h"
+
+namespace VoxScript
+{
+
+MelSpectrogramService::MelSpectrogramService()
+{
+    reclaimerHandle = memoryBudget->addReclaimer ([this] { return releaseUnused(); });
+}
+
+MelSpectrogramService::~MelSpectrogramService()
+{
+    memoryBudget->removeReclaimer (reclaimerHandle);
+    clear();
+}
+
+std::shared_ptr<const MelSpectrogram> MelSpectrogramService::find (AudioSourceID sourceID) const
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    auto it = spectrograms.find (sourceID);
+    return it != spectrograms.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<const MelSpectrogram> MelSpectrogramService::getOrCompute (AudioSourceID sourceID,
+                                                                           const std::vector<float>& pcm16k,
+                                                                           const std::atomic<bool>* shouldCancel)
+{
+    return getOrCompute (sourceID, pcm16k, getGeneration (sourceID), shouldCancel);
+}
+
+std::shared_ptr<const MelSpectrogram> MelSpectrogramService::getOrCompute (AudioSourceID sourceID,
+                                                                           const std::vector<float>& pcm16k,
+                                                                           juce::uint64 generation,
+                                                                           const std::atomic<bool>* shouldCancel)
+{
+    if (auto existing = find (sourceID))
+        return existing;
+
+    // 80 bands x 2 bytes per 10 ms frame
+    const auto expectedBytes = (juce::int64) (pcm16k.size() / MelSpectrogram::hopSize + 1)
+                               * MelSpectrogram::numBands * (juce::int64) sizeof (juce::int16);
+    memoryBudget->requestHeadroom (expectedBytes);
+
+    // Computed outside the lock, so several workers may compute the same source
+    auto spectrogram = MelSpectrogram::compute (pcm16k.data(), pcm16k.size(), shouldCancel);
+
+    if (spectrogram == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard (lock);
+
+    // The audio changed since it was read: still the caller's to use, but not the source's
+    auto it = generations.find (sourceID);
+    if ((it != generations.end() ? it->second : 0) != generation)
+        return spectrogram;
+
+    // Another worker got there first; keep the one that may already be in use
+    auto& slot = spectrograms[sourceID];
+
+    if (slot == nullptr)
+    {
+        slot = spectrogram;
+        memoryBudget->addUsage (MemoryBudget::Category::Spectrograms, slot->getSizeInBytes());
+    }
+
+    return slot;
+}
+
+juce::uint64 MelSpectrogramService::getGeneration (AudioSourceID sourceID) const
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    auto it = generations.find (sourceID);
+    return it != generations.end() ? it->second : 0;
+}
+
+void MelSpectrogramService::invalidate (AudioSourceID sourceID)
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    generations[sourceID] = ++lastGeneration;
+
+    auto it = spectrograms.find (sourceID);
+    if (it != spectrograms.end())
+    {
+        memoryBudget->addUsage (MemoryBudget::Category::Spectrograms, -it->second->getSizeInBytes());
+        spectrograms.erase (it);
+    }
+}
+
+void MelSpectrogramService::clear()
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    for (const auto& entry : spectrograms)
+        memoryBudget->addUsage (MemoryBudget::Category::Spectrograms, -entry.second->getSizeInBytes());
+
+    spectrograms.clear();
+}
+
+juce::int64 MelSpectrogramService::releaseUnused()
+{
+    std::lock_guard<std::mutex> guard (lock);
+    juce::int64 released = 0;
+
+    for (auto it = spectrograms.begin(); it != spectrograms.end(); )
+    {
+        // use_count() == 1: no view or engine is holding it right now
+        if (it->second.use_count() == 1)
+        {
+            const auto bytes = it->second->getSizeInBytes();
+            memoryBudget->addUsage (MemoryBudget::Category::Spectrograms, -bytes);
+            released += bytes;
+            it = spectrograms.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return released;
+}
+
+} // namespace VoxScript
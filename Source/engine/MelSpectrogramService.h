@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    MelSpectrogramService.h
+
+    Per-document cache of log-mel spectrograms, one per audio source.
+    Filled by the transcription workers from the 16 kHz audio they already
+    decode: by the language probe, which needs it, and otherwise after a
+    result is published, for the Detail View. Also read by the voice
+    activity detection and the whisper calls fed through whisper_set_mel
+    (language probe, retained re-decode windows). The whisper_full passes
+    don't use it; they compute their own mel.
+
+    Part of VoxScript Mission 2: Audio Cache
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MemoryBudget.h"
+#include "../ara/VoxScriptDocumentStore.h"
+#include "../transcription/MelSpectrogram.h"
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Thread-safe spectrogram cache keyed by AudioSourceID.
+ *
+ * Entries are computed once per source content: refinement passes and
+ * re-decodes reuse them, and invalidate() drops an entry when the source's
+ * audio changes. Several workers may compute the same source at once; the
+ * first result is kept. Sizes are reported to the MemoryBudget; under
+ * memory pressure, entries nobody currently holds are released.
+ *
+ * Thread Safety:
+ * - All methods may be called from any non-audio thread.
+ */
+class MelSpectrogramService
+{
+public:
+    MelSpectrogramService();
+    ~MelSpectrogramService();
+
+    /** Cached spectrogram, or nullptr. */
+    std::shared_ptr<const MelSpectrogram> find (AudioSourceID sourceID) const;
+
+    /**
+     * Cached spectrogram, computing it from the source's 16 kHz mono audio if needed.
+     * Not cached if the source is invalidated while it is computed.
+     * @return nullptr if cancelled
+     */
+    std::shared_ptr<const MelSpectrogram> getOrCompute (AudioSourceID sourceID,
+                                                        const std::vector<float>& pcm16k,
+                                                        const std::atomic<bool>* shouldCancel = nullptr);
+
+    /**
+     * As above, for audio read earlier: cached only if the source hasn't been
+     * invalidated since getGeneration() returned generation.
+     */
+    std::shared_ptr<const MelSpectrogram> getOrCompute (AudioSourceID sourceID,
+                                                        const std::vector<float>& pcm16k,
+                                                        juce::uint64 generation,
+                                                        const std::atomic<bool>* shouldCancel = nullptr);
+
+    /** Changes with every invalidate() of the source. */
+    juce::uint64 getGeneration (AudioSourceID sourceID) const;
+
+    /** Drop the entry for a source (audio changed or source removed). */
+    void invalidate (AudioSourceID sourceID);
+
+    void clear();
+
+private:
+    juce::int64 releaseUnused();
+
+    mutable std::mutex lock;
+    std::map<AudioSourceID, std::shared_ptr<const MelSpectrogram>> spectrograms;
+    std::map<AudioSourceID, juce::uint64> generations; // Of invalidated sources; others are at 0
+    juce::uint64 lastGeneration = 0;
+
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
+    int reclaimerHandle = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MelSpectrogramService)
+};
+
+} // namespace VoxScript
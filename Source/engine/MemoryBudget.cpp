@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+    MemoryBudget.cpp
+
+    Part of VoxScript Mission 2: Audio Cache
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "MemoryBudget.h"
+
+namespace VoxScript
+{
+
+MemoryBudget::MemoryBudget()
+{
+    for (auto& u : usage)
+        u.store (0);
+
+    // Optional budget from the environment, in MB
+    const auto fromEnvironment = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_MEMORY_BUDGET_MB", {});
+
+    if (fromEnvironment.isNotEmpty())
+        budgetBytes.store (fromEnvironment.getLargeIntValue() * 1024 * 1024);
+}
+
+void MemoryBudget::addUsage (Category category, juce::int64 deltaBytes) noexcept
+{
+    usage[static_cast<size_t> (category)].fetch_add (deltaBytes);
+}
+
+juce::int64 MemoryBudget::getUsage (Category category) const noexcept
+{
+    return usage[static_cast<size_t> (category)].load();
+}
+
+juce::int64 MemoryBudget::getTotalUsage() const noexcept
+{
+    juce::int64 total = 0;
+
+    for (const auto& u : usage)
+        total += u.load();
+
+    return total;
+}
+
+bool MemoryBudget::hasHeadroom (juce::int64 bytesNeeded) const noexcept
+{
+    const auto budget = budgetBytes.load();
+    return budget <= 0 || getTotalUsage() + bytesNeeded <= budget;
+}
+
+bool MemoryBudget::requestHeadroom (juce::int64 bytesNeeded)
+{
+    const auto budget = budgetBytes.load();
+
+    if (hasHeadroom (bytesNeeded))
+    {
+        if (overBudget.exchange (false))
+            juce::Logger::writeToLog ("MemoryBudget: Back within budget");
+
+        return true;
+    }
+
+    // Held while calling, so an owner cannot unregister (and die) mid-call.
+    // Reclaimers must therefore not add or remove reclaimers themselves.
+    std::lock_guard<std::mutex> lock (reclaimerMutex);
+
+    for (auto& entry : reclaimers)
+    {
+        const auto freed = entry.second();
+
+        if (freed > 0)
+            juce::Logger::writeToLog ("MemoryBudget: Reclaimed " + juce::String (freed / (1024 * 1024)) + " MB");
+
+        if (getTotalUsage() + bytesNeeded <= budget)
+        {
+            overBudget = false;
+            return true;
+        }
+    }
+
+    if (!overBudget.exchange (true))
+        juce::Logger::writeToLog ("MemoryBudget: Over budget by "
+                                  + juce::String ((getTotalUsage() + bytesNeeded - budget) / (1024 * 1024)) + " MB");
+    return false;
+}
+
+int MemoryBudget::addReclaimer (Reclaimer reclaimer)
+{
+    std::lock_guard<std::mutex> lock (reclaimerMutex);
+    const int handle = nextReclaimerHandle++;
+    reclaimers.emplace_back (handle, std::move (reclaimer));
+    return handle;
+}
+
+void MemoryBudget::removeReclaimer (int handle)
+{
+    std::lock_guard<std::mutex> lock (reclaimerMutex);
+
+    reclaimers.erase (std::remove_if (reclaimers.begin(), reclaimers.end(),
+                                      [handle] (const auto& entry) { return entry.first == handle; }),
+                      reclaimers.end());
+}
+
+} // namespace VoxScript
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+    MemoryBudget.h
+
+    Process-wide accounting of VoxScript's large allocations (cached audio,
+    loaded models) against an optional budget. When a new allocation would
+    exceed the budget, registered reclaimers are asked to free memory first,
+    e.g. the model cache drops models that no engine is using.
+
+    Part of VoxScript Mission 2: Audio Cache
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Shared memory budget for all plugin instances in the host process.
+ *
+ * Use through juce::SharedResourcePointer<MemoryBudget>.
+ *
+ * Thread Safety:
+ * - addUsage() and hasHeadroom() are lock-free and may be called from any
+ *   non-audio thread.
+ * - requestHeadroom() calls reclaimers on the calling thread while holding the
+ *   reclaimer lock, so reclaimers must not register or unregister reclaimers.
+ */
+class MemoryBudget
+{
+public:
+    enum class Category
+    {
+        AudioCache,
+        Models,
+        Spectrograms,
+        NumCategories
+    };
+
+    /** Frees memory if possible. Returns the number of bytes released. */
+    using Reclaimer = std::function<juce::int64()>;
+
+    MemoryBudget();
+    ~MemoryBudget() = default;
+
+    /** Budget in bytes across all categories. 0 means unlimited (default). */
+    void setBudgetBytes (juce::int64 newBudget) noexcept { budgetBytes.store (newBudget); }
+    juce::int64 getBudgetBytes() const noexcept { return budgetBytes.load(); }
+
+    /** Record an allocation (positive) or release (negative). */
+    void addUsage (Category category, juce::int64 deltaBytes) noexcept;
+
+    juce::int64 getUsage (Category category) const noexcept;
+    juce::int64 getTotalUsage() const noexcept;
+
+    /** True if an allocation of the given size fits as things are; frees nothing. */
+    bool hasHeadroom (juce::int64 bytesNeeded) const noexcept;
+
+    /**
+     * Make room for an allocation of the given size.
+     * Calls reclaimers until usage + bytesNeeded fits the budget.
+     * Logs when it goes over budget and when it fits again, not on every call.
+     * @return true if the allocation fits (always true without a budget)
+     */
+    bool requestHeadroom (juce::int64 bytesNeeded);
+
+    /** Register a reclaimer; returns a handle for removeReclaimer(). */
+    int addReclaimer (Reclaimer reclaimer);
+    void removeReclaimer (int handle);
+
+private:
+    std::atomic<juce::int64> budgetBytes { 0 };
+    std::atomic<juce::int64> usage[static_cast<size_t> (Category::NumCategories)];
+    std::atomic<bool> overBudget { false }; // Last request didn't fit
+
+    std::mutex reclaimerMutex;
+    std::vector<std::pair<int, Reclaimer>> reclaimers;
+    int nextReclaimerHandle = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryBudget)
+};
+
+} // namespace VoxScript
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+    RealtimeLoadGovernor.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "RealtimeLoadGovernor.h"
+#include <cmath>
+
+namespace VoxScript
+{
+
+RealtimeLoadGovernor::RealtimeLoadGovernor()
+{
+    const auto fromEnvironment = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_LOAD_POLICY", {});
+
+    if (fromEnvironment.isNotEmpty())
+        setPolicy (policyFromString (fromEnvironment));
+}
+
+juce::String RealtimeLoadGovernor::toString (Policy policyToName)
+{
+    switch (policyToName)
+    {
+        case Policy::Aggressive:     return "aggressive";
+        case Policy::BackgroundOnly: return "background";
+        case Policy::Balanced:
+        default:                     return "balanced";
+    }
+}
+
+RealtimeLoadGovernor::Policy RealtimeLoadGovernor::policyFromString (const juce::String& name)
+{
+    for (auto candidate : { Policy::Aggressive, Policy::Balanced, Policy::BackgroundOnly })
+        if (name.trim().equalsIgnoreCase (toString (candidate)))
+            return candidate;
+
+    return Policy::Balanced;
+}
+
+//==============================================================================
+void RealtimeLoadGovernor::BlockTimer::prepare (double newSampleRate, int maximumBlockSize) noexcept
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    periodSeconds = juce::jmax (1, maximumBlockSize) / sampleRate;
+    lastArrivalSeconds = 0.0;
+    wasPlaying = false;
+}
+
+void RealtimeLoadGovernor::BlockTimer::blockStarted() noexcept
+{
+    startTicks = juce::Time::getHighResolutionTicks();
+}
+
+void RealtimeLoadGovernor::BlockTimer::blockFinished (RealtimeLoadGovernor& governor, int numSamples,
+                                                      bool isPlaying, bool isRealtime) noexcept
+{
+    if (!isRealtime)
+    {
+        governor.reportOfflineBlock();
+        wasPlaying = false;
+        return;
+    }
+
+    if (numSamples <= 0 || startTicks == 0)
+    {
+        wasPlaying = false;
+        return;
+    }
+
+    const double arrival = juce::Time::highResolutionTicksToSeconds (startTicks);
+    const double processing = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+    const double blockSeconds = numSamples / sampleRate;
+
+    // The audio clock: where this callback would arrive if the host were never late.
+    // Restarted after a stop or a gap; pulled forward by early (burst) callbacks.
+    if (!wasPlaying || arrival - lastArrivalSeconds > 8.0 * periodSeconds)
+    {
+        clockStartSeconds = arrival;
+        renderedSeconds = 0.0;
+    }
+
+    double lateSeconds = arrival - (clockStartSeconds + renderedSeconds);
+
+    if (lateSeconds < 0.0)
+    {
+        clockStartSeconds += lateSeconds;
+        lateSeconds = 0.0;
+    }
+
+    const double lateness = lateSeconds / periodSeconds;
+    const bool overran = lateness > 1.0;
+
+    // An overrun resets the clock, so one dropout isn't counted for every later block
+    if (overran)
+    {
+        clockStartSeconds = arrival;
+        renderedSeconds = 0.0;
+    }
+
+    renderedSeconds += blockSeconds;
+    lastArrivalSeconds = arrival;
+    wasPlaying = isPlaying;
+
+    const double load = processing / blockSeconds;
+    governor.reportBlock (static_cast<float> (juce::jlimit (0.0, 1.0, juce::jmax (load, lateness))),
+                          blockSeconds, isPlaying, overran);
+}
+
+//==============================================================================
+void RealtimeLoadGovernor::reportBlock (float blockPressure, double blockSeconds, bool isPlaying, bool overran) noexcept
+{
+    const auto nowMs = juce::Time::getMillisecondCounter();
+
+    if (isPlaying)
+    {
+        lastPlayingMs.store (nowMs);
+        hasPlayed.store (true);
+    }
+
+    if (overran)
+    {
+        lastOverrunMs.store (nowMs);
+        hasOverrun.store (true);
+    }
+
+    // Peaks count at once, then decay
+    const auto decay = static_cast<float> (std::exp (-blockSeconds / pressureDecaySeconds));
+    auto current = pressure.load();
+
+    while (!pressure.compare_exchange_weak (current, juce::jmax (blockPressure, current * decay)))
+    {
+    }
+}
+
+void RealtimeLoadGovernor::reportOfflineBlock() noexcept
+{
+    lastOfflineMs.store (juce::Time::getMillisecondCounter());
+    hasRenderedOffline.store (true);
+}
+
+void RealtimeLoadGovernor::beginOfflineRender() noexcept
+{
+    numOfflineRenderers.fetch_add (1);
+    reportOfflineBlock(); // Counts from now, before the first block arrives
+}
+
+void RealtimeLoadGovernor::endOfflineRender() noexcept
+{
+    auto current = numOfflineRenderers.load();
+
+    while (current > 0 && !numOfflineRenderers.compare_exchange_weak (current, current - 1))
+    {
+    }
+}
+
+bool RealtimeLoadGovernor::isRenderingOffline() const noexcept
+{
+    if (!hasRenderedOffline.load())
+        return false;
+
+    const auto holdMs = numOfflineRenderers.load() > 0 ? preparedOfflineHoldMs : offlineHoldMs;
+    return juce::Time::getMillisecondCounter() - lastOfflineMs.load() < holdMs;
+}
+
+bool RealtimeLoadGovernor::isPlaying() const noexcept
+{
+    return hasPlayed.load() && juce::Time::getMillisecondCounter() - lastPlayingMs.load() < playingHoldMs;
+}
+
+float RealtimeLoadGovernor::getHeadroom() const noexcept
+{
+    return isPlaying() ? 1.0f - pressure.load() : 1.0f;
+}
+
+RealtimeLoadGovernor::Throttle RealtimeLoadGovernor::getThrottle() const noexcept
+{
+    // A bounce finishes sooner with the whole machine
+    if (isRenderingOffline())
+        return Throttle::Paused;
+
+    if (!isPlaying())
+        return Throttle::Full;
+
+    const bool recentOverrun = hasOverrun.load() && juce::Time::getMillisecondCounter() - lastOverrunMs.load() < overrunHoldMs;
+    const float headroom = getHeadroom();
+
+    switch (policy.load())
+    {
+        case Policy::Aggressive:
+            return recentOverrun || headroom < aggressiveMinHeadroom ? Throttle::Reduced : Throttle::Full;
+
+        case Policy::BackgroundOnly:
+            return Throttle::Paused;
+
+        case Policy::Balanced:
+        default:
+            return recentOverrun || headroom < balancedMinHeadroom ? Throttle::Paused : Throttle::Reduced;
+    }
+}
+
+} // namespace VoxScript
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+    RealtimeLoadGovernor.h
+
+    Keeps background transcription out of the way of realtime playback.
+    The playback renderers report how their blocks are timed; the job queue
+    asks the governor whether its workers may run at full speed, should
+    shrink to one worker with fewer threads, or should pause until the
+    host has headroom again.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Throttles transcription by measured realtime headroom.
+ *
+ * Headroom is estimated from what a plug-in can see of the host's load:
+ * the share of each block's duration our render callback takes, and how
+ * late the callback arrives compared with the audio clock (a busy graph
+ * calls us later in the cycle; a callback more than a block late counts
+ * as an overrun). Peaks are taken at once and decay over a few seconds.
+ *
+ * Policies, while the transport plays in realtime:
+ * - Aggressive: full speed; shrinks only when headroom is low or after an overrun.
+ * - Balanced (default): one worker with fewer threads; pauses when headroom
+ *   is low or after an overrun.
+ * - BackgroundOnly: paused.
+ * With the transport stopped every policy runs at full speed.
+ *
+ * Offline renders (bounces, freezes) pause transcription under every
+ * policy: the host renders as fast as the CPU allows, so every core we
+ * take makes the bounce longer. A render counts from prepareToPlay() of a
+ * renderer that is always non-realtime until its releaseResources(), and
+ * otherwise while non-realtime blocks keep arriving. Paused passes keep
+ * their progress and continue once the render is over.
+ *
+ * Thread Safety:
+ * - reportBlock() and reportOfflineBlock() are wait-free and meant for the
+ *   audio thread (via BlockTimer).
+ * - Everything else may be called from any thread.
+ */
+class RealtimeLoadGovernor
+{
+public:
+    enum class Policy
+    {
+        Aggressive,
+        Balanced,
+        BackgroundOnly
+    };
+
+    enum class Throttle
+    {
+        Full,       // All workers, all threads
+        Reduced,    // One worker, half its threads
+        Paused      // No inference; running passes stop at the next window
+    };
+
+    /** Starts with VOXSCRIPT_LOAD_POLICY (aggressive, balanced, background) or Balanced. */
+    RealtimeLoadGovernor();
+
+    void setPolicy (Policy newPolicy) noexcept { policy.store (newPolicy); }
+    Policy getPolicy() const noexcept { return policy.load(); }
+
+    static juce::String toString (Policy policyToName);
+
+    /** Parse a name from toString() (case-insensitive); Balanced if unknown. */
+    static Policy policyFromString (const juce::String& name);
+
+    //==========================================================================
+    /**
+     * @brief Per-renderer block timing (audio thread only).
+     * Call blockStarted() first thing in processBlock and blockFinished() last.
+     */
+    class BlockTimer
+    {
+    public:
+        void prepare (double sampleRate, int maximumBlockSize) noexcept;
+        void blockStarted() noexcept;
+        void blockFinished (RealtimeLoadGovernor& governor, int numSamples, bool isPlaying, bool isRealtime) noexcept;
+
+    private:
+        double sampleRate = 44100.0;
+        double periodSeconds = 512.0 / 44100.0;
+        juce::int64 startTicks = 0;
+        double lastArrivalSeconds = 0.0;
+        double clockStartSeconds = 0.0;
+        double renderedSeconds = 0.0;
+        bool wasPlaying = false;
+    };
+
+    /**
+     * Report one realtime block.
+     * @param pressure     max(processing share, lateness in blocks) of the block
+     * @param blockSeconds Audio length of the block (sets the decay step)
+     * @param isPlaying    Transport is rolling
+     * @param overran      The callback was more than a block late
+     */
+    void reportBlock (float pressure, double blockSeconds, bool isPlaying, bool overran) noexcept;
+
+    /** Report one non-realtime block (an offline render is running). */
+    void reportOfflineBlock() noexcept;
+
+    /**
+     * A renderer was prepared for non-realtime use only (the host's
+     * alwaysNonRealtime); pair with endOfflineRender() when it is released.
+     */
+    void beginOfflineRender() noexcept;
+    void endOfflineRender() noexcept;
+
+    //==========================================================================
+    /** What transcription workers may do right now. */
+    Throttle getThrottle() const noexcept;
+
+    /** Estimated share of the realtime budget left (1 = idle or stopped). */
+    float getHeadroom() const noexcept;
+
+    /** True while the transport has played in realtime recently. */
+    bool isPlaying() const noexcept;
+
+    /** True while the host renders offline. */
+    bool isRenderingOffline() const noexcept;
+
+    /** A stopped transport this long counts as stopped. */
+    static constexpr juce::uint32 playingHoldMs = 500;
+
+    /** Non-realtime blocks this far apart still belong to one render. */
+    static constexpr juce::uint32 offlineHoldMs = 1000;
+
+    /**
+     * Same for an always-non-realtime renderer, whose host may pause longer
+     * between blocks (writing files, next track); also bounds how long one
+     * that is never released keeps transcription paused.
+     */
+    static constexpr juce::uint32 preparedOfflineHoldMs = 5000;
+
+    /** After an overrun, stay throttled at least this long. */
+    static constexpr juce::uint32 overrunHoldMs = 3000;
+
+    /** Time constant of the pressure decay after a peak. */
+    static constexpr double pressureDecaySeconds = 2.0;
+
+    /** Below this headroom, Balanced pauses and Aggressive shrinks. */
+    static constexpr float balancedMinHeadroom = 0.4f;
+    static constexpr float aggressiveMinHeadroom = 0.25f;
+
+private:
+    std::atomic<Policy> policy { Policy::Balanced };
+    std::atomic<float> pressure { 0.0f };
+    std::atomic<juce::uint32> lastPlayingMs { 0 };
+    std::atomic<juce::uint32> lastOverrunMs { 0 };
+    std::atomic<bool> hasPlayed { false };
+    std::atomic<bool> hasOverrun { false };
+    std::atomic<juce::uint32> lastOfflineMs { 0 };
+    std::atomic<bool> hasRenderedOffline { false };
+    std::atomic<int> numOfflineRenderers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeLoadGovernor)
+};
+
+} // namespace VoxScript
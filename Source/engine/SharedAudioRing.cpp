@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+    SharedAudioRing.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "SharedAudioRing.h"
+#include <algorithm>
+#include <cstring>
+
+namespace VoxScript
+{
+
+SharedAudioRing::SharedAudioRing (const juce::File& ringFile, std::unique_ptr<juce::MemoryMappedFile> mapping, bool ownsFile)
+    : file (ringFile), mappedFile (std::move (mapping)), isOwner (ownsFile)
+{
+    auto* header = static_cast<Header*> (mappedFile->getData());
+    capacity = static_cast<size_t> (header->capacity);
+    samples = reinterpret_cast<float*> (static_cast<char*> (mappedFile->getData()) + sizeof (Header));
+}
+
+SharedAudioRing::~SharedAudioRing()
+{
+    mappedFile.reset();
+
+    if (isOwner)
+        file.deleteFile();
+}
+
+std::unique_ptr<SharedAudioRing> SharedAudioRing::create (size_t capacitySamples)
+{
+    if (capacitySamples == 0)
+        return nullptr;
+
+    auto ringFile = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                        .getChildFile ("VoxScript")
+                        .getNonexistentChildFile ("audio-ring", ".bin", false);
+
+    if (!ringFile.getParentDirectory().createDirectory())
+        return nullptr;
+
+    const auto totalBytes = static_cast<juce::int64> (sizeof (Header) + capacitySamples * sizeof (float));
+
+    {
+        // Size the file without writing every byte; the pages are only touched when used
+        juce::FileOutputStream out (ringFile);
+        if (!out.openedOk() || !out.setPosition (totalBytes - 1) || !out.writeByte (0))
+        {
+            DBG ("SharedAudioRing: Could not create " + ringFile.getFullPathName());
+            ringFile.deleteFile();
+            return nullptr;
+        }
+    }
+
+    auto mapping = std::make_unique<juce::MemoryMappedFile> (ringFile, juce::MemoryMappedFile::readWrite, false);
+
+    if (mapping->getData() == nullptr || static_cast<juce::int64> (mapping->getSize()) < totalBytes)
+    {
+        DBG ("SharedAudioRing: Could not map " + ringFile.getFullPathName());
+        mapping.reset();
+        ringFile.deleteFile();
+        return nullptr;
+    }
+
+    auto* header = static_cast<Header*> (mapping->getData());
+    std::memcpy (header->magic, "VXAR", 4);
+    header->version = currentVersion;
+    header->capacity = static_cast<juce::uint64> (capacitySamples);
+
+    return std::unique_ptr<SharedAudioRing> (new SharedAudioRing (ringFile, std::move (mapping), true));
+}
+
+std::unique_ptr<SharedAudioRing> SharedAudioRing::open (const juce::File& ringFile)
+{
+    auto mapping = std::make_unique<juce::MemoryMappedFile> (ringFile, juce::MemoryMappedFile::readOnly, false);
+
+    if (mapping->getData() == nullptr || mapping->getSize() < sizeof (Header))
+        return nullptr;
+
+    const auto* header = static_cast<const Header*> (mapping->getData());
+
+    if (std::memcmp (header->magic, "VXAR", 4) != 0
+        || header->version != currentVersion
+        || mapping->getSize() < sizeof (Header) + header->capacity * sizeof (float))
+    {
+        DBG ("SharedAudioRing: " + ringFile.getFullPathName() + " is not a valid ring");
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedAudioRing> (new SharedAudioRing (ringFile, std::move (mapping), false));
+}
+
+juce::int64 SharedAudioRing::write (const float* source, size_t numSamples)
+{
+    jassert (isOwner);
+
+    if (numSamples == 0 || numSamples > getFreeSpace())
+        return -1;
+
+    const auto offset = writePosition;
+    const auto firstPart = std::min (numSamples, capacity - writePosition);
+
+    std::copy (source, source + firstPart, samples + writePosition);
+    std::copy (source + firstPart, source + numSamples, samples);
+
+    writePosition = (writePosition + numSamples) % capacity;
+    usedSamples += numSamples;
+
+    return static_cast<juce::int64> (offset);
+}
+
+void SharedAudioRing::release (size_t numSamples) noexcept
+{
+    jassert (numSamples <= usedSamples);
+    usedSamples -= std::min (numSamples, usedSamples);
+}
+
+void SharedAudioRing::reset() noexcept
+{
+    writePosition = 0;
+    usedSamples = 0;
+}
+
+void SharedAudioRing::read (size_t offset, size_t numSamples, float* destination) const
+{
+    jassert (offset < capacity && numSamples <= capacity);
+
+    const auto firstPart = std::min (numSamples, capacity - offset);
+
+    std::copy (samples + offset, samples + offset + firstPart, destination);
+    std::copy (samples, samples + (numSamples - firstPart), destination + firstPart);
+}
+
+} // namespace VoxScript
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+    SharedAudioRing.h
+
+    A ring buffer of 16 kHz mono samples in a memory-mapped file, shared
+    between the plugin and an out-of-process transcription worker. Audio is
+    passed through it instead of through the message pipe, so a long take
+    costs one copy in and one copy out rather than a serialised message.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <memory>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Single-producer, single-consumer sample ring over a mapped file.
+ *
+ * The plugin creates the ring and is the only writer; the worker opens it
+ * read-only. Positions are not stored in the mapping: the producer tells the
+ * consumer where each chunk is (TranscriptionWorkerProtocol::AudioChunk),
+ * and the consumer acknowledges it once copied out, after which the
+ * producer release()s the space. Chunks are released in the order written.
+ *
+ * Thread Safety:
+ * - Producer methods (write, release, reset, getFreeSpace) must be called
+ *   with external synchronisation; read() is only used by the consumer.
+ */
+class SharedAudioRing
+{
+public:
+    ~SharedAudioRing();
+
+    /** Create a ring for capacitySamples in the temp directory. nullptr on failure. */
+    static std::unique_ptr<SharedAudioRing> create (size_t capacitySamples);
+
+    /** Open a ring created by another process. nullptr if it isn't a valid ring. */
+    static std::unique_ptr<SharedAudioRing> open (const juce::File& ringFile);
+
+    const juce::File& getFile() const noexcept { return file; }
+    size_t getCapacity() const noexcept { return capacity; }
+    size_t getFreeSpace() const noexcept { return capacity - usedSamples; }
+
+    /**
+     * Producer: copy samples in at the write position (wrapping).
+     * @return Ring offset of the first sample, or -1 if there isn't room
+     */
+    juce::int64 write (const float* samples, size_t numSamples);
+
+    /** Producer: the consumer has copied out the oldest numSamples. */
+    void release (size_t numSamples) noexcept;
+
+    /** Producer: forget everything in flight (e.g. after the consumer died). */
+    void reset() noexcept;
+
+    /** Consumer: copy numSamples starting at a ring offset (wrapping). */
+    void read (size_t offset, size_t numSamples, float* destination) const;
+
+private:
+    SharedAudioRing (const juce::File& ringFile, std::unique_ptr<juce::MemoryMappedFile> mapping, bool ownsFile);
+
+    struct Header
+    {
+        char magic[4];
+        juce::uint32 version;
+        juce::uint64 capacity;
+    };
+
+    static constexpr juce::uint32 currentVersion = 1;
+
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    float* samples = nullptr;
+    size_t capacity = 0;
+    bool isOwner = false;
+
+    // Producer bookkeeping
+    size_t writePosition = 0;
+    size_t usedSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedAudioRing)
+};
+
+} // namespace VoxScript
@@ -10,14 +10,42 @@
 
 #include "TranscriptionJobQueue.h"
 #include "../transcription/WhisperEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
 
 namespace VoxScript
 {
 
+//==============================================================================
+/** A worker thread; the work itself is TranscriptionJobQueue::runWorker(). */
+class TranscriptionJobQueue::Worker : public juce::Thread
+{
+public:
+    Worker(TranscriptionJobQueue& queueToServe, size_t indexInPool)
+        : juce::Thread("TranscriptionWorker " + juce::String((int) indexInPool + 1)),
+          owner(queueToServe), index(indexInPool)
+    {
+    }
+
+    void run() override
+    {
+        owner.runWorker(index, *this);
+    }
+
+private:
+    TranscriptionJobQueue& owner;
+    const size_t index;
+};
+
+//==============================================================================
 TranscriptionJobQueue::TranscriptionJobQueue()
-    : juce::Thread("TranscriptionWorker")
 {
     aliveFlag = std::make_shared<std::atomic<bool>>(true);
+    requestedNumWorkers = juce::SystemStats::getEnvironmentVariable("VOXSCRIPT_TRANSCRIPTION_WORKERS", {}).getIntValue();
 }
 
 TranscriptionJobQueue::~TranscriptionJobQueue()
@@ -26,7 +54,8 @@ TranscriptionJobQueue::~TranscriptionJobQueue()
         aliveFlag->store(false);
 
     // Requirement 1: Shutdown sequence
-    signalThreadShouldExit();
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
 
     {
         std::lock_guard<std::mutex> lock(queueMutex);
@@ -35,13 +64,45 @@ TranscriptionJobQueue::~TranscriptionJobQueue()
 
     cancelAll();
     queueCV.notify_all();
-    stopThread(4000);
+
+    for (auto& worker : workers)
+        worker->stopThread(4000);
 }
 
 void TranscriptionJobQueue::initialise(VoxScriptDocumentStore* store)
 {
     documentStore = store;
-    startThread();
+
+    if (!workers.empty())
+        return;
+
+    const int numWorkers = requestedNumWorkers > 0 ? requestedNumWorkers : getDefaultNumWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queues.resize((size_t) numWorkers);
+    }
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.push_back(std::make_unique<Worker>(*this, (size_t) i));
+
+    DBG ("TranscriptionJobQueue: Starting " + juce::String(numWorkers) + " worker(s)");
+
+    for (auto& worker : workers)
+        worker->startThread();
+}
+
+void TranscriptionJobQueue::setNumWorkers(int numWorkers)
+{
+    jassert(workers.empty()); // Takes effect in initialise()
+    requestedNumWorkers = juce::jlimit(0, 16, numWorkers);
+}
+
+int TranscriptionJobQueue::getDefaultNumWorkers()
+{
+    // A few workers with several whisper threads each beat many single-threaded
+    // ones: every worker holds its own state and audio.
+    return juce::jlimit(1, 4, juce::SystemStats::getNumPhysicalCpus() / 4);
 }
 
 void TranscriptionJobQueue::setCompletionCallback(std::function<void(AudioSourceID)> callback)
@@ -49,128 +110,1104 @@ void TranscriptionJobQueue::setCompletionCallback(std::function<void(AudioSource
     completionCallback = callback;
 }
 
+void TranscriptionJobQueue::setModelIdleTimeout(juce::RelativeTime timeout)
+{
+    idleTimeoutMs.store(timeout.inMilliseconds());
+    queueCV.notify_all(); // Re-evaluate the current wait
+}
+
 void TranscriptionJobQueue::enqueueTranscription(const TranscriptionJob& job)
 {
     // Requirement 3: Check exit flags
-    if (threadShouldExit())
+    if (stopRequested)
         return;
 
     {
         std::lock_guard<std::mutex> lock(queueMutex);
         
-        if (stopRequested)
+        if (stopRequested || queues.empty())
             return;
 
-        // Remove existing pending jobs for this source
-        for (auto it = jobQueue.begin(); it != jobQueue.end(); )
+        TranscriptionJob queued = job;
+        queued.enqueuedAtMs = juce::Time::getMillisecondCounter();
+
+        // The job's audio file is the content the source has now
+        if (spectrogramService != nullptr)
+            queued.spectrogramGeneration = spectrogramService->getGeneration(job.sourceID);
+        markQueued(queued);
+
+        // Ranges a waiting job was asked for are not lost by replacing it
+        for (const auto& queue : queues)
         {
-            if (it->sourceID == job.sourceID)
-                it = jobQueue.erase(it);
-            else
-                ++it;
+            for (const auto& pending : queue.jobs)
+            {
+                if (pending.sourceID != job.sourceID || pending.background)
+                    continue;
+
+                // The waiting job has newer audio than any worker holds
+                if (!pending.redecode)
+                    queued.redecode = false;
+
+                if (pending.sourceRanges.isEmpty() || queued.sourceRanges.isEmpty())
+                {
+                    queued.sourceRanges.clear();
+                    queued.deferredRanges.clear();
+                }
+                else
+                {
+                    auto ranges = queued.sourceRanges;
+                    ranges.addArray(pending.sourceRanges);
+                    queued.sourceRanges = SourceRanges::normalise(ranges);
+                    queued.deferredRanges = SourceRanges::subtract(queued.deferredRanges, queued.sourceRanges);
+                }
+            }
         }
+
+        // Remove existing pending jobs for this source (including a stale refinement)
+        removePendingJobsLocked(job.sourceID);
         
-        jobQueue.push_back(job);
+        queues[chooseWorkerLocked(queued)].jobs.push_back(queued);
+
+        // Under queueMutex, so it can't overtake finishJob() marking the source finished
+        journal->sourceQueued(job.persistentID);
     }
-    queueCV.notify_one();
+    queueCV.notify_all();
+}
+
+bool TranscriptionJobQueue::hasPendingJob(AudioSourceID sourceID, const SourceRanges::RangeList& sourceRanges)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    auto isForSource = [&] (const TranscriptionJob& job)
+    {
+        if (job.sourceID != sourceID || job.background)
+            return false;
+
+        if (job.sourceRanges.isEmpty())
+            return true;
+
+        return !sourceRanges.isEmpty() && SourceRanges::covers(job.sourceRanges, sourceRanges);
+    };
+
+    return std::any_of(queues.begin(), queues.end(), [&] (const WorkerQueue& queue)
+    {
+        return std::any_of(queue.jobs.begin(), queue.jobs.end(), isForSource)
+            || std::any_of(queue.refineJobs.begin(), queue.refineJobs.end(), isForSource);
+    });
+}
+
+void TranscriptionJobQueue::setFocus(const TranscriptionFocus& newFocus)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    focus = newFocus;
+}
+
+void TranscriptionJobQueue::setSourcePlacement(AudioSourceID sourceID, const juce::Array<juce::Range<double>>& playbackRanges)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    if (playbackRanges.isEmpty())
+        sourcePlacements.erase(sourceID);
+    else
+        sourcePlacements[sourceID] = playbackRanges;
 }
 
 void TranscriptionJobQueue::cancelAll()
 {
+    std::deque<TranscriptionJob> discarded;
     {
         std::lock_guard<std::mutex> lock(queueMutex);
-        jobQueue.clear();
+
+        for (auto& queue : queues)
+        {
+            discarded.insert(discarded.end(), queue.jobs.begin(), queue.jobs.end());
+            discarded.insert(discarded.end(), queue.refineJobs.begin(), queue.refineJobs.end());
+            queue.jobs.clear();
+            queue.refineJobs.clear();
+        }
+
+        for (const auto& running : runningSources)
+            cancelledRunningSources.insert(running.first);
+
+        abortCancelledWorkersLocked();
     }
     
-    // Note: WhisperEngine ownership is now local to the worker thread.
-    // We cannot call cancelTranscription() directly.
-    // Clearing the queue prevents future jobs. 
-    // To stop the current job, we rely on the thread stopping.
+    discardJobs(discarded);
 }
 
 void TranscriptionJobQueue::cancelForAudioSource(AudioSourceID sourceID)
 {
     std::lock_guard<std::mutex> lock(queueMutex);
     
-    for (auto it = jobQueue.begin(); it != jobQueue.end(); )
+    removePendingJobsLocked(sourceID);
+    sourcePlacements.erase(sourceID);
+
+    // The running job must not publish or schedule a refinement; its pass
+    // stops early unless a batch still needs it for other sources
+    if (runningSources.find(sourceID) != runningSources.end())
     {
-        if (it->sourceID == sourceID)
-            it = jobQueue.erase(it);
-        else
-            ++it;
+        cancelledRunningSources.insert(sourceID);
+        abortCancelledWorkersLocked();
+    }
+}
+
+bool TranscriptionJobQueue::isWorkerCancelledLocked(size_t workerIndex) const
+{
+    bool anyRunning = false;
+
+    for (const auto& [sourceID, index] : runningSources)
+    {
+        if (index != workerIndex)
+            continue;
+
+        if (cancelledRunningSources.count(sourceID) == 0)
+            return false;
+
+        anyRunning = true;
+    }
+
+    return anyRunning;
+}
+
+void TranscriptionJobQueue::abortCancelledWorkersLocked()
+{
+    for (size_t i = 0; i < queues.size(); ++i)
+        if (queues[i].engine != nullptr && isWorkerCancelledLocked(i))
+            queues[i].engine->cancelTranscription(); // Only sets a flag whisper polls
+}
+
+void TranscriptionJobQueue::removePendingJobsLocked(AudioSourceID sourceID)
+{
+    std::deque<TranscriptionJob> discarded;
+
+    for (auto& workerQueue : queues)
+    for (auto* queue : { &workerQueue.jobs, &workerQueue.refineJobs })
+    {
+        for (auto it = queue->begin(); it != queue->end(); )
+        {
+            if (it->sourceID == sourceID)
+            {
+                discarded.push_back(*it);
+                it = queue->erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    discardJobs(discarded);
+}
+
+void TranscriptionJobQueue::discardJobs(std::deque<TranscriptionJob>& jobs)
+{
+    // Pending jobs own their temp WAV; drop it with the job.
+    for (auto& job : jobs)
+        if (job.audioFile.existsAsFile())
+            job.audioFile.deleteFile();
+
+    jobs.clear();
+}
+
+bool TranscriptionJobQueue::streamsSegments(const TranscriptionJob& job) const
+{
+    // First results of a whole source only; refinements and ranged passes edit a published transcript
+    return documentStore != nullptr
+        && job.pass != TranscriptionJob::Pass::Refine
+        && !job.background
+        && job.sourceRanges.isEmpty();
+}
+
+void TranscriptionJobQueue::publishResult(const TranscriptionJob& job, const VoxSequence& result)
+{
+    auto alive = aliveFlag;
+    auto* storePtr = documentStore;
+    auto cb = completionCallback;
+    auto id = job.sourceID;
+    auto pass = job.pass;
+    auto ranges = job.sourceRanges;
+    auto res = result;
+    auto* metricsPtr = &metrics;
+    auto trace = job.trace;
+    const auto publishStartMs = TranscriptionTrace::now();
+
+    juce::MessageManager::callAsync([alive, storePtr, cb, id, pass, ranges, res, metricsPtr, trace, publishStartMs]() mutable
+    {
+        if (!alive || !alive->load())
+            return;
+
+        bool changed = true;
+
+        if (storePtr)
+        {
+            if (pass == TranscriptionJob::Pass::Refine)
+                changed = storePtr->applyRefinedTranscription(id, res, ranges) > 0;
+            else if (!ranges.isEmpty())
+                storePtr->mergeTranscription(id, res, ranges, pass == TranscriptionJob::Pass::Draft);
+            else
+                storePtr->updateTranscription(id, res, pass == TranscriptionJob::Pass::Draft);
+        }
+
+        // The job is complete once the store has the result
+        trace.addUntilNow(TranscriptionStage::Publication, publishStartMs);
+        metricsPtr->record(trace);
+            
+        if (cb && changed)
+            cb(id);
+    });
+}
+
+size_t TranscriptionJobQueue::chooseWorkerLocked(const TranscriptionJob& job) const
+{
+    // Same source: behind its running job, so results arrive in order
+    auto running = runningSources.find(job.sourceID);
+    if (running != runningSources.end())
+        return running->second;
+
+    // A language change goes to the worker that still holds the source's audio
+    if (job.redecode)
+        for (size_t i = 0; i < queues.size(); ++i)
+            if (queues[i].heldSourceID == job.sourceID)
+                return i;
+
+    auto isBusy = [this] (size_t index)
+    {
+        return std::any_of(runningSources.begin(), runningSources.end(),
+                           [index] (const auto& entry) { return entry.second == index; });
+    };
+
+    // Otherwise the least loaded worker, preferring one that has the model
+    // loaded and isn't busy (no model switch, no waiting)
+    size_t best = 0;
+    auto score = [&] (size_t index)
+    {
+        const auto& queue = queues[index];
+        int cost = (int) queue.jobs.size() * 4 + (isBusy(index) ? 2 : 0);
+
+        if (queue.loadedModelId != WhisperModelCatalogue::resolve(job.modelId).id)
+            cost += 1;
+
+        return cost;
+    };
+
+    for (size_t i = 1; i < queues.size(); ++i)
+        if (score(i) < score(best))
+            best = i;
+
+    return best;
+}
+
+bool TranscriptionJobQueue::canStartLocked(const TranscriptionJob& job)
+{
+    // One job per source at a time keeps its results in order
+    if (runningSources.find(job.sourceID) != runningSources.end())
+        return false;
+
+    // The first job always runs; others only if the budget has room for them too
+    if (runningSources.empty())
+        return true;
+
+    // Reclaiming frees caches and models, far too slow to do under queueMutex
+    const auto needed = runningJobBytes + estimateJobBytes(job);
+
+    if (memoryBudget->hasHeadroom(needed))
+        return true;
+
+    headroomWanted = juce::jmax(headroomWanted, needed);
+    return false;
+}
+
+juce::int64 TranscriptionJobQueue::takeReclaimRequestLocked()
+{
+    const auto wanted = std::exchange(headroomWanted, (juce::int64) 0);
+
+    if (wanted <= 0 || (wanted <= lastReclaimBytes && memoryBudget->getTotalUsage() == lastReclaimUsage))
+        return 0;
+
+    lastReclaimBytes = wanted;
+    return wanted;
+}
+
+juce::int64 TranscriptionJobQueue::estimateJobBytes(const TranscriptionJob& job)
+{
+    // whisper_state compute buffers scale with the model; audio, spectrogram
+    // and decode buffers with the length (about 12 bytes per 16 kHz sample).
+    const auto info = WhisperModelCatalogue::resolve(job.modelId);
+    const auto stateBytes = (juce::int64) info.memoryMB * 1024 * 1024 / 2;
+    const auto audioBytes = (juce::int64) (job.durationSeconds * 16000.0 * 12.0);
+
+    return stateBytes + audioBytes;
+}
+
+float TranscriptionJobQueue::getPriorityLocked(const TranscriptionJob& job) const
+{
+    float priority = 0.0f;
+
+    if (focus.selectedSources.count(job.sourceID) > 0)
+        priority += selectedWeight;
+
+    if (focus.hiddenSources.count(job.sourceID) == 0)
+        priority += visibleWeight;
+
+    // Regions close to the playhead are heard (and looked at) next
+    const double playhead = playheadSeconds.load();
+    auto placement = sourcePlacements.find(job.sourceID);
+
+    if (playhead >= 0.0 && placement != sourcePlacements.end())
+    {
+        double distance = std::numeric_limits<double>::max();
+
+        for (const auto& range : placement->second)
+        {
+            if (range.contains(playhead))
+                distance = 0.0;
+            else if (range.getStart() > playhead)
+                distance = juce::jmin(distance, range.getStart() - playhead);
+            else
+                distance = juce::jmin(distance, 2.0 * (playhead - range.getEnd())); // Already played: half as relevant
+        }
+
+        priority += playheadWeight * (float) std::exp(-distance / playheadFalloffSeconds);
+    }
+
+    const auto ageMs = juce::Time::getMillisecondCounter() - job.enqueuedAtMs;
+    priority += recencyWeight * (float) std::exp(-(double) ageMs / (recencyFalloffSeconds * 1000.0));
+
+    return priority;
+}
+
+std::vector<TranscriptionJob> TranscriptionJobQueue::takeNextBatchLocked(size_t workerIndex)
+{
+    std::vector<TranscriptionJob> batch;
+    std::deque<TranscriptionJob>* source = nullptr;
+    std::deque<TranscriptionJob>::iterator chosen;
+
+    struct Candidate
+    {
+        float priority;
+        std::deque<TranscriptionJob>* deque;
+        std::deque<TranscriptionJob>::iterator job;
+    };
+
+    // New work first; refinements only run when no new work can start anywhere
+    for (auto member : { &WorkerQueue::jobs, &WorkerQueue::refineJobs })
+    {
+        std::vector<Candidate> candidates;
+
+        // Own deque first, so ties keep affinity and order
+        for (size_t offset = 0; offset < queues.size(); ++offset)
+        {
+            auto& deque = queues[(workerIndex + offset) % queues.size()].*member;
+
+            for (auto it = deque.begin(); it != deque.end(); ++it)
+                if (runningSources.find(it->sourceID) == runningSources.end())
+                    candidates.push_back({ getPriorityLocked(*it), &deque, it });
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [] (const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+
+        // The most relevant job that also fits in memory
+        for (const auto& candidate : candidates)
+        {
+            if (canStartLocked(*candidate.job))
+            {
+                source = candidate.deque;
+                chosen = candidate.job;
+                break;
+            }
+        }
+
+        if (source != nullptr)
+            break;
     }
+
+    if (source == nullptr)
+        return batch;
+
+    batch.push_back(*chosen);
+    source->erase(chosen);
+
+    auto isShort = [] (const TranscriptionJob& job)
+    {
+        return job.durationSeconds > 0.0 && job.durationSeconds <= maxBatchedClipSeconds
+               && job.sourceRanges.isEmpty() && !job.redecode;
+    };
+
+    // Worker processes take one source per job
+    if (isShort(batch.front()) && !workerPool.isAvailable())
+    {
+        // Fill one encoder window with more short takes for the same model and pass
+        double totalSeconds = batch.front().durationSeconds;
+
+        for (auto it = source->begin(); it != source->end(); )
+        {
+            // One pass decodes one language
+            const bool compatible = isShort(*it)
+                                    && !needsLanguageDetection(*it)
+                                    && !needsLanguageDetection(batch.front())
+                                    && it->modelId == batch.front().modelId
+                                    && it->language == batch.front().language
+                                    && it->pass == batch.front().pass
+                                    && runningSources.find(it->sourceID) == runningSources.end();
+
+            if (compatible && WhisperEngine::getPackedBatchSeconds(totalSeconds + it->durationSeconds, (int) batch.size() + 1)
+                                  <= WhisperEngine::maxBatchSeconds)
+            {
+                totalSeconds += it->durationSeconds;
+                batch.push_back(*it);
+                it = source->erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto& job : batch)
+    {
+        runningSources[job.sourceID] = workerIndex;
+        cancelledRunningSources.erase(job.sourceID);
+        runningJobBytes += estimateJobBytes(job);
+    }
+
+    queues[workerIndex].loadedModelId = WhisperModelCatalogue::resolve(batch.front().modelId).id;
+    return batch;
+}
+
+bool TranscriptionJobQueue::needsLanguageDetection(const TranscriptionJob& job)
+{
+    if (job.language.isNotEmpty())
+        return false;
+
+    auto info = WhisperModelCatalogue::findModel(job.modelId.isNotEmpty() ? job.modelId
+                                                                          : juce::String(WhisperModelCatalogue::defaultModelId));
+    return info.isValid() && !info.englishOnly;
+}
+
+void TranscriptionJobQueue::publishLanguage(AudioSourceID sourceID, const juce::String& language)
+{
+    auto alive = aliveFlag;
+    auto* storePtr = documentStore;
+
+    juce::MessageManager::callAsync([alive, storePtr, sourceID, language]()
+    {
+        if (alive && alive->load() && storePtr)
+            storePtr->setSourceLanguage(sourceID, language);
+    });
+}
+
+void TranscriptionJobQueue::publishSpectrogram(AudioSourceID sourceID)
+{
+    auto alive = aliveFlag;
+    auto cb = completionCallback;
+
+    juce::MessageManager::callAsync([alive, cb, sourceID]()
+    {
+        if (alive && alive->load() && cb)
+            cb(sourceID);
+    });
+}
+
+TranscriptionCacheKey TranscriptionJobQueue::makeCacheKey(const TranscriptionJob& job, const juce::String& contentHash,
+                                                          const WhisperEngine& engine, bool batched) const
+{
+    TranscriptionCacheKey key;
+    key.contentHash = contentHash;
+    key.modelId = WhisperModelCatalogue::resolve(job.modelId).id;
+    key.decodeSignature = engine.getDecodeSignature(batched);
+
+    if (!job.sourceRanges.isEmpty())
+        key.decodeSignature << " ranges=" << SourceRanges::toString(job.sourceRanges);
+
+    return key;
+}
+
+bool TranscriptionJobQueue::shouldPreempt(const TranscriptionJob& running)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    if (stopRequested)
+        return false;
+
+    // An idle worker will pick up anything pending anyway
+    std::set<size_t> busyWorkers;
+    for (const auto& entry : runningSources)
+        busyWorkers.insert(entry.second);
+
+    if (busyWorkers.size() < workers.size())
+        return false;
+
+    // Background passes give way to any new work
+    const float runningPriority = running.pass == TranscriptionJob::Pass::Refine || running.background
+                                      ? -std::numeric_limits<float>::max()
+                                      : getPriorityLocked(running) + preemptionMargin;
+
+    for (const auto& queue : queues)
+        for (const auto& job : queue.jobs)
+            if (runningSources.find(job.sourceID) == runningSources.end() && getPriorityLocked(job) > runningPriority)
+                return true;
+
+    return false;
+}
+
+void TranscriptionJobQueue::markQueued(TranscriptionJob& job)
+{
+    static const char* passNames[] = { "single", "draft", "refine" };
+
+    job.trace.sourceID = job.sourceID;
+    job.trace.label = juce::String(passNames[static_cast<int>(job.pass)])
+                    + (job.background ? " (background) " : " ")
+                    + WhisperModelCatalogue::resolve(job.modelId).id;
+    job.trace.queuedAtMs = TranscriptionTrace::now();
+}
+
+bool TranscriptionJobQueue::mayRunWorker(size_t workerIndex) const noexcept
+{
+    switch (loadGovernor.getThrottle())
+    {
+        case RealtimeLoadGovernor::Throttle::Paused:    return false;
+        case RealtimeLoadGovernor::Throttle::Reduced:   return workerIndex == 0;
+        case RealtimeLoadGovernor::Throttle::Full:
+        default:                                        return true;
+    }
+}
+
+void TranscriptionJobQueue::requeuePreempted(size_t workerIndex, TranscriptionJob job,
+                                             std::shared_ptr<const TranscriptStitcher::Progress> progress)
+{
+    bool keep = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        const bool cancelled = cancelledRunningSources.erase(job.sourceID) > 0;
+        runningSources.erase(job.sourceID);
+        runningJobBytes = juce::jmax((juce::int64) 0, runningJobBytes - estimateJobBytes(job));
+
+        // A newer request for the source replaces it anyway
+        const bool superseded = std::any_of(queues.begin(), queues.end(), [&] (const WorkerQueue& queue)
+        {
+            return std::any_of(queue.jobs.begin(), queue.jobs.end(),
+                               [&] (const TranscriptionJob& j) { return j.sourceID == job.sourceID; });
+        });
+
+        keep = !cancelled && !superseded && !stopRequested;
+
+        if (keep)
+        {
+            job.resumeFrom = std::move(progress);
+            markQueued(job);
+            auto& deque = job.pass == TranscriptionJob::Pass::Refine || job.background ? queues[workerIndex].refineJobs
+                                                                    : queues[workerIndex].jobs;
+            deque.push_front(job);
+        }
+    }
+
+    if (!keep)
+        job.audioFile.deleteFile();
+
+    queueCV.notify_all();
+}
+
+void TranscriptionJobQueue::finishJob(size_t workerIndex, const TranscriptionJob& job, const VoxSequence& result)
+{
+    // Follow-up work on the same audio file: the refinement, then the deferred ranges
+    std::optional<TranscriptionJob> followUp;
+
+    // A draft that failed or found no speech has nothing to refine
+    if (job.pass == TranscriptionJob::Pass::Draft && job.refineModelId.isNotEmpty() && result.getWordCount() > 0)
+    {
+        followUp = job;
+        followUp->pass = TranscriptionJob::Pass::Refine;
+        followUp->modelId = job.refineModelId;
+        followUp->refineModelId = {};
+    }
+    else if (!job.deferredRanges.isEmpty())
+    {
+        followUp = job;
+        followUp->pass = TranscriptionJob::Pass::Single;
+        followUp->sourceRanges = job.deferredRanges;
+        followUp->deferredRanges = {};
+        followUp->background = true;
+    }
+
+    if (followUp.has_value())
+    {
+        followUp->resumeFrom = nullptr;
+        followUp->trace = {};
+        markQueued(*followUp);
+    }
+
+    // Cleanup temp file, unless a follow-up pass still needs it
+    if (!followUp.has_value() || stopRequested)
+        job.audioFile.deleteFile();
+
+    bool cancelled = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        cancelled = cancelledRunningSources.erase(job.sourceID) > 0;
+        runningSources.erase(job.sourceID);
+        runningJobBytes = juce::jmax((juce::int64) 0, runningJobBytes - estimateJobBytes(job));
+    }
+
+    // Shutting down (or the source going away with the project) leaves the
+    // journal as it is, so the work resumes when the project is reopened
+    const bool interrupted = cancelled || stopRequested || !aliveFlag->load();
+
+    if (!interrupted)
+        journal->jobFinished(job.journalKey); // Its result is in the cache now (or it failed)
+
+    // The source (and memory) is free again: waiting jobs may be able to start
+    queueCV.notify_all();
     
-    // Note: We don't cancel valid running jobs for specific ID easily here,
-    // but clearing the queue prevents future work.
+    // Post result if valid and not cancelled (empty result usually means failed/cancelled)
+    if (result.getWordCount() > 0 && !stopRequested && !cancelled)
+    {
+        publishResult(job, result);
+    }
+    else if (!stopRequested)
+    {
+        if (documentStore != nullptr)
+            documentStore->discardStreamedTranscription(job.sourceID); // Nothing will replace what was streamed
+
+        if (!cancelled)
+            metrics.record(job.trace);
+    }
+
+    if (followUp.has_value() && job.audioFile.existsAsFile())
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        // A newer request for this source may have arrived while we were busy;
+        // in that case it will produce its own follow-ups.
+        const bool superseded = std::any_of(queues.begin(), queues.end(), [&] (const WorkerQueue& queue)
+        {
+            return std::any_of(queue.jobs.begin(), queue.jobs.end(),
+                               [&] (const TranscriptionJob& j) { return j.sourceID == followUp->sourceID; });
+        });
+
+        // Both kinds only run when no new work is pending
+        if (superseded || cancelled || stopRequested)
+            followUp->audioFile.deleteFile();
+        else
+            queues[workerIndex].refineJobs.push_back(*followUp);
+    }
+
+    if (!interrupted && job.persistentID.isNotEmpty())
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        const bool outstanding = runningSources.count(job.sourceID) > 0
+            || std::any_of(queues.begin(), queues.end(), [&] (const WorkerQueue& queue)
+            {
+                auto isForSource = [&] (const TranscriptionJob& j) { return j.sourceID == job.sourceID; };
+                return std::any_of(queue.jobs.begin(), queue.jobs.end(), isForSource)
+                    || std::any_of(queue.refineJobs.begin(), queue.refineJobs.end(), isForSource);
+            });
+
+        if (!outstanding)
+            journal->sourceFinished(job.persistentID);
+    }
 }
 
-void TranscriptionJobQueue::run()
+void TranscriptionJobQueue::runWorker(size_t workerIndex, juce::Thread& thread)
 {
     // Requirement 2: Initialize WhisperEngine once when thread starts
+    // Each worker has its own engine (whisper_state); the model itself is shared
     auto whisper = std::make_unique<WhisperEngine>();
+    whisper->setSpectrogramService(spectrogramService);
+    const int numThreads = juce::jlimit(1, 8, juce::SystemStats::getNumPhysicalCpus() / juce::jmax(1, (int) workers.size()));
+    whisper->setNumThreads(numThreads);
+    juce::SharedResourcePointer<WhisperModelCache> modelCache;
+
+    // Fingerprint of the audio the engine holds for redecode()
+    juce::String heldContentHash;
 
-    while (!threadShouldExit())
     {
-        TranscriptionJob currentJob;
-        bool hasJob = false;
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queues[workerIndex].engine = whisper.get();
+    }
+
+    auto shouldExit = [this, &thread] { return thread.threadShouldExit() || stopRequested; };
+
+    // For the work between engine calls (worker pool, cache); the engine
+    // itself stays cancelled until the next batch is taken
+    auto isCancelled = [this, workerIndex]
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return isWorkerCancelledLocked(workerIndex);
+    };
+
+    while (!shouldExit())
+    {
+        std::vector<TranscriptionJob> batch;
         
         {
             std::unique_lock<std::mutex> lock(queueMutex);
-            queueCV.wait(lock, [this] { return stopRequested || !jobQueue.empty(); });
-            
-            // Requirement 2: Check immediately after waking
-            if (threadShouldExit() || stopRequested)
-                break;
-                
-            if (!jobQueue.empty())
+            auto hasWork = [&]
             {
-                currentJob = jobQueue.front();
-                jobQueue.pop_front();
-                hasJob = true;
+                if (stopRequested)
+                    return true;
+
+                // Realtime playback needs the machine; polled, so work resumes on its own
+                if (!mayRunWorker(workerIndex))
+                    return false;
+
+                batch = takeNextBatchLocked(workerIndex);
+
+                // Under queueMutex, like abortCancelledWorkersLocked(): a
+                // cancel for this batch comes after this and sticks
+                if (!batch.empty())
+                    whisper->resetCancellation();
+
+                return !batch.empty();
+            };
+
+            const auto idleTimeout = idleTimeoutMs.load();
+            const auto idleSince = juce::Time::getMillisecondCounter();
+            bool idle = false;
+
+            // Polled rather than only notified: a job held back by the memory
+            // budget may fit once another process frees memory
+            while (!hasWork() && !thread.threadShouldExit())
+            {
+                // A job held back by the memory budget: ask the reclaimers, outside the lock
+                if (const auto bytes = takeReclaimRequestLocked(); bytes > 0)
+                {
+                    lock.unlock();
+                    const bool fits = memoryBudget->requestHeadroom(bytes);
+                    lock.lock();
+                    lastReclaimUsage = memoryBudget->getTotalUsage();
+
+                    if (fits)
+                        continue;
+                }
+
+                queueCV.wait_for(lock, std::chrono::milliseconds(500));
+
+                // Idle unloading: once everything has drained, give the memory back
+                // (held back by the load governor isn't idle; the work resumes after it)
+                if (whisper->hasLoadedModel() && idleTimeout > 0 && mayRunWorker(workerIndex)
+                    && juce::Time::getMillisecondCounter() - idleSince >= (juce::uint32) idleTimeout)
+                {
+                    idle = true;
+                    break;
+                }
+            }
+
+            if (idle)
+            {
+                queues[workerIndex].loadedModelId = {};
+                lock.unlock();
+                DBG ("TranscriptionJobQueue: Idle, releasing model");
+                whisper->releaseModel();
+                modelCache->releaseIdleModels(juce::RelativeTime::milliseconds(idleTimeout));
+                continue;
             }
         }
         
         // Requirement 2: Check before processing
-        if (threadShouldExit() || stopRequested)
+        if (shouldExit())
+        {
+            for (auto& job : batch)
+                finishJob(workerIndex, job, {});
             break;
+        }
         
-        if (hasJob && !threadShouldExit() && whisper != nullptr)
+        if (batch.empty() || whisper == nullptr)
+            continue;
+
+        // A shrunk pool also uses fewer threads, leaving cores to the host
+        const bool reduced = loadGovernor.getThrottle() == RealtimeLoadGovernor::Throttle::Reduced;
+        whisper->setNumThreads(reduced ? juce::jmax(1, numThreads / 2) : numThreads);
+
+        // The wait ends here; the rest of each trace is the work itself
+        for (auto& job : batch)
         {
-            // Execute synchronous transcription
-            VoxSequence result;
-            
-            // ALWAYS process from file (safety)
-            if (currentJob.audioFile.existsAsFile())
-            {
-                 // Use local whisper instance
-                 result = whisper->processSync(currentJob.audioFile);
-                 
-                 // Cleanup temp file
-                 currentJob.audioFile.deleteFile();
+            if (job.trace.queuedAtMs > 0.0)
+                job.trace.addUntilNow(TranscriptionStage::QueueWait, job.trace.queuedAtMs);
+
+            job.trace.queuedAtMs = 0.0;
+        }
+
+        // Language change: only if this engine still holds the audio, else a full pass
+        if (batch.size() != 1 || !whisper->holdsAudioOf(batch.front().sourceID, batch.front().sourceRanges))
+            for (auto& job : batch)
+                job.redecode = false;
+
+        // Out-of-process: decode here (no model needed) and hand the samples over
+        // (a preempted job continues in-process, where its progress is; a
+        // language change where the audio already is)
+        const bool useWorkers = workerPool.isAvailable() && batch.size() == 1 && batch.front().resumeFrom == nullptr
+                                && !batch.front().redecode;
+        auto shouldAbort = [&] { return shouldExit() || isCancelled(); };
+        std::vector<float> pcm;
+
+        whisper->setTrace(&batch.front().trace);
+
+        if (useWorkers)
+            whisper->readPcm16k(batch.front().audioFile, pcm);
+
+        // The Detail View's spectrogram, once a job's result is out: no pass needs
+        // it (whisper_full computes its own mel), so it doesn't hold them up.
+        // From the samples above, or from what this batch's engine pass read.
+        bool engineReadBatch = false;
+
+        auto computeDetailSpectrogram = [&] (const TranscriptionJob& job)
+        {
+            if (spectrogramService == nullptr || spectrogramService->find(job.sourceID) != nullptr || isCancelled())
+                return;
+
+            if (!pcm.empty())
+                spectrogramService->getOrCompute(job.sourceID, pcm, job.spectrogramGeneration);
+            else if (engineReadBatch)
+                whisper->computeDetailSpectrogram(job.sourceID, job.spectrogramGeneration);
+
+            if (spectrogramService->find(job.sourceID) != nullptr)
+                publishSpectrogram(job.sourceID);
+        };
+
+        // Results for audio we have seen before come from the cache. A batch
+        // stays a batch even if only one job misses: its key says how it decodes.
+        const bool batched = batch.size() > 1;
+        std::vector<TranscriptionJob> misses;
+        std::vector<TranscriptionCacheKey> keys;
+        juce::String jobContentHash; // Of the only job, when not batched
+
+        for (auto& job : batch)
+        {
+            whisper->setTrace(&job.trace);
+
+            // Language: detected once per source, then carried by its jobs. Audio
+            // seen before remembers its language, so a cached result is found
+            // without running detection first.
+            // Hashed once per job file, from the samples decoded above if there are any
+            const auto* decoded = (&job == &batch.front() && !pcm.empty()) ? &pcm : nullptr;
+            const auto contentHash = job.audioFile.existsAsFile() ? resultCache->getFingerprint(job.audioFile, decoded)
+                                                                  : juce::String();
+            const auto modelId = WhisperModelCatalogue::resolve(job.modelId).id;
+            jobContentHash = contentHash;
+
+            // The held audio is this file's only if the content matches
+            if (job.redecode && (contentHash.isEmpty() || contentHash != heldContentHash))
+                job.redecode = false;
+
+            if (needsLanguageDetection(job))
+            {
+                job.language = resultCache->lookupLanguage(contentHash, modelId);
+
+                if (job.language.isEmpty())
+                {
+                    if (!pcm.empty())
+                    {
+                        if (auto detected = workerPool.detectLanguage(pcm, job.modelId, shouldAbort))
+                            job.language = *detected;
+                    }
+
+                    // In-process probe; on the samples already decoded above if there are any
+                    if (needsLanguageDetection(job) && !shouldAbort())
+                    {
+                        whisper->setModel(job.modelId);
+                        whisper->setSpectrogramGeneration(job.spectrogramGeneration);
+
+                        if (!pcm.empty())
+                            job.language = whisper->detectLanguage(pcm.data(), pcm.size(), job.sourceID);
+                        else if (job.audioFile.existsAsFile())
+                            job.language = whisper->detectLanguage(job.audioFile, job.sourceID);
+                    }
+
+                    resultCache->storeLanguage(contentHash, modelId, job.language);
+                }
+
+                if (job.language.isNotEmpty())
+                    publishLanguage(job.sourceID, job.language);
             }
-            
-            // Post result if valid and not cancelled (empty result usually means failed/cancelled)
-            if (result.getWordCount() > 0 && !threadShouldExit())
+
+            whisper->setLanguage(job.language);
+
+            auto key = contentHash.isNotEmpty() ? makeCacheKey(job, contentHash, *whisper, batched) : TranscriptionCacheKey();
+            job.journalKey = key.isValid() ? key.getFileName() : juce::String();
+
+            if (auto cached = resultCache->lookup(key))
             {
-                auto alive = aliveFlag;
-                auto* storePtr = documentStore;
-                auto cb = completionCallback;
-                auto id = currentJob.sourceID;
-                auto res = result;
+                DBG ("TranscriptionJobQueue: Cache hit for source " + juce::String(job.sourceID));
+                finishJob(workerIndex, job, *cached);
+
+                if (!pcm.empty())
+                    computeDetailSpectrogram(job);
+
+                continue;
+            }
+
+            misses.push_back(job);
+            keys.push_back(key);
+        }
 
-                juce::MessageManager::callAsync([alive, storePtr, cb, id, res]() mutable
+        whisper->setTrace(nullptr);
+        batch = std::move(misses);
+
+        if (batch.empty() || shouldExit() || isCancelled())
+        {
+            for (auto& job : batch)
+                finishJob(workerIndex, job, {});
+            continue;
+        }
+
+        // Use local whisper instance (switches model if the job asks for another one)
+        // Batched jobs share model and language
+        whisper->setModel(batch.front().modelId);
+        whisper->setLanguage(batch.front().language);
+
+        // Execute synchronous transcription
+        // ALWAYS process from file (safety)
+        std::vector<VoxSequence> results(batch.size());
+
+        if (!batched)
+        {
+            std::optional<VoxSequence> fromWorker;
+            VoxSequence redecoded;
+            bool ranInProcess = false;
+
+            // Decoder only, on the audio and encoder windows this engine kept
+            if (batch.front().redecode)
+            {
+                whisper->setTrace(&batch.front().trace);
+                redecoded = whisper->redecode(batch.front().language);
+                whisper->setTrace(nullptr);
+
+                if (redecoded.getNumSegments() == 0)
+                    batch.front().redecode = false; // Full pass below
+
+                ranInProcess = batch.front().redecode;
+                engineReadBatch = ranInProcess;
+            }
+
+            const auto& ranges = batch.front().sourceRanges;
+            const auto remoteStartMs = TranscriptionTrace::now();
+
+            if (!pcm.empty() && ranges.isEmpty())
+            {
+                fromWorker = workerPool.transcribe(pcm, batch.front().modelId, batch.front().language, shouldAbort);
+            }
+            else if (!pcm.empty())
+            {
+                std::vector<float> packed;
+                SourceRanges::pack(pcm, ranges, packed);
+
+                if (auto packedResult = workerPool.transcribe(packed, batch.front().modelId, batch.front().language, shouldAbort))
+                    fromWorker = SourceRanges::unpack(*packedResult, ranges);
+            }
+
+            if (!pcm.empty())
+                batch.front().trace.addUntilNow(TranscriptionStage::RemoteInference, remoteStartMs);
+
+            if (fromWorker.has_value())
+                results.front() = std::move(*fromWorker);
+            else if (batch.front().redecode)
+                results.front() = std::move(redecoded);
+            else if (batch.front().audioFile.existsAsFile() && !shouldExit() && !isCancelled())
+            {
+                // In-process fallback; long sources may give way to more relevant work
+                auto& job = batch.front();
+
+                // Windows done before the host went away, if this audio was interrupted
+                if (job.resumeFrom == nullptr && job.journalKey.isNotEmpty())
+                    job.resumeFrom = journal->findProgress(job.journalKey);
+
+                whisper->setTrace(&job.trace);
+                whisper->setResumeProgress(job.resumeFrom);
+
+                if (job.journalKey.isNotEmpty())
                 {
-                    if (!alive || !alive->load())
-                        return;
-
-                    if (storePtr)
-                        storePtr->updateTranscription(id, res);
-                        
-                    if (cb)
-                        cb(id);
-                });
+                    whisper->setCheckpointCallback([this, key = job.journalKey]
+                                                   (const TranscriptStitcher::Progress& progress)
+                    {
+                        journal->checkpoint(key, progress);
+                    });
+                }
+                whisper->setPreemptionCheck([this, &job, workerIndex] { return !mayRunWorker(workerIndex) || shouldPreempt(job); });
+
+                if (streamsSegments(job))
+                {
+                    // The stream starts with the first settled segment, so short sources never touch the store
+                    whisper->setSegmentCallback([store = documentStore, id = job.sourceID, streamID = (uint64_t) 0, refused = false]
+                                                (const VoxSegment& segment) mutable
+                    {
+                        if (streamID == 0 && !refused)
+                        {
+                            streamID = store->beginStreamedTranscription(id);
+                            refused = streamID == 0;
+                        }
+
+                        if (streamID != 0)
+                            store->appendStreamedSegment(id, streamID, segment);
+                    });
+                }
+
+                results.front() = whisper->processRanges(job.audioFile, job.sourceRanges, job.sourceID);
+                ranInProcess = true;
+                engineReadBatch = true;
+                whisper->setPreemptionCheck(nullptr);
+                whisper->setSegmentCallback(nullptr);
+                whisper->setCheckpointCallback(nullptr);
+                whisper->setTrace(nullptr);
+
+                if (auto progress = whisper->takePreemptedProgress())
+                {
+                    DBG ("TranscriptionJobQueue: Source " + juce::String(job.sourceID) + " preempted");
+                    requeuePreempted(workerIndex, job, std::move(progress));
+                    continue;
+                }
             }
+
+            // What a later language change of this source can re-decode here
+            // (after a worker process, the engine may hold older audio of it)
+            const bool holds = ranInProcess && whisper->holdsAudioOf(batch.front().sourceID, batch.front().sourceRanges);
+            heldContentHash = holds ? jobContentHash : juce::String();
+
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queues[workerIndex].heldSourceID = holds ? batch.front().sourceID : 0;
         }
+        else
+        {
+            DBG ("TranscriptionJobQueue: Batching " + juce::String((int) batch.size()) + " short sources");
+
+            std::vector<juce::File> files;
+            std::vector<AudioSourceID> sourceIDs;
+            for (const auto& job : batch)
+            {
+                files.push_back(job.audioFile);
+                sourceIDs.push_back(job.sourceID);
+            }
+
+            // One inference for all: every job's trace gets its spans
+            TranscriptionTrace shared;
+            whisper->setTrace(&shared);
+            results = whisper->processBatch(files, sourceIDs);
+            engineReadBatch = true;
+            whisper->setTrace(nullptr);
+
+            for (auto& job : batch)
+                job.trace.spans.insert(job.trace.spans.end(), shared.spans.begin(), shared.spans.end());
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            // A re-decode isn't what a full pass with this key produces
+            if (!batch[i].redecode)
+                resultCache->store(keys[i], results[i]);
+
+            finishJob(workerIndex, batch[i], results[i]);
+        }
+
+        for (const auto& job : batch)
+            computeDetailSpectrogram(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queues[workerIndex].engine = nullptr;
     }
     // WhisperEngine destroyed automatically as unique_ptr goes out of scope here
 }
@@ -2,8 +2,8 @@
   ==============================================================================
     TranscriptionJobQueue.h
     
-    Manages a single-threaded queue for background transcription jobs.
-    Ensures safe, serialized execution of Whisper inference and 
+    Manages a pool of worker threads for background transcription jobs.
+    Ensures safe, per-source serialized execution of Whisper inference and 
     reliable result publication to the DocumentStore.
     
     Part of VoxScript Mission 3: Isolate Whisper
@@ -19,20 +19,61 @@
 #include <memory>
 #include <atomic>
 #include "../ara/VoxScriptDocumentStore.h"
+#include "../transcription/TranscriptionResultCache.h"
+#include "../transcription/TranscriptStitcher.h"
+#include "../transcription/SourceRanges.h"
+#include "../transcription/TranscriptionTrace.h"
+#include "MelSpectrogramService.h"
+#include "RealtimeLoadGovernor.h"
+#include "TranscriptionJournal.h"
+#include "TranscriptionMetrics.h"
+#include "TranscriptionWorkerPool.h"
 #include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <map>
+#include <set>
+#include <vector>
 
 namespace VoxScript
 {
 
+class WhisperEngine;
+
 /**
  * @brief Represents a single transcription task
  */
 struct TranscriptionJob
 {
+    /**
+     * Progressive transcription: a Draft pass runs a fast model and publishes
+     * immediately, then a Refine pass re-runs the same audio with the
+     * accurate model and merges only what changed.
+     */
+    enum class Pass
+    {
+        Single, // One pass, result replaces the transcription
+        Draft,  // Fast pass, a Refine job follows with refineModelId
+        Refine  // Background pass, merged over the draft
+    };
+
     AudioSourceID sourceID;
     juce::File audioFile; // Independent file path
+    juce::String modelId; // WhisperModelCatalogue id (empty = default model)
+    Pass pass = Pass::Single;
+    juce::String refineModelId; // Model for the follow-up Refine pass (Draft only)
+    double durationSeconds = 0.0; // Audio length if known (0 = unknown, never batched)
+    juce::String language; // Detected language of the source (empty = not detected yet)
+    SourceRanges::RangeList sourceRanges;   // Parts of audioFile to transcribe, source seconds (empty = all)
+    SourceRanges::RangeList deferredRanges; // The rest, transcribed in the background afterwards
+    bool background = false; // Deferred ranges: runs only when nothing else is pending
+    juce::uint32 enqueuedAtMs = 0; // Set by the queue; recent edits are more relevant
+    std::shared_ptr<const TranscriptStitcher::Progress> resumeFrom; // Windows done before preemption
+    TranscriptionTrace trace; // Stage timestamps, filled in as the job runs
+    juce::String persistentID; // Host's persistent ID of the source, for the journal (empty = not journaled)
+    juce::String journalKey; // Result cache key file name, set by the worker once the audio is hashed
+    bool redecode = false; // Only the language changed: a worker still holding the audio just decodes it again
+    juce::uint64 spectrogramGeneration = 0; // Set by the queue: the source's MelSpectrogramService generation, for the Detail View
     
     // Equality operator for cancellation logic
     bool operator== (const TranscriptionJob& other) const
@@ -42,59 +83,336 @@ struct TranscriptionJob
 };
 
 /**
- * @brief Single-threaded job queue for Whisper transcription.
+ * @brief What the user is looking at in the host, for job priorities.
+ * Sources are identified by their AudioSourceID.
+ */
+struct TranscriptionFocus
+{
+    std::set<AudioSourceID> selectedSources; // Regions selected in the host
+    std::set<AudioSourceID> hiddenSources;   // Only on tracks hidden in the host's editor
+};
+
+/**
+ * @brief Job queue for Whisper transcription, run by a pool of worker threads.
  * 
  * Owned by VoxScriptDocumentController.
- * Consumes jobs from a thread-safe queue and executes them using WhisperEngine.
+ * Consumes jobs from thread-safe queues and executes them using WhisperEngine.
  * Publishes results to VoxScriptDocumentStore on the Message Thread.
+ *
+ * Each worker thread owns a WhisperEngine and a deque; jobs of one source
+ * never run concurrently and run in the order they were enqueued. Finished
+ * audio is answered from the TranscriptionResultCache, and unfinished work
+ * survives the session in the TranscriptionJournal.
  */
-class TranscriptionJobQueue : public juce::Thread
+class TranscriptionJobQueue
 {
 public:
     TranscriptionJobQueue();
-    ~TranscriptionJobQueue() override;
+    ~TranscriptionJobQueue();
 
+    /** Starts the worker threads. */
     void initialise(VoxScriptDocumentStore* store);
 
+    /**
+     * @brief Number of worker threads (call before initialise()).
+     * 0 picks getDefaultNumWorkers(); can also be set with
+     * VOXSCRIPT_TRANSCRIPTION_WORKERS. The workers share the physical cores
+     * between them for whisper's threads.
+     */
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const noexcept { return (int) workers.size(); }
+
+    /** One worker per four physical cores, at least one and at most four. */
+    static int getDefaultNumWorkers();
+
     /**
      * @brief Set callback to be invoked on the Message Thread when a transcription completes.
+     * Invoked again for the source once its spectrogram is computed, after the result.
      */
     void setCompletionCallback(std::function<void(AudioSourceID)> callback);
 
     /**
      * @brief Enqueue a transcription job for an audio source.
-     * Thread-safe.
+     * A job replacing a waiting one for the same source takes over that
+     * job's sourceRanges. Thread-safe.
      */
     void enqueueTranscription(const TranscriptionJob& job);
 
+    /**
+     * @brief True if a job for the source is waiting (not yet running) and will
+     * transcribe at least these ranges (empty = the whole source).
+     * Lets callers skip extraction for a request that would only replace it.
+     * Background jobs for deferred ranges don't count. Thread-safe.
+     */
+    bool hasPendingJob(AudioSourceID sourceID, const SourceRanges::RangeList& sourceRanges = {});
+
+    /**
+     * @brief How long a worker may sit idle before releasing its model.
+     * After all queues drain and this time passes, each worker frees its
+     * whisper state and asks the shared model cache to drop models nobody
+     * uses. Default 2 minutes; zero disables idle unloading.
+     */
+    void setModelIdleTimeout(juce::RelativeTime timeout);
+
+    /**
+     * @brief Share per-source spectrograms with the UI (optional, not owned).
+     * Call before initialise(); the worker computes each source's spectrogram
+     * once and later passes reuse it.
+     */
+    void setSpectrogramService(MelSpectrogramService* service) { spectrogramService = service; }
+
+    /**
+     * @brief Run whisper in this many separate worker processes (0 = in-process, default).
+     * A crashing worker only fails its job, which is then retried in-process;
+     * if the worker is missing or keeps failing, transcription stays in-process.
+     * Short sources are not batched while workers are used.
+     */
+    void setWorkerProcesses(int numProcesses) { workerPool.setNumProcesses(numProcesses); }
+
+    //==========================================================================
+    // Priorities
+
+    /**
+     * @brief Current playback position in seconds (negative = unknown).
+     * Wait-free; may be called from the audio thread.
+     */
+    void setPlayheadPosition(double seconds) noexcept { playheadSeconds.store(seconds); }
+
+    /** Selection and hidden tracks in the host. Thread-safe. */
+    void setFocus(const TranscriptionFocus& newFocus);
+
+    /** Where a source is used on the timeline, in playback seconds. Thread-safe. */
+    void setSourcePlacement(AudioSourceID sourceID, const juce::Array<juce::Range<double>>& playbackRanges);
+
+    // Relevance weights, see getPriorityLocked()
+    static constexpr float selectedWeight = 8.0f;
+    static constexpr float visibleWeight = 2.0f;
+    static constexpr float playheadWeight = 4.0f;
+    static constexpr float recencyWeight = 1.0f;
+    static constexpr double playheadFalloffSeconds = 20.0;  // Distance at which proximity counts 1/e
+    static constexpr double recencyFalloffSeconds = 60.0;
+
+    /** How much more relevant a pending job must be to preempt a running one. */
+    static constexpr float preemptionMargin = 2.0f;
+
+    //==========================================================================
+    // Realtime load
+
+    /**
+     * @brief Fed by the playback renderers; decides how much work may run.
+     * Paused or reduced workers start no jobs, and running windowed passes
+     * stop at the next window boundary (keeping their progress).
+     */
+    RealtimeLoadGovernor& getLoadGovernor() noexcept { return loadGovernor; }
+    const RealtimeLoadGovernor& getLoadGovernor() const noexcept { return loadGovernor; }
+
+    //==========================================================================
+    // Metrics
+
+    /** Per-stage latency of finished jobs, and the optional trace file. */
+    TranscriptionMetrics& getMetrics() noexcept { return metrics; }
+
+    //==========================================================================
+    // Journal
+
+    /**
+     * @brief True if work for this source (host persistent ID) was queued and
+     * never finished, e.g. because the host crashed or the project was closed.
+     * A source stays journaled from its first job until its last pass is done,
+     * and long in-process passes checkpoint their windows, so a job for the
+     * same audio continues after its last checkpoint.
+     */
+    bool hasJournaledWork(const juce::String& persistentID) const { return journal->hasUnfinishedSource(persistentID); }
+
     /**
      * @brief Cancel all pending jobs.
-     * Also signals the current job to stop if possible.
+     * Also aborts the whisper passes that are running.
      */
     void cancelAll();
 
     /**
      * @brief Cancel pending jobs for a specific audio source.
-     * Useful when an audio source is deleted.
+     * Useful when an audio source is deleted. A running pass for the source
+     * is aborted, unless it is a batch that other sources still need.
      */
     void cancelForAudioSource(AudioSourceID sourceID);
 
-    // juce::Thread override
-    void run() override;
+    /**
+     * Longest source that is considered for batching: pending jobs this short
+     * with the same model and pass share one whisper pass (see
+     * WhisperEngine::processBatch), so a session full of comping takes
+     * doesn't pay for a full encoder window per take.
+     */
+    static constexpr double maxBatchedClipSeconds = 10.0;
 
 private:
-    VoxScriptDocumentStore* documentStore = nullptr;
+    class Worker;
+
+    /** A worker's pending work. */
+    struct WorkerQueue
+    {
+        std::deque<TranscriptionJob> jobs;
+        std::deque<TranscriptionJob> refineJobs; // Background passes: refinements, deferred ranges
+        juce::String loadedModelId;              // Model the worker's engine holds (affinity)
+        WhisperEngine* engine = nullptr;         // While the worker runs; cancelling aborts its pass
+        AudioSourceID heldSourceID = 0;          // Audio the engine holds for WhisperEngine::redecode() (a hint)
+    };
+
+    /** Body of each worker thread. */
+    void runWorker(size_t workerIndex, juce::Thread& thread);
+
+    /**
+     * True if everything the worker is running has been cancelled. A batch
+     * shares one whisper pass, so it only counts once all its sources are.
+     * Caller holds queueMutex.
+     */
+    bool isWorkerCancelledLocked(size_t workerIndex) const;
+
+    /** Abort the whisper pass of every worker whose jobs are all cancelled. Caller holds queueMutex. */
+    void abortCancelledWorkersLocked();
+
+    /** Remove all pending jobs for a source from all queues. Caller holds queueMutex. */
+    void removePendingJobsLocked(AudioSourceID sourceID);
+
+    /** Delete the temp files of discarded jobs. */
+    static void discardJobs(std::deque<TranscriptionJob>& jobs);
+
+    /**
+     * True if the job streams settled segments into the store while it runs:
+     * the first in-process pass of a whole source, so the Script View fills
+     * in during a long pass. The final result then replaces the stream.
+     */
+    bool streamsSegments(const TranscriptionJob& job) const;
+
+    /** Publish a finished job's result to the store on the Message Thread. */
+    void publishResult(const TranscriptionJob& job, const VoxSequence& result);
+
+    /**
+     * Worker whose deque a new job goes to: the one already handling its
+     * source, else an idle one with its model loaded, else the shortest.
+     * Caller holds queueMutex.
+     */
+    size_t chooseWorkerLocked(const TranscriptionJob& job) const;
+
+    /**
+     * Take the most relevant job a worker may start (its own on a tie, else
+     * stolen), plus any pending jobs that can share its whisper pass. Empty
+     * if nothing may start now. Caller holds queueMutex.
+     */
+    std::vector<TranscriptionJob> takeNextBatchLocked(size_t workerIndex);
 
+    /**
+     * True if a job may start now: its source is idle and memory allows.
+     * Only checks the budget; a job that doesn't fit leaves a request for
+     * takeReclaimRequestLocked(). Caller holds queueMutex.
+     */
+    bool canStartLocked(const TranscriptionJob& job);
+
+    /**
+     * Bytes a waiting job needs freed, or 0. Given out once per state change:
+     * again only when the job needs more or memory use has moved since the
+     * last attempt. Caller holds queueMutex.
+     */
+    juce::int64 takeReclaimRequestLocked();
+
+    /**
+     * Relevance of a pending or running job (higher runs first): selection in
+     * the host, visibility, distance of the source's regions from the
+     * playhead, and how recently the job was requested. Computed when a
+     * worker chooses, so moving the playhead costs nothing up front.
+     * Caller holds queueMutex.
+     */
+    float getPriorityLocked(const TranscriptionJob& job) const;
+
+    /**
+     * Polled at window boundaries of a running job: should it give way? Only
+     * while all workers are busy, to a job more relevant by preemptionMargin;
+     * it is requeued with the windows it finished (see requeuePreempted()).
+     */
+    bool shouldPreempt(const TranscriptionJob& running);
+
+    /**
+     * False while the load governor holds this worker back: some while the
+     * host plays, all of them during an offline render.
+     */
+    bool mayRunWorker(size_t workerIndex) const noexcept;
+
+    /** Put a preempted job back, to continue from progress later. */
+    void requeuePreempted(size_t workerIndex, TranscriptionJob job,
+                          std::shared_ptr<const TranscriptStitcher::Progress> progress);
+
+    /** Start (or restart) a job's QueueWait span. */
+    static void markQueued(TranscriptionJob& job);
+
+    /** Rough working memory of a running job (state, audio, spectrogram). */
+    static juce::int64 estimateJobBytes(const TranscriptionJob& job);
+
+    /**
+     * True if the job's model needs a language and none is known yet. The
+     * probe then runs once; its result goes to the store and travels with
+     * the job into its follow-up passes.
+     */
+    static bool needsLanguageDetection(const TranscriptionJob& job);
+
+    /** Store a detected language on the Message Thread. */
+    void publishLanguage(AudioSourceID sourceID, const juce::String& language);
+
+    /** Tell the completion callback, on the Message Thread, that a source's spectrogram is ready. */
+    void publishSpectrogram(AudioSourceID sourceID);
+
+    /**
+     * Result cache key for a job, given the fingerprint of its audio file.
+     * Batched jobs get their own, since processBatch() decodes differently.
+     */
+    TranscriptionCacheKey makeCacheKey(const TranscriptionJob& job, const juce::String& contentHash,
+                                       const WhisperEngine& engine, bool batched) const;
+
+    /**
+     * Publish, clean up and schedule the follow-up of one processed job: a
+     * Draft's refinement, or the deferred ranges of a region-scoped job. Both
+     * wait in the worker's refineJobs and only run when no new work is pending.
+     */
+    void finishJob(size_t workerIndex, const TranscriptionJob& job, const VoxSequence& result);
+
+    VoxScriptDocumentStore* documentStore = nullptr;
 
     std::mutex queueMutex;
     std::condition_variable queueCV;
-    std::deque<TranscriptionJob> jobQueue;
+    std::vector<WorkerQueue> queues;          // One per worker (guarded by queueMutex)
+    std::vector<std::unique_ptr<Worker>> workers;
+    int requestedNumWorkers = 0;
+
+    // Sources of the jobs currently being processed, and by which worker (guarded by queueMutex)
+    std::map<AudioSourceID, size_t> runningSources;
+    std::set<AudioSourceID> cancelledRunningSources;
+    juce::int64 runningJobBytes = 0; // Sum of estimateJobBytes() of running jobs
+
+    // Memory a job held back by the budget is waiting for (guarded by queueMutex)
+    juce::int64 headroomWanted = 0;
+    juce::int64 lastReclaimBytes = 0;
+    juce::int64 lastReclaimUsage = -1;
+
+    // Relevance inputs (guarded by queueMutex, except the playhead)
+    TranscriptionFocus focus;
+    std::map<AudioSourceID, juce::Array<juce::Range<double>>> sourcePlacements;
+    std::atomic<double> playheadSeconds { -1.0 };
+
+    RealtimeLoadGovernor loadGovernor;
+    TranscriptionMetrics metrics;
     
     std::function<void(AudioSourceID)> completionCallback;
     
     std::shared_ptr<std::atomic<bool>> aliveFlag;
     
-    bool stopRequested = false;
+    std::atomic<bool> stopRequested { false };
+
+    std::atomic<juce::int64> idleTimeoutMs { 2 * 60 * 1000 };
+
+    juce::SharedResourcePointer<TranscriptionResultCache> resultCache;
+    juce::SharedResourcePointer<TranscriptionJournal> journal;
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
+    MelSpectrogramService* spectrogramService = nullptr;
+    TranscriptionWorkerPool workerPool;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TranscriptionJobQueue)
 };
@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+    TranscriptionJournal.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptionJournal.h"
+#include "../transcription/TranscriptionResultCache.h"
+
+namespace VoxScript
+{
+
+namespace
+{
+    // Record kinds; "id" is a persistent ID for source records, a cache key for job records
+    constexpr const char* sourceQueuedOp = "queued";
+    constexpr const char* sourceFinishedOp = "finished";
+    constexpr const char* checkpointOp = "checkpoint";
+    constexpr const char* jobFinishedOp = "done";
+}
+
+TranscriptionJournal::TranscriptionJournal()
+{
+    if (!processLock.enter (0))
+    {
+        juce::Logger::writeToLog ("VoxScript: Transcription journal is in use by another process; not journaling");
+        return;
+    }
+
+    const auto file = getJournalFile();
+    file.getParentDirectory().createDirectory();
+
+    juce::StringArray lines;
+    file.readLines (lines);
+
+    std::lock_guard<std::mutex> guard (lock);
+
+    for (const auto& line : lines)
+    {
+        const auto record = juce::JSON::parse (line);
+
+        if (record.isObject()) // Anything else is a torn write
+            replayLocked (record);
+    }
+
+    compactLocked();
+
+    if (!unfinishedSources.empty() || !unfinishedJobs.empty())
+        DBG ("TranscriptionJournal: " + juce::String ((int) unfinishedSources.size()) + " unfinished sources, "
+             + juce::String ((int) unfinishedJobs.size()) + " interrupted passes");
+}
+
+TranscriptionJournal::~TranscriptionJournal()
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (stream != nullptr)
+        compactLocked();
+
+    stream.reset();
+    processLock.exit();
+}
+
+juce::File TranscriptionJournal::getJournalFile()
+{
+    // <AppData>/VoxScript/cache/journal, next to the transcript cache
+    return TranscriptionResultCache::getCacheDirectory().getSiblingFile ("journal");
+}
+
+//==============================================================================
+void TranscriptionJournal::sourceQueued (const juce::String& persistentID)
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (stream == nullptr || persistentID.isEmpty() || unfinishedSources.count (persistentID) > 0)
+        return;
+
+    const auto time = juce::Time::currentTimeMillis();
+    unfinishedSources[persistentID] = time;
+    appendLocked (makeRecord (sourceQueuedOp, persistentID, time));
+}
+
+void TranscriptionJournal::sourceFinished (const juce::String& persistentID)
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (stream == nullptr || unfinishedSources.erase (persistentID) == 0)
+        return;
+
+    appendLocked (makeRecord (sourceFinishedOp, persistentID, juce::Time::currentTimeMillis()));
+}
+
+bool TranscriptionJournal::hasUnfinishedSource (const juce::String& persistentID) const
+{
+    std::lock_guard<std::mutex> guard (lock);
+    return unfinishedSources.count (persistentID) > 0;
+}
+
+//==============================================================================
+void TranscriptionJournal::checkpoint (const juce::String& jobKey, const TranscriptStitcher::Progress& progress)
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (stream == nullptr || jobKey.isEmpty())
+        return;
+
+    auto& entry = unfinishedJobs[jobKey];
+    const auto nowMs = juce::Time::getMillisecondCounter();
+
+    if (entry.progress != nullptr && nowMs - entry.writtenAtMs < checkpointIntervalMs)
+        return;
+
+    const int firstSegment = getNumUnchangedSegments (entry, progress);
+
+    entry.progress = std::make_shared<const TranscriptStitcher::Progress> (progress);
+    entry.checkpointTime = juce::Time::currentTimeMillis();
+    entry.writtenAtMs = nowMs;
+    appendLocked (makeCheckpointRecord (jobKey, progress, firstSegment, entry.checkpointTime));
+}
+
+int TranscriptionJournal::getNumUnchangedSegments (const JobEntry& entry, const TranscriptStitcher::Progress& progress)
+{
+    // Only the same pass further on keeps what was settled; anything else starts over
+    if (entry.progress == nullptr || progress.lastWindow.getStart() <= entry.progress->lastWindow.getStart())
+        return 0;
+
+    return juce::jmin (entry.progress->numSettled, entry.progress->stitched.getNumSegments(),
+                       progress.stitched.getNumSegments());
+}
+
+void TranscriptionJournal::jobFinished (const juce::String& jobKey)
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (stream == nullptr || unfinishedJobs.erase (jobKey) == 0)
+        return;
+
+    appendLocked (makeRecord (jobFinishedOp, jobKey, juce::Time::currentTimeMillis()));
+}
+
+std::shared_ptr<const TranscriptStitcher::Progress> TranscriptionJournal::findProgress (const juce::String& jobKey) const
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    auto it = unfinishedJobs.find (jobKey);
+    return it != unfinishedJobs.end() ? it->second.progress : nullptr;
+}
+
+//==============================================================================
+void TranscriptionJournal::replayLocked (const juce::var& record)
+{
+    const auto op = record["op"].toString();
+    const auto id = record["id"].toString();
+    const auto time = static_cast<juce::int64> (record["time"]);
+
+    if (id.isEmpty())
+        return;
+
+    if (op == sourceQueuedOp)
+    {
+        unfinishedSources[id] = time;
+    }
+    else if (op == sourceFinishedOp)
+    {
+        unfinishedSources.erase (id);
+    }
+    else if (op == checkpointOp)
+    {
+        auto existing = unfinishedJobs.find (id);
+        const auto* previous = existing != unfinishedJobs.end() ? existing->second.progress.get() : nullptr;
+
+        if (auto progress = readProgress (record, previous))
+        {
+            auto& entry = unfinishedJobs[id];
+            entry.progress = std::move (progress);
+            entry.checkpointTime = time;
+        }
+        else if (static_cast<int> (record["from"]) > 0 && existing != unfinishedJobs.end())
+        {
+            unfinishedJobs.erase (existing); // Its later records can't be applied either
+        }
+    }
+    else if (op == jobFinishedOp)
+    {
+        unfinishedJobs.erase (id);
+    }
+}
+
+void TranscriptionJournal::appendLocked (const juce::var& record)
+{
+    if (stream == nullptr)
+        return;
+
+    stream->writeText (juce::JSON::toString (record, true) + "\n", false, false, nullptr);
+    stream->flush();
+
+    if (stream->getPosition() > maxFileBytes)
+        compactLocked();
+}
+
+void TranscriptionJournal::compactLocked()
+{
+    stream.reset();
+
+    const auto file = getJournalFile();
+    const auto tempFile = file.getSiblingFile (file.getFileName() + ".tmp");
+    const auto cutoff = juce::Time::currentTimeMillis() - (juce::int64) maxEntryAgeDays * 24 * 60 * 60 * 1000;
+
+    // Work nobody came back for in two weeks belongs to a project that is gone
+    for (auto it = unfinishedSources.begin(); it != unfinishedSources.end();)
+        it = it->second < cutoff ? unfinishedSources.erase (it) : std::next (it);
+
+    for (auto it = unfinishedJobs.begin(); it != unfinishedJobs.end();)
+        it = it->second.checkpointTime < cutoff ? unfinishedJobs.erase (it) : std::next (it);
+
+    {
+        tempFile.deleteFile();
+        juce::FileOutputStream out (tempFile);
+
+        if (out.failedToOpen())
+        {
+            juce::Logger::writeToLog ("VoxScript: Could not write transcription journal " + tempFile.getFullPathName());
+            return;
+        }
+
+        for (const auto& [persistentID, time] : unfinishedSources)
+            out.writeText (juce::JSON::toString (makeRecord (sourceQueuedOp, persistentID, time), true) + "\n", false, false, nullptr);
+
+        for (const auto& [jobKey, entry] : unfinishedJobs)
+            out.writeText (juce::JSON::toString (makeCheckpointRecord (jobKey, *entry.progress, 0, entry.checkpointTime), true) + "\n",
+                           false, false, nullptr);
+
+        out.flush();
+    }
+
+    // Replace in one step, so a crash leaves either the old journal or the new one
+    if (!tempFile.moveFileTo (file))
+    {
+        juce::Logger::writeToLog ("VoxScript: Could not replace transcription journal " + file.getFullPathName());
+        tempFile.deleteFile();
+    }
+
+    stream = std::make_unique<juce::FileOutputStream> (file); // Appends at the end
+
+    if (stream->failedToOpen())
+    {
+        juce::Logger::writeToLog ("VoxScript: Could not open transcription journal " + file.getFullPathName());
+        stream.reset();
+    }
+}
+
+//==============================================================================
+juce::var TranscriptionJournal::makeRecord (const char* op, const juce::String& id, juce::int64 time)
+{
+    auto record = std::make_unique<juce::DynamicObject>();
+    record->setProperty ("op", op);
+    record->setProperty ("id", id);
+    record->setProperty ("time", time);
+    return juce::var (record.release());
+}
+
+juce::var TranscriptionJournal::makeCheckpointRecord (const juce::String& jobKey, const TranscriptStitcher::Progress& progress,
+                                                      int firstSegment, juce::int64 time)
+{
+    VoxSequence added;
+
+    for (int i = firstSegment; i < progress.stitched.getNumSegments(); ++i)
+        added.addSegment (progress.stitched.getSegment (i));
+
+    juce::MemoryOutputStream stitched;
+    (firstSegment > 0 ? added : progress.stitched).toValueTree().writeToStream (stitched);
+
+    auto record = makeRecord (checkpointOp, jobKey, time);
+    record.getDynamicObject()->setProperty ("windowStart", progress.lastWindow.getStart());
+    record.getDynamicObject()->setProperty ("windowEnd", progress.lastWindow.getEnd());
+    record.getDynamicObject()->setProperty ("settled", progress.numSettled);
+    record.getDynamicObject()->setProperty ("from", firstSegment);
+    record.getDynamicObject()->setProperty ("stitched", stitched.getMemoryBlock().toBase64Encoding());
+    return record;
+}
+
+std::shared_ptr<const TranscriptStitcher::Progress> TranscriptionJournal::readProgress (const juce::var& record,
+                                                                                        const TranscriptStitcher::Progress* previous)
+{
+    juce::MemoryBlock data;
+
+    if (!data.fromBase64Encoding (record["stitched"].toString()))
+        return nullptr;
+
+    const auto tree = juce::ValueTree::readFromData (data.getData(), data.getSize());
+    VoxSequence added;
+
+    if (!tree.isValid() || !added.fromValueTree (tree))
+        return nullptr;
+
+    // Absent in records written before checkpoints were incremental: whole
+    const int firstSegment = static_cast<int> (record["from"]);
+    TranscriptStitcher::Progress progress;
+
+    if (firstSegment > 0)
+    {
+        if (previous == nullptr || previous->stitched.getNumSegments() < firstSegment)
+            return nullptr;
+
+        progress.stitched = previous->stitched;
+        progress.stitched.truncate (firstSegment);
+
+        for (int i = 0; i < added.getNumSegments(); ++i)
+            progress.stitched.addSegment (added.getSegment (i));
+    }
+    else
+    {
+        progress.stitched = std::move (added);
+    }
+
+    progress.lastWindow = { static_cast<double> (record["windowStart"]), static_cast<double> (record["windowEnd"]) };
+    progress.numSettled = static_cast<int> (record["settled"]);
+    return std::make_shared<const TranscriptStitcher::Progress> (std::move (progress));
+}
+
+} // namespace VoxScript
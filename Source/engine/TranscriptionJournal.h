@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    TranscriptionJournal.h
+
+    Append-only record of transcription work that is not finished yet, so a
+    host crash or a project closed mid-transcription doesn't lose it. On
+    reopen the controller re-requests the sources whose work was still
+    outstanding, and a windowed pass that was interrupted continues after
+    its last checkpoint instead of starting over. Finished results are not
+    kept here; the TranscriptionResultCache already has them.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../transcription/TranscriptStitcher.h"
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Journal of outstanding transcription work, shared by all plug-in instances.
+ *
+ * Two kinds of entries:
+ * - Sources, by the host's persistent ID: queued until every job for the
+ *   source (including its refinement and deferred ranges) has finished.
+ * - Jobs, by result cache key (content fingerprint, model and decode
+ *   settings): the stitched windows of a long pass, checkpointed as it runs,
+ *   until its result is in the cache. A checkpoint record holds only the
+ *   segments after those settled at the job's previous one, so a long pass
+ *   writes each segment about once; compaction writes them whole.
+ *
+ * The file is <AppData>/VoxScript/cache/journal, one JSON record per line,
+ * appended and flushed as work progresses. A torn last line (a crash in the
+ * middle of a write) is skipped. On startup the records are replayed, and
+ * the file is rewritten with only what is still outstanding and younger
+ * than maxEntryAgeDays; the same compaction runs once the file grows past
+ * maxFileBytes.
+ *
+ * Only one host process uses the journal at a time; in a second one it
+ * stays disabled and all calls do nothing.
+ *
+ * Thread Safety:
+ * - All methods are thread-safe.
+ */
+class TranscriptionJournal
+{
+public:
+    /** Replays and compacts the journal file. */
+    TranscriptionJournal();
+    ~TranscriptionJournal();
+
+    static juce::File getJournalFile();
+
+    bool isEnabled() const noexcept { return stream != nullptr; }
+
+    //==========================================================================
+    // Sources
+
+    /** A job for the source was queued. */
+    void sourceQueued (const juce::String& persistentID);
+
+    /** No job for the source is left (all passes done). */
+    void sourceFinished (const juce::String& persistentID);
+
+    /** True if the source was queued and never finished, in this or an earlier session. */
+    bool hasUnfinishedSource (const juce::String& persistentID) const;
+
+    //==========================================================================
+    // Jobs
+
+    /**
+     * Windows of a running pass done so far. Written at most every
+     * checkpointIntervalMs per job; a crash loses at most that much work.
+     */
+    void checkpoint (const juce::String& jobKey, const TranscriptStitcher::Progress& progress);
+
+    /** The job's result is in the cache (or it failed); forget its checkpoint. */
+    void jobFinished (const juce::String& jobKey);
+
+    /** Last checkpoint of an unfinished job, or nullptr. */
+    std::shared_ptr<const TranscriptStitcher::Progress> findProgress (const juce::String& jobKey) const;
+
+    //==========================================================================
+    static constexpr juce::uint32 checkpointIntervalMs = 15 * 1000;
+    static constexpr int maxEntryAgeDays = 14;
+    static constexpr juce::int64 maxFileBytes = 8 * 1024 * 1024;
+
+private:
+    struct JobEntry
+    {
+        std::shared_ptr<const TranscriptStitcher::Progress> progress;
+        juce::int64 checkpointTime = 0;   // juce::Time milliseconds of the record
+        juce::uint32 writtenAtMs = 0;     // Millisecond counter, for the interval
+    };
+
+    /** Leading segments of the journaled progress the next checkpoint needn't write again. */
+    static int getNumUnchangedSegments (const JobEntry& entry, const TranscriptStitcher::Progress& progress);
+
+    /** Apply one record to the outstanding state. Caller holds lock. */
+    void replayLocked (const juce::var& record);
+
+    /** Append one record and flush. Caller holds lock. */
+    void appendLocked (const juce::var& record);
+
+    /** Rewrite the file with the outstanding state only. Caller holds lock. */
+    void compactLocked();
+
+    static juce::var makeRecord (const char* op, const juce::String& id, juce::int64 time);
+    /** Checkpoint with the stitched segments from firstSegment on (0: all of them). */
+    static juce::var makeCheckpointRecord (const juce::String& jobKey, const TranscriptStitcher::Progress& progress,
+                                           int firstSegment, juce::int64 time);
+
+    /** Progress of a checkpoint record; one that starts past segment 0 continues previous. */
+    static std::shared_ptr<const TranscriptStitcher::Progress> readProgress (const juce::var& record,
+                                                                             const TranscriptStitcher::Progress* previous);
+
+    mutable std::mutex lock;
+    juce::InterProcessLock processLock { "VoxScriptTranscriptionJournal" };
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    std::map<juce::String, juce::int64> unfinishedSources; // Persistent ID -> time queued
+    std::map<juce::String, JobEntry> unfinishedJobs;       // Cache key -> last checkpoint
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TranscriptionJournal)
+};
+
+} // namespace VoxScript
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+    TranscriptionMetrics.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptionMetrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VoxScript
+{
+
+TranscriptionMetrics::TranscriptionMetrics()
+{
+    const auto fromEnvironment = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_TRACE_FILE", {});
+
+    if (fromEnvironment.isNotEmpty())
+        setTraceFile (juce::File (fromEnvironment));
+}
+
+TranscriptionMetrics::~TranscriptionMetrics()
+{
+    if (getCount (totalIndex) > 0)
+        juce::Logger::writeToLog ("VoxScript: Transcription latency\n" + getSummary());
+
+    setTraceFile ({});
+}
+
+//==============================================================================
+void TranscriptionMetrics::Histogram::add (double ms) noexcept
+{
+    const auto micros = static_cast<juce::uint64> (juce::jmax (0.0, ms) * 1000.0);
+
+    buckets[static_cast<size_t> (getBucket (ms))].fetch_add (1, std::memory_order_relaxed);
+    count.fetch_add (1, std::memory_order_relaxed);
+    totalMicros.fetch_add (micros, std::memory_order_relaxed);
+
+    auto currentMax = maxMicros.load (std::memory_order_relaxed);
+    while (micros > currentMax && !maxMicros.compare_exchange_weak (currentMax, micros, std::memory_order_relaxed))
+    {
+    }
+}
+
+int TranscriptionMetrics::getBucket (double ms) noexcept
+{
+    if (ms < 1.0)
+        return 0;
+
+    return juce::jmin (numBuckets - 1, 1 + static_cast<int> (std::floor (std::log2 (ms))));
+}
+
+void TranscriptionMetrics::record (const TranscriptionTrace& trace)
+{
+    for (int i = 0; i < totalIndex; ++i)
+    {
+        const auto stage = static_cast<TranscriptionStage> (i);
+        const bool hasStage = std::any_of (trace.spans.begin(), trace.spans.end(),
+                                           [stage] (const TranscriptionTrace::Span& span) { return span.stage == stage; });
+
+        if (hasStage)
+            histograms[static_cast<size_t> (i)].add (trace.getTotalMs (stage));
+    }
+
+    if (!trace.spans.empty())
+        histograms[static_cast<size_t> (totalIndex)].add (trace.getElapsedMs());
+
+    if (tracing.load())
+        writeTraceEvents (trace);
+}
+
+juce::uint64 TranscriptionMetrics::getCount (int stageIndex) const noexcept
+{
+    if (!juce::isPositiveAndNotGreaterThan (stageIndex, totalIndex))
+        return 0;
+
+    return histograms[static_cast<size_t> (stageIndex)].count.load();
+}
+
+double TranscriptionMetrics::getMeanMs (int stageIndex) const noexcept
+{
+    const auto count = getCount (stageIndex);
+
+    if (count == 0)
+        return 0.0;
+
+    return static_cast<double> (histograms[static_cast<size_t> (stageIndex)].totalMicros.load()) / 1000.0 / static_cast<double> (count);
+}
+
+double TranscriptionMetrics::getPercentileMs (int stageIndex, double percentile) const noexcept
+{
+    const auto count = getCount (stageIndex);
+
+    if (count == 0)
+        return 0.0;
+
+    const auto& histogram = histograms[static_cast<size_t> (stageIndex)];
+    const auto target = static_cast<juce::uint64> (std::ceil (juce::jlimit (0.0, 100.0, percentile) / 100.0 * static_cast<double> (count)));
+    juce::uint64 seen = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        seen += histogram.buckets[static_cast<size_t> (i)].load();
+
+        if (seen >= juce::jmax ((juce::uint64) 1, target))
+            return std::ldexp (1.0, i); // Upper bound of bucket i
+    }
+
+    return static_cast<double> (histogram.maxMicros.load()) / 1000.0;
+}
+
+juce::String TranscriptionMetrics::getSummary() const
+{
+    juce::StringArray lines;
+
+    for (int i = 0; i <= totalIndex; ++i)
+    {
+        const auto count = getCount (i);
+
+        if (count == 0)
+            continue;
+
+        const juce::String name = i == totalIndex ? "total" : TranscriptionTrace::getStageName (static_cast<TranscriptionStage> (i));
+
+        lines.add (name.paddedRight (' ', 18)
+                   + "n=" + juce::String ((juce::int64) count)
+                   + "  mean " + juce::String (getMeanMs (i), 1) + " ms"
+                   + "  p50 <" + juce::String (getPercentileMs (i, 50.0), 0)
+                   + "  p95 <" + juce::String (getPercentileMs (i, 95.0), 0)
+                   + "  max " + juce::String (static_cast<double> (histograms[static_cast<size_t> (i)].maxMicros.load()) / 1000.0, 1) + " ms");
+    }
+
+    return lines.joinIntoString ("\n");
+}
+
+void TranscriptionMetrics::reset() noexcept
+{
+    for (auto& histogram : histograms)
+    {
+        for (auto& bucket : histogram.buckets)
+            bucket.store (0);
+
+        histogram.count.store (0);
+        histogram.totalMicros.store (0);
+        histogram.maxMicros.store (0);
+    }
+}
+
+//==============================================================================
+void TranscriptionMetrics::setTraceFile (const juce::File& file)
+{
+    std::lock_guard<std::mutex> lock (traceMutex);
+
+    tracing.store (false);
+    traceStream.reset();
+
+    if (file == juce::File())
+        return;
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream> (file);
+
+    if (stream->failedToOpen())
+    {
+        juce::Logger::writeToLog ("VoxScript: Could not write trace file " + file.getFullPathName());
+        return;
+    }
+
+    stream->writeText ("[\n", false, false, nullptr);
+    stream->flush();
+
+    traceStream = std::move (stream);
+    traceOriginMs = TranscriptionTrace::now();
+    tracing.store (true);
+}
+
+void TranscriptionMetrics::writeTraceEvents (const TranscriptionTrace& trace)
+{
+    std::lock_guard<std::mutex> lock (traceMutex);
+
+    if (traceStream == nullptr)
+        return;
+
+    // One row (tid) per source; complete events ("X") with microsecond times
+    for (const auto& span : trace.spans)
+    {
+        auto event = std::make_unique<juce::DynamicObject>();
+        event->setProperty ("name", TranscriptionTrace::getStageName (span.stage));
+        event->setProperty ("cat", "transcription");
+        event->setProperty ("ph", "X");
+        event->setProperty ("ts", (span.startMs - traceOriginMs) * 1000.0);
+        event->setProperty ("dur", (span.endMs - span.startMs) * 1000.0);
+        event->setProperty ("pid", 1);
+        event->setProperty ("tid", (juce::int64) trace.sourceID);
+
+        auto args = std::make_unique<juce::DynamicObject>();
+        args->setProperty ("job", trace.label);
+        event->setProperty ("args", juce::var (args.release()));
+
+        traceStream->writeText (juce::JSON::toString (juce::var (event.release()), true) + ",\n", false, false, nullptr);
+    }
+
+    traceStream->flush();
+}
+
+} // namespace VoxScript
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+    TranscriptionMetrics.h
+
+    Aggregated latency of transcription jobs per stage, and an optional
+    trace file. Every finished job's TranscriptionTrace is added to lock-free
+    histograms; if a trace file is set, its spans are also written in the
+    Chrome trace event format, which chrome://tracing and the Perfetto UI
+    open directly.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../transcription/TranscriptionTrace.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Latency histograms per stage, plus one for the whole job.
+ *
+ * Buckets are powers of two in milliseconds (bucket 0: under 1 ms, bucket
+ * i: [2^(i-1), 2^i) ms), so percentiles are accurate to a factor of two,
+ * which is enough to tell a 40 ms stage from a 4 s one.
+ *
+ * Thread Safety:
+ * - record() and the getters are lock-free; any thread.
+ * - The trace file is written under its own lock, only if one is set.
+ */
+class TranscriptionMetrics
+{
+public:
+    static constexpr int numBuckets = 24;  // Up to ~2.3 hours
+
+    /** Index of the whole-job histogram (first span to last). */
+    static constexpr int totalIndex = static_cast<int> (TranscriptionStage::NumStages);
+
+    /** Starts writing to VOXSCRIPT_TRACE_FILE if that is set. */
+    TranscriptionMetrics();
+    ~TranscriptionMetrics();
+
+    /** Add a finished job (called once per job, after publication). */
+    void record (const TranscriptionTrace& trace);
+
+    /** Number of jobs that went through a stage (totalIndex: all jobs). */
+    juce::uint64 getCount (int stageIndex) const noexcept;
+
+    /** Mean time per job in a stage, ms. */
+    double getMeanMs (int stageIndex) const noexcept;
+
+    /** Upper bound of the bucket holding the given percentile (0..100), ms. */
+    double getPercentileMs (int stageIndex, double percentile) const noexcept;
+
+    /** One line per stage with count, mean, p50, p95 and max; for the log. */
+    juce::String getSummary() const;
+
+    /** Forget everything recorded so far (the trace file is kept). */
+    void reset() noexcept;
+
+    /**
+     * @brief Write each job's spans to a Chrome trace file (empty file = stop).
+     * The file is replaced. Events are appended as jobs finish and the
+     * closing bracket is left off, which the format allows, so a session
+     * that ends abruptly still loads.
+     */
+    void setTraceFile (const juce::File& file);
+    bool isTracing() const noexcept { return tracing.load(); }
+
+private:
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint64>, numBuckets> buckets {};
+        std::atomic<juce::uint64> count { 0 };
+        std::atomic<juce::uint64> totalMicros { 0 };
+        std::atomic<juce::uint64> maxMicros { 0 };
+
+        void add (double ms) noexcept;
+    };
+
+    static int getBucket (double ms) noexcept;
+
+    void writeTraceEvents (const TranscriptionTrace& trace);
+
+    std::array<Histogram, totalIndex + 1> histograms;
+
+    std::mutex traceMutex;
+    std::unique_ptr<juce::FileOutputStream> traceStream;
+    double traceOriginMs = 0.0;
+    std::atomic<bool> tracing { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TranscriptionMetrics)
+};
+
+} // namespace VoxScript
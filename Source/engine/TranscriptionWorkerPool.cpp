@@ -0,0 +1,390 @@
+/*
+  ==============================================================================
+    TranscriptionWorkerPool.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptionWorkerPool.h"
+#include "SharedAudioRing.h"
+#include <chrono>
+
+namespace VoxScript
+{
+
+using namespace TranscriptionWorkerProtocol;
+
+//==============================================================================
+/** One worker process, its ring and the job it is running. */
+class TranscriptionWorkerPool::WorkerProcess : public juce::ChildProcessCoordinator
+{
+public:
+    ~WorkerProcess() override
+    {
+        killWorkerProcess();
+    }
+
+    bool launch (const juce::File& executable)
+    {
+        auto newRing = SharedAudioRing::create (ringCapacitySamples);
+
+        if (newRing == nullptr)
+            return false;
+
+        const auto ringPath = newRing->getFile().getFullPathName();
+
+        {
+            // Under the lock: the connection thread of the last process may still release into the old one
+            std::lock_guard<std::mutex> lock (mutex);
+            ring = std::move (newRing);
+            connected = true;
+            ready = false;
+        }
+
+        // No stdout/stderr capture: nobody reads it, and a full pipe would block the worker
+        if (!launchWorkerProcess (executable, commandLineUID, 0, 0))
+        {
+            DBG ("TranscriptionWorkerPool: Could not launch " + executable.getFullPathName());
+            return false;
+        }
+
+        Message hello;
+        hello.type = MessageType::Hello;
+        hello.ringPath = ringPath;
+
+        if (!sendMessageToWorker (encode (hello)))
+            return false;
+
+        std::unique_lock<std::mutex> lock (mutex);
+        cv.wait_for (lock, std::chrono::seconds (10), [this] { return ready || !connected; });
+
+        if (!ready)
+            DBG ("TranscriptionWorkerPool: Worker did not become ready");
+
+        return ready;
+    }
+
+    bool isConnected() const
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        return connected && ready;
+    }
+
+    /** Stream the samples through the ring and wait for the result. */
+    std::optional<Message> run (const Message& begin, const std::vector<float>& samples,
+                                const std::function<bool()>& shouldAbort, bool& aborted)
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            currentJobId = begin.jobId;
+            result.reset();
+        }
+
+        if (!sendMessageToWorker (encode (begin)))
+            return std::nullopt;
+
+        const size_t chunkSize = ringCapacitySamples / 2;
+        size_t sent = 0;
+
+        for (;;)
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+
+            if (result.has_value())
+                return std::move (result);
+
+            if (!connected)
+                return std::nullopt;
+
+            if (shouldAbort != nullptr && shouldAbort())
+            {
+                lock.unlock();
+                aborted = true;
+
+                Message cancel;
+                cancel.type = MessageType::CancelJob;
+                cancel.jobId = begin.jobId;
+                sendMessageToWorker (encode (cancel));
+                return std::nullopt;
+            }
+
+            if (sent < samples.size())
+            {
+                const auto count = std::min (chunkSize, samples.size() - sent);
+                const auto offset = ring->write (samples.data() + sent, count);
+
+                if (offset >= 0)
+                {
+                    lock.unlock();
+
+                    Message chunk;
+                    chunk.type = MessageType::AudioChunk;
+                    chunk.jobId = begin.jobId;
+                    chunk.offset = offset;
+                    chunk.numSamples = static_cast<juce::int64> (count);
+
+                    if (!sendMessageToWorker (encode (chunk)))
+                        return std::nullopt;
+
+                    sent += count;
+                    continue;
+                }
+            }
+
+            // Ring full or everything sent: wait for the worker
+            cv.wait_for (lock, std::chrono::milliseconds (100));
+        }
+    }
+
+    void handleMessageFromWorker (const juce::MemoryBlock& data) override
+    {
+        Message message;
+        if (!decode (data, message))
+            return;
+
+        std::lock_guard<std::mutex> lock (mutex);
+
+        switch (message.type)
+        {
+            case MessageType::Ready:
+                ready = message.protocolVersion == TranscriptionWorkerProtocol::version;
+                break;
+
+            case MessageType::ChunkConsumed:
+                // Chunks are consumed in the order written, even those of a cancelled job
+                if (ring != nullptr)
+                    ring->release (static_cast<size_t> (message.numSamples));
+                break;
+
+            case MessageType::JobResult:
+                if (message.jobId == currentJobId)
+                    result = std::move (message);
+                break;
+
+            default:
+                break;
+        }
+
+        cv.notify_all();
+    }
+
+    void handleConnectionLost() override
+    {
+        DBG ("TranscriptionWorkerPool: Lost connection to worker");
+
+        std::lock_guard<std::mutex> lock (mutex);
+        connected = false;
+        cv.notify_all();
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::unique_ptr<SharedAudioRing> ring; // Replaced by launch(); guarded by mutex
+    bool connected = false;
+    bool ready = false;
+    juce::int64 currentJobId = 0;
+    std::optional<Message> result;
+};
+
+//==============================================================================
+TranscriptionWorkerPool::TranscriptionWorkerPool()
+    : workerExecutable (findWorkerExecutable())
+{
+    const auto fromEnvironment = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_WORKER_PROCESSES", {}).getIntValue();
+
+    if (fromEnvironment > 0)
+        setNumProcesses (fromEnvironment);
+}
+
+TranscriptionWorkerPool::~TranscriptionWorkerPool()
+{
+    std::lock_guard<std::mutex> lock (poolMutex);
+    processes.clear(); // Kills the workers
+    processBusy.clear();
+}
+
+void TranscriptionWorkerPool::setNumProcesses (int numProcesses)
+{
+    numProcessesWanted.store (juce::jlimit (0, 16, numProcesses));
+    consecutiveFailures.store (0);
+
+    if (numProcesses > 0 && !workerExecutable.existsAsFile())
+        juce::Logger::writeToLog ("VoxScript: Transcription worker not found, transcribing in-process");
+
+    std::lock_guard<std::mutex> lock (poolMutex);
+
+    // Idle processes beyond the new count go now, busy ones when they finish
+    while (processes.size() > static_cast<size_t> (numProcessesWanted.load()) && !processBusy.back())
+    {
+        processes.pop_back();
+        processBusy.pop_back();
+    }
+
+    poolCV.notify_all();
+}
+
+bool TranscriptionWorkerPool::isAvailable() const
+{
+    return numProcessesWanted.load() > 0
+           && consecutiveFailures.load() < maxConsecutiveFailures
+           && workerExecutable.existsAsFile();
+}
+
+std::optional<VoxSequence> TranscriptionWorkerPool::transcribe (const std::vector<float>& samples, const juce::String& modelId,
+                                                                const juce::String& language, std::function<bool()> shouldAbort)
+{
+    auto message = runJob (JobKind::Transcribe, samples, modelId, language, shouldAbort);
+
+    if (!message.has_value() || !message->succeeded)
+        return std::nullopt;
+
+    return message->result;
+}
+
+std::optional<juce::String> TranscriptionWorkerPool::detectLanguage (const std::vector<float>& samples, const juce::String& modelId,
+                                                                     std::function<bool()> shouldAbort)
+{
+    auto message = runJob (JobKind::DetectLanguage, samples, modelId, {}, shouldAbort);
+
+    if (!message.has_value() || !message->succeeded)
+        return std::nullopt;
+
+    return message->language;
+}
+
+std::optional<Message> TranscriptionWorkerPool::runJob (JobKind kind, const std::vector<float>& samples,
+                                                        const juce::String& modelId, const juce::String& language,
+                                                        const std::function<bool()>& shouldAbort)
+{
+    if (samples.empty() || !isAvailable())
+        return std::nullopt;
+
+    auto* process = acquireProcess (shouldAbort);
+
+    if (process == nullptr)
+        return std::nullopt;
+
+    Message begin;
+    begin.type = MessageType::BeginJob;
+    begin.jobId = nextJobId++;
+    begin.kind = kind;
+    begin.modelId = modelId;
+    begin.language = language;
+    begin.numSamples = static_cast<juce::int64> (samples.size());
+
+    bool aborted = false;
+    auto result = process->run (begin, samples, shouldAbort, aborted);
+
+    // A cancelled job is not the worker's fault
+    releaseProcess (process, result.has_value() || aborted);
+    return result;
+}
+
+TranscriptionWorkerPool::WorkerProcess* TranscriptionWorkerPool::acquireProcess (const std::function<bool()>& shouldAbort)
+{
+    WorkerProcess* process = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock (poolMutex);
+
+        while (process == nullptr)
+        {
+            if (!isAvailable() || (shouldAbort != nullptr && shouldAbort()))
+                return nullptr;
+
+            for (size_t i = 0; i < processes.size() && process == nullptr; ++i)
+            {
+                if (!processBusy[i])
+                {
+                    processBusy[i] = true;
+                    process = processes[i].get();
+                }
+            }
+
+            if (process == nullptr && processes.size() < static_cast<size_t> (numProcessesWanted.load()))
+            {
+                processes.push_back (std::make_unique<WorkerProcess>());
+                processBusy.push_back (true);
+                process = processes.back().get();
+            }
+
+            if (process == nullptr)
+                poolCV.wait_for (lock, std::chrono::milliseconds (100));
+        }
+    }
+
+    // Launched on first use, relaunched after a crash
+    if (!process->isConnected() && !process->launch (workerExecutable))
+    {
+        releaseProcess (process, false);
+        return nullptr;
+    }
+
+    return process;
+}
+
+void TranscriptionWorkerPool::releaseProcess (WorkerProcess* process, bool succeeded)
+{
+    if (succeeded)
+    {
+        consecutiveFailures.store (0);
+    }
+    else if (++consecutiveFailures == maxConsecutiveFailures)
+    {
+        juce::Logger::writeToLog ("VoxScript: Transcription worker keeps failing, transcribing in-process");
+    }
+
+    std::lock_guard<std::mutex> lock (poolMutex);
+
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+        if (processes[i].get() == process)
+        {
+            processBusy[i] = false;
+
+            // Shrunk while it was busy
+            if (processes.size() > static_cast<size_t> (numProcessesWanted.load()))
+            {
+                processes.erase (processes.begin() + static_cast<std::ptrdiff_t> (i));
+                processBusy.erase (processBusy.begin() + static_cast<std::ptrdiff_t> (i));
+            }
+
+            break;
+        }
+    }
+
+    poolCV.notify_all();
+}
+
+juce::File TranscriptionWorkerPool::findWorkerExecutable()
+{
+    const auto fromEnvironment = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_WORKER_PATH", {});
+
+    if (fromEnvironment.isNotEmpty())
+        return juce::File (fromEnvironment);
+
+   #if JUCE_WINDOWS
+    const juce::String name ("VoxScriptWorker.exe");
+   #else
+    const juce::String name ("VoxScriptWorker");
+   #endif
+
+    // For a plug-in this is the plug-in binary or bundle, not the host
+    const auto pluginFile = juce::File::getSpecialLocation (juce::File::currentApplicationFile);
+
+    for (const auto& candidate : { pluginFile.getChildFile ("Contents/Resources").getChildFile (name),
+                                   pluginFile.getChildFile ("Contents/MacOS").getChildFile (name),
+                                   pluginFile.getSiblingFile (name) })
+    {
+        if (candidate.existsAsFile())
+            return candidate;
+    }
+
+    return {};
+}
+
+} // namespace VoxScript
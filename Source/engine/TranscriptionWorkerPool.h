@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+    TranscriptionWorkerPool.h
+
+    Optional out-of-process transcription. Whisper runs in separate
+    VoxScriptWorker processes that the plugin launches, so inference neither
+    competes with the host for its heap nor takes the session down if it
+    crashes. Audio is passed through a SharedAudioRing per process, results
+    come back as serialised VoxSequences over the pipe.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "TranscriptionWorkerProtocol.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Pool of worker processes, used by TranscriptionJobQueue.
+ *
+ * Disabled by default (setNumProcesses(0)); it can also be enabled with the
+ * VOXSCRIPT_WORKER_PROCESSES environment variable. Processes are launched on
+ * first use and relaunched after a crash; after maxConsecutiveFailures
+ * failures in a row the pool gives up and reports itself unavailable, and
+ * callers use the in-process WhisperEngine instead.
+ *
+ * Thread Safety:
+ * - transcribe() and detectLanguage() block and may be called from several
+ *   threads at once; each call uses one idle process.
+ */
+class TranscriptionWorkerPool
+{
+public:
+    TranscriptionWorkerPool();
+    ~TranscriptionWorkerPool();
+
+    /** Number of worker processes (0 disables out-of-process transcription). */
+    void setNumProcesses (int numProcesses);
+    int getNumProcesses() const noexcept { return numProcessesWanted.load(); }
+
+    /** True if enabled, the worker executable exists and it hasn't kept failing. */
+    bool isAvailable() const;
+
+    /**
+     * Transcribe mono 16 kHz samples in a worker. Blocking.
+     * @param shouldAbort Polled while waiting; returning true cancels the job
+     * @return nullopt if no worker could run the job (use the in-process engine)
+     */
+    std::optional<VoxSequence> transcribe (const std::vector<float>& samples, const juce::String& modelId,
+                                           const juce::String& language, std::function<bool()> shouldAbort);
+
+    /** As transcribe(), for WhisperEngine::detectLanguage(). */
+    std::optional<juce::String> detectLanguage (const std::vector<float>& samples, const juce::String& modelId,
+                                                std::function<bool()> shouldAbort);
+
+    /** Worker executable: VOXSCRIPT_WORKER_PATH, or next to / inside the plugin binary. */
+    static juce::File findWorkerExecutable();
+
+    static constexpr int maxConsecutiveFailures = 3;
+
+    /** Per-process ring: two 30 s chunks, so one can be filled while the other is read. */
+    static constexpr size_t ringCapacitySamples = 2 * 30 * 16000;
+
+private:
+    class WorkerProcess;
+
+    std::optional<TranscriptionWorkerProtocol::Message> runJob (TranscriptionWorkerProtocol::JobKind kind,
+                                                                const std::vector<float>& samples,
+                                                                const juce::String& modelId,
+                                                                const juce::String& language,
+                                                                const std::function<bool()>& shouldAbort);
+
+    /** An idle process (launched if needed); nullptr if none can be had. */
+    WorkerProcess* acquireProcess (const std::function<bool()>& shouldAbort);
+    void releaseProcess (WorkerProcess* process, bool succeeded);
+
+    std::mutex poolMutex;
+    std::condition_variable poolCV;
+    std::vector<std::unique_ptr<WorkerProcess>> processes;
+    std::vector<bool> processBusy;
+
+    std::atomic<int> numProcessesWanted { 0 };
+    std::atomic<int> consecutiveFailures { 0 };
+    std::atomic<juce::int64> nextJobId { 1 };
+    juce::File workerExecutable;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TranscriptionWorkerPool)
+};
+
+} // namespace VoxScript
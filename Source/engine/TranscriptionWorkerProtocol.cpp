@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+    TranscriptionWorkerProtocol.cpp
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptionWorkerProtocol.h"
+
+namespace VoxScript
+{
+namespace TranscriptionWorkerProtocol
+{
+
+namespace
+{
+    const juce::Identifier messageId ("VOXWORKER");
+    const juce::Identifier typeId ("type");
+    const juce::Identifier jobIdId ("job");
+    const juce::Identifier kindId ("kind");
+    const juce::Identifier ringPathId ("ring");
+    const juce::Identifier modelIdId ("model");
+    const juce::Identifier languageId ("lang");
+    const juce::Identifier offsetId ("offset");
+    const juce::Identifier numSamplesId ("samples");
+    const juce::Identifier succeededId ("ok");
+    const juce::Identifier versionId ("version");
+}
+
+juce::MemoryBlock encode (const Message& message)
+{
+    juce::ValueTree tree (messageId);
+    tree.setProperty (typeId, static_cast<int> (message.type), nullptr);
+    tree.setProperty (jobIdId, message.jobId, nullptr);
+    tree.setProperty (kindId, static_cast<int> (message.kind), nullptr);
+    tree.setProperty (versionId, message.protocolVersion, nullptr);
+
+    if (message.ringPath.isNotEmpty())  tree.setProperty (ringPathId, message.ringPath, nullptr);
+    if (message.modelId.isNotEmpty())   tree.setProperty (modelIdId, message.modelId, nullptr);
+    if (message.language.isNotEmpty())  tree.setProperty (languageId, message.language, nullptr);
+
+    tree.setProperty (offsetId, message.offset, nullptr);
+    tree.setProperty (numSamplesId, message.numSamples, nullptr);
+
+    if (message.type == MessageType::JobResult)
+    {
+        tree.setProperty (succeededId, message.succeeded, nullptr);
+        tree.appendChild (message.result.toValueTree(), nullptr);
+    }
+
+    juce::MemoryOutputStream out;
+    tree.writeToStream (out);
+    return out.getMemoryBlock();
+}
+
+bool decode (const juce::MemoryBlock& data, Message& message)
+{
+    auto tree = juce::ValueTree::readFromData (data.getData(), data.getSize());
+
+    if (!tree.hasType (messageId))
+        return false;
+
+    message = {};
+    message.type = static_cast<MessageType> (static_cast<int> (tree.getProperty (typeId)));
+    message.jobId = static_cast<juce::int64> (tree.getProperty (jobIdId));
+    message.kind = static_cast<JobKind> (static_cast<int> (tree.getProperty (kindId)));
+    message.protocolVersion = tree.getProperty (versionId);
+    message.ringPath = tree.getProperty (ringPathId).toString();
+    message.modelId = tree.getProperty (modelIdId).toString();
+    message.language = tree.getProperty (languageId).toString();
+    message.offset = static_cast<juce::int64> (tree.getProperty (offsetId));
+    message.numSamples = static_cast<juce::int64> (tree.getProperty (numSamplesId));
+    message.succeeded = tree.getProperty (succeededId);
+
+    if (tree.getNumChildren() > 0)
+        message.result.fromValueTree (tree.getChild (0));
+
+    return true;
+}
+
+} // namespace TranscriptionWorkerProtocol
+} // namespace VoxScript
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+    TranscriptionWorkerProtocol.h
+
+    Messages between the plugin and the out-of-process transcription worker.
+    They travel over the juce::ChildProcessCoordinator pipe; the audio
+    itself goes through a SharedAudioRing and only its position is sent.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include "../transcription/VoxSequence.h"
+
+namespace VoxScript
+{
+namespace TranscriptionWorkerProtocol
+{
+
+/** Passed on the worker's command line so it knows it was launched by us. */
+static constexpr const char* commandLineUID = "voxscript-transcription-worker";
+
+/** Bumped when messages change; a worker from another build is not used. */
+static constexpr int version = 1;
+
+enum class MessageType
+{
+    // Plugin -> worker
+    Hello = 1,          // ringPath, version
+    BeginJob,           // jobId, kind, modelId, language, numSamples
+    AudioChunk,         // jobId, offset, numSamples (in the ring)
+    CancelJob,          // jobId
+
+    // Worker -> plugin
+    Ready,              // version
+    ChunkConsumed,      // jobId, numSamples: the ring space can be reused
+    JobResult           // jobId, succeeded, language, result
+};
+
+enum class JobKind
+{
+    Transcribe,
+    DetectLanguage
+};
+
+struct Message
+{
+    MessageType type = MessageType::Hello;
+    juce::int64 jobId = 0;
+    JobKind kind = JobKind::Transcribe;
+
+    juce::String ringPath;
+    juce::String modelId;
+    juce::String language;          // Job language, or the detected one in a result
+
+    juce::int64 offset = 0;
+    juce::int64 numSamples = 0;
+
+    bool succeeded = false;
+    VoxSequence result;
+    int protocolVersion = version;
+};
+
+/** Serialise for the pipe. */
+juce::MemoryBlock encode (const Message& message);
+
+/** False if the data isn't a message of this protocol. */
+bool decode (const juce::MemoryBlock& data, Message& message);
+
+} // namespace TranscriptionWorkerProtocol
+} // namespace VoxScript
@@ -0,0 +1,389 @@
+/*
+  ==============================================================================
+    MelSpectrogram.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "MelSpectrogram.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace VoxScript
+{
+
+namespace
+{
+    constexpr int numBins = MelSpectrogram::fftSize / 2 + 1;
+
+    /**
+     * FFT for real input, N = 400 = 16 * 25, split like whisper.cpp's: a
+     * direct 25-point DFT of each of the 16 interleaved sequences, then four
+     * radix-2 stages. The DFT runs across all 16 sequences at once and each
+     * stage across whole blocks, with tables of the DFT matrix and of each
+     * stage's twiddles, so every inner loop is a FloatVectorOperations call.
+     * Output is split complex. Tables and buffers are made once per analysis.
+     */
+    class Fft400
+    {
+    public:
+        static constexpr int numSequences = 16;
+        static constexpr int dftSize = MelSpectrogram::fftSize / numSequences;
+        static constexpr int numStages = 4;
+
+        Fft400()
+        {
+            constexpr double twoPi = juce::MathConstants<double>::twoPi;
+
+            for (int k = 0; k < dftSize; ++k)
+            {
+                for (int i = 0; i < dftSize; ++i)
+                {
+                    const double angle = twoPi * (double) ((k * i) % dftSize) / (double) dftSize;
+                    dftCos[(size_t) (k * dftSize + i)] = (float) std::cos (angle);
+                    dftSin[(size_t) (k * dftSize + i)] = (float) -std::sin (angle);
+                }
+            }
+
+            // Stage s joins blocks of half = 25 * 2^s into blocks of 2 * half
+            for (int s = 0, half = dftSize; s < numStages; ++s, half *= 2)
+            {
+                auto& stage = twiddles[(size_t) s];
+                stage.re.resize ((size_t) half);
+                stage.im.resize ((size_t) half);
+
+                for (int k = 0; k < half; ++k)
+                {
+                    const double angle = twoPi * (double) k / (double) (2 * half);
+                    stage.re[(size_t) k] = (float) std::cos (angle);
+                    stage.im[(size_t) k] = (float) -std::sin (angle);
+                }
+            }
+        }
+
+        /** re, im: bins 0 to N - 1 */
+        void perform (const float* in, float* re, float* im)
+        {
+            using FVO = juce::FloatVectorOperations;
+
+            // Sequence o is in[o], in[o + 16], ...: row i of the input holds sample
+            // i of all 16. Real input, so bins above 12 are conjugates of those below.
+            constexpr int uniqueBins = dftSize / 2 + 1;
+
+            for (int k = 0; k < uniqueBins; ++k)
+            {
+                auto* rowRe = dftRe.data() + k * numSequences;
+                auto* rowIm = dftIm.data() + k * numSequences;
+                FVO::copy (rowRe, in, numSequences);
+                FVO::clear (rowIm, numSequences);
+
+                for (int i = 1; i < dftSize; ++i)
+                {
+                    FVO::addWithMultiply (rowRe, in + i * numSequences, dftCos[(size_t) (k * dftSize + i)], numSequences);
+                    FVO::addWithMultiply (rowIm, in + i * numSequences, dftSin[(size_t) (k * dftSize + i)], numSequences);
+                }
+            }
+
+            // One block per sequence, ordered by offset
+            auto* blockRe = bufferRe[0].data();
+            auto* blockIm = bufferIm[0].data();
+
+            for (int o = 0; o < numSequences; ++o)
+            {
+                for (int k = 0; k < uniqueBins; ++k)
+                {
+                    blockRe[o * dftSize + k] = dftRe[(size_t) (k * numSequences + o)];
+                    blockIm[o * dftSize + k] = dftIm[(size_t) (k * numSequences + o)];
+                }
+
+                for (int k = uniqueBins; k < dftSize; ++k)
+                {
+                    blockRe[o * dftSize + k] = dftRe[(size_t) ((dftSize - k) * numSequences + o)];
+                    blockIm[o * dftSize + k] = -dftIm[(size_t) ((dftSize - k) * numSequences + o)];
+                }
+            }
+
+            // Block o (even samples) and o + numBlocks / 2 (odd) make block o of the next stage
+            for (int s = 0, numBlocks = numSequences, half = dftSize; s < numStages; ++s, numBlocks /= 2, half *= 2)
+            {
+                const auto& stage = twiddles[(size_t) s];
+                const auto* srcRe = bufferRe[(size_t) (s % 2)].data();
+                const auto* srcIm = bufferIm[(size_t) (s % 2)].data();
+                auto* dstRe = s == numStages - 1 ? re : bufferRe[(size_t) ((s + 1) % 2)].data();
+                auto* dstIm = s == numStages - 1 ? im : bufferIm[(size_t) ((s + 1) % 2)].data();
+
+                for (int o = 0; o < numBlocks / 2; ++o)
+                {
+                    const auto* evenRe = srcRe + o * half;
+                    const auto* evenIm = srcIm + o * half;
+                    const auto* oddRe = srcRe + (o + numBlocks / 2) * half;
+                    const auto* oddIm = srcIm + (o + numBlocks / 2) * half;
+                    auto* outRe = dstRe + o * 2 * half;
+                    auto* outIm = dstIm + o * 2 * half;
+
+                    // t = twiddle * odd
+                    FVO::multiply (scratchRe.data(), stage.re.data(), oddRe, half);
+                    FVO::subtractWithMultiply (scratchRe.data(), stage.im.data(), oddIm, half);
+                    FVO::multiply (scratchIm.data(), stage.re.data(), oddIm, half);
+                    FVO::addWithMultiply (scratchIm.data(), stage.im.data(), oddRe, half);
+
+                    FVO::add (outRe, evenRe, scratchRe.data(), half);
+                    FVO::subtract (outRe + half, evenRe, scratchRe.data(), half);
+                    FVO::add (outIm, evenIm, scratchIm.data(), half);
+                    FVO::subtract (outIm + half, evenIm, scratchIm.data(), half);
+                }
+            }
+        }
+
+    private:
+        struct Twiddles
+        {
+            std::vector<float> re, im;
+        };
+
+        std::array<float, dftSize * dftSize> dftCos {}, dftSin {};
+        std::array<Twiddles, numStages> twiddles;
+
+        std::array<float, (dftSize / 2 + 1) * numSequences> dftRe {}, dftIm {};
+        std::array<std::array<float, MelSpectrogram::fftSize>, 2> bufferRe {}, bufferIm {};
+        std::array<float, MelSpectrogram::fftSize / 2> scratchRe {}, scratchIm {};
+    };
+
+    /** Slaney-style mel filterbank (librosa defaults, as used to build whisper's filters). */
+    struct MelFilterbank
+    {
+        struct Band
+        {
+            int firstBin = 0;
+            std::vector<float> weights;
+        };
+
+        std::array<Band, MelSpectrogram::numBands> bands;
+
+        MelFilterbank()
+        {
+            auto hzToMel = [] (double hz)
+            {
+                constexpr double linearStep = 200.0 / 3.0;
+                constexpr double minLogHz = 1000.0;
+                const double logStep = std::log (6.4) / 27.0;
+                return hz < minLogHz ? hz / linearStep : minLogHz / linearStep + std::log (hz / minLogHz) / logStep;
+            };
+
+            auto melToHz = [] (double mel)
+            {
+                constexpr double linearStep = 200.0 / 3.0;
+                constexpr double minLogHz = 1000.0;
+                constexpr double minLogMel = minLogHz / linearStep;
+                const double logStep = std::log (6.4) / 27.0;
+                return mel < minLogMel ? mel * linearStep : minLogHz * std::exp (logStep * (mel - minLogMel));
+            };
+
+            constexpr int numPoints = MelSpectrogram::numBands + 2;
+            const double maxMel = hzToMel (MelSpectrogram::sampleRate / 2.0);
+            std::array<double, numPoints> edges {};
+
+            for (int i = 0; i < numPoints; ++i)
+                edges[(size_t) i] = melToHz (maxMel * i / (numPoints - 1));
+
+            for (int b = 0; b < MelSpectrogram::numBands; ++b)
+            {
+                const double lower = edges[(size_t) b], centre = edges[(size_t) b + 1], upper = edges[(size_t) b + 2];
+                const double norm = 2.0 / (upper - lower);
+                auto& band = bands[(size_t) b];
+                band.firstBin = -1;
+
+                for (int k = 0; k < numBins; ++k)
+                {
+                    const double hz = (double) k * MelSpectrogram::sampleRate / MelSpectrogram::fftSize;
+                    const double w = juce::jmax (0.0, juce::jmin ((hz - lower) / (centre - lower), (upper - hz) / (upper - centre)));
+
+                    if (w > 0.0)
+                    {
+                        if (band.firstBin < 0)
+                            band.firstBin = k;
+
+                        band.weights.resize ((size_t) (k - band.firstBin + 1), 0.0f);
+                        band.weights.back() = (float) (w * norm);
+                    }
+                }
+
+                band.firstBin = juce::jmax (0, band.firstBin);
+            }
+        }
+    };
+
+    const MelFilterbank& getFilterbank()
+    {
+        static const MelFilterbank filterbank;
+        return filterbank;
+    }
+}
+
+//==============================================================================
+std::shared_ptr<const MelSpectrogram> MelSpectrogram::compute (const float* samples, size_t numSamples,
+                                                               const std::atomic<bool>* shouldCancel)
+{
+    if (samples == nullptr || numSamples == 0)
+        return nullptr;
+
+    std::shared_ptr<MelSpectrogram> result (new MelSpectrogram());
+    result->numFrames = static_cast<int> (numSamples / hopSize) + 1;
+
+    const auto& filterbank = getFilterbank();
+    Fft400 fft;
+
+    // Periodic Hann window, as whisper
+    std::array<float, fftSize> window {};
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t) i] = 0.5f * (1.0f - std::cos (juce::MathConstants<float>::twoPi * (float) i / (float) fftSize));
+
+    std::array<float, fftSize> frame {};
+    std::array<float, fftSize> spectrumRe {}, spectrumIm {};
+    std::array<float, numBins> power {};
+
+    // Frame i is centred on sample i * hop: reflect at the start, zeros after the end
+    auto sampleAt = [&] (juce::int64 index) -> float
+    {
+        if (index < 0)
+            index = -index;
+
+        return index < (juce::int64) numSamples ? samples[index] : 0.0f;
+    };
+
+    for (int tileStart = 0; tileStart < result->numFrames; tileStart += framesPerTile)
+    {
+        if (shouldCancel != nullptr && shouldCancel->load())
+            return nullptr;
+
+        Tile tile;
+        tile.numFrames = juce::jmin (framesPerTile, result->numFrames - tileStart);
+        tile.values.resize ((size_t) (numBands * tile.numFrames));
+
+        for (int f = 0; f < tile.numFrames; ++f)
+        {
+            const auto centre = (juce::int64) (tileStart + f) * hopSize;
+
+            for (int i = 0; i < fftSize; ++i)
+                frame[(size_t) i] = sampleAt (centre - fftSize / 2 + i);
+
+            juce::FloatVectorOperations::multiply (frame.data(), window.data(), fftSize);
+            fft.perform (frame.data(), spectrumRe.data(), spectrumIm.data());
+
+            juce::FloatVectorOperations::multiply (power.data(), spectrumRe.data(), spectrumRe.data(), numBins);
+            juce::FloatVectorOperations::addWithMultiply (power.data(), spectrumIm.data(), spectrumIm.data(), numBins);
+
+            for (int b = 0; b < numBands; ++b)
+            {
+                const auto& band = filterbank.bands[(size_t) b];
+                double sum = 0.0;
+
+                for (size_t w = 0; w < band.weights.size(); ++w)
+                    sum += (double) power[(size_t) band.firstBin + w] * band.weights[w];
+
+                const float logValue = (float) std::log10 (juce::jmax (sum, 1e-10));
+                result->maxLogValue = juce::jmax (result->maxLogValue, logValue);
+                tile.values[(size_t) (b * tile.numFrames + f)]
+                    = (juce::int16) juce::jlimit (-32768, 32767, juce::roundToInt (logValue * quantisationScale));
+            }
+        }
+
+        result->tiles.push_back (std::move (tile));
+    }
+
+    return result;
+}
+
+float MelSpectrogram::getLogValue (int band, int frame) const noexcept
+{
+    if (frame < 0 || frame >= numFrames || band < 0 || band >= numBands)
+        return silenceLogValue;
+
+    const auto& tile = tiles[(size_t) (frame / framesPerTile)];
+    return (float) tile.values[(size_t) (band * tile.numFrames + frame % framesPerTile)] / quantisationScale;
+}
+
+void MelSpectrogram::getWhisperInput (int startFrame, int numFramesOut, std::vector<float>& out) const
+{
+    out.resize ((size_t) (numBands * numFramesOut));
+
+    // whisper_pcm_to_mel: clamp to 8 decades below the maximum, then scale
+    const float floorValue = maxLogValue - 8.0f;
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        for (int f = 0; f < numFramesOut; ++f)
+        {
+            const float v = juce::jmax (getLogValue (b, startFrame + f), floorValue);
+            out[(size_t) (b * numFramesOut + f)] = (v + 4.0f) / 4.0f;
+        }
+    }
+}
+
+juce::Array<juce::Range<double>> MelSpectrogram::findSpeechRegions (float rangeDb, float floorDb,
+                                                                    double minGapSeconds,
+                                                                    double minRegionSeconds) const
+{
+    // Mean level of the bands that carry most speech energy (~100 Hz - 4 kHz)
+    constexpr int firstBand = 2, lastBand = 60;
+
+    std::vector<float> levels ((size_t) numFrames);
+    float loudest = silenceLogValue;
+
+    for (int f = 0; f < numFrames; ++f)
+    {
+        float sum = 0.0f;
+        for (int b = firstBand; b < lastBand; ++b)
+            sum += getLogValue (b, f);
+
+        levels[(size_t) f] = sum / (float) (lastBand - firstBand);
+        loudest = juce::jmax (loudest, levels[(size_t) f]);
+    }
+
+    // log10 power to dB: x10
+    const float threshold = juce::jmax (loudest - rangeDb / 10.0f, floorDb / 10.0f);
+
+    juce::Array<juce::Range<double>> regions;
+    int regionStart = -1;
+
+    for (int f = 0; f <= numFrames; ++f)
+    {
+        const bool active = f < numFrames && levels[(size_t) f] > threshold;
+
+        if (active && regionStart < 0)
+        {
+            regionStart = f;
+        }
+        else if (!active && regionStart >= 0)
+        {
+            juce::Range<double> region (regionStart * secondsPerFrame, f * secondsPerFrame);
+
+            if (!regions.isEmpty() && region.getStart() - regions.getLast().getEnd() < minGapSeconds)
+                regions.getReference (regions.size() - 1).setEnd (region.getEnd());
+            else
+                regions.add (region);
+
+            regionStart = -1;
+        }
+    }
+
+    regions.removeIf ([minRegionSeconds] (const juce::Range<double>& r) { return r.getLength() < minRegionSeconds; });
+    return regions;
+}
+
+juce::int64 MelSpectrogram::getSizeInBytes() const noexcept
+{
+    juce::int64 bytes = sizeof (*this);
+
+    for (const auto& tile : tiles)
+        bytes += (juce::int64) (tile.values.size() * sizeof (juce::int16));
+
+    return bytes;
+}
+
+} // namespace VoxScript
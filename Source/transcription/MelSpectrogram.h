@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+    MelSpectrogram.h
+
+    80-band log-mel spectrogram of 16 kHz analysis audio, computed the way
+    whisper.cpp computes its encoder input (400-point FFT, 160-sample hop,
+    Hann window, Slaney mel filters, log10 power). One instance per source
+    serves the Detail View spectrogram, the voice activity detection, and
+    the whisper calls that take a mel directly (the language probe and the
+    beam re-decode windows, via whisper_set_mel). whisper_full always
+    computes its own mel from the samples, so the main pass doesn't use it.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Immutable log-mel spectrogram, stored in 30 s tiles.
+ *
+ * Values are log10 power per band and frame, quantised to 16 bit
+ * (about 0.0005 resolution) to keep long sources small: 16 KB per second.
+ *
+ * Thread Safety:
+ * - compute() may run on any background thread.
+ * - A computed spectrogram is read-only and safe to share between threads.
+ */
+class MelSpectrogram
+{
+public:
+    static constexpr int sampleRate = 16000;
+    static constexpr int numBands = 80;
+    static constexpr int fftSize = 400;
+    static constexpr int hopSize = 160;
+    static constexpr int framesPerTile = 3000; // One whisper window (30 s)
+    static constexpr double secondsPerFrame = static_cast<double> (hopSize) / sampleRate;
+
+    /** log10 of whisper's power floor (1e-10): the value of digital silence. */
+    static constexpr float silenceLogValue = -10.0f;
+
+    /**
+     * Compute the spectrogram of mono 16 kHz samples.
+     * @return nullptr if cancelled or there are no samples
+     */
+    static std::shared_ptr<const MelSpectrogram> compute (const float* samples, size_t numSamples,
+                                                          const std::atomic<bool>* shouldCancel = nullptr);
+
+    int getNumFrames() const noexcept { return numFrames; }
+    double getDurationSeconds() const noexcept { return numFrames * secondsPerFrame; }
+
+    /** log10 power of one band (0 = lowest) in one frame. */
+    float getLogValue (int band, int frame) const noexcept;
+
+    /** Largest value over the whole source; whisper normalises against it. */
+    float getMaxLogValue() const noexcept { return maxLogValue; }
+
+    /**
+     * Whisper encoder input for a range of frames: band-major
+     * (out[band * numFramesOut + frame]), clamped and scaled exactly like
+     * whisper_pcm_to_mel, padded with silence past the end of the audio.
+     */
+    void getWhisperInput (int startFrame, int numFramesOut, std::vector<float>& out) const;
+
+    /**
+     * Energy-based voice activity detection.
+     * A frame is active when its mean speech-band level is within rangeDb of
+     * the loudest frame and above floorDb; gaps shorter than minGapSeconds
+     * are bridged, regions shorter than minRegionSeconds are dropped.
+     * @return Active regions in seconds
+     */
+    juce::Array<juce::Range<double>> findSpeechRegions (float rangeDb = 40.0f, float floorDb = -55.0f,
+                                                        double minGapSeconds = 0.3,
+                                                        double minRegionSeconds = 0.1) const;
+
+    /** Approximate memory held. */
+    juce::int64 getSizeInBytes() const noexcept;
+
+private:
+    MelSpectrogram() = default;
+
+    struct Tile
+    {
+        std::vector<juce::int16> values; // Band-major: values[band * numFrames + frame]
+        int numFrames = 0;
+    };
+
+    static constexpr float quantisationScale = 2048.0f;
+
+    std::vector<Tile> tiles;
+    int numFrames = 0;
+    float maxLogValue = silenceLogValue;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MelSpectrogram)
+};
+
+} // namespace VoxScript
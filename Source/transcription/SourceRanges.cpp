@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+    SourceRanges.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "SourceRanges.h"
+#include <algorithm>
+
+namespace VoxScript
+{
+
+namespace
+{
+    constexpr double packedSampleRate = 16000.0;
+
+    size_t toSample (double seconds) noexcept
+    {
+        return static_cast<size_t> (juce::jmax (0.0, seconds) * packedSampleRate);
+    }
+}
+
+SourceRanges::RangeList SourceRanges::normalise (RangeList ranges, double mergeGapSeconds)
+{
+    std::sort (ranges.begin(), ranges.end(),
+               [] (const juce::Range<double>& a, const juce::Range<double>& b) { return a.getStart() < b.getStart(); });
+
+    RangeList merged;
+
+    for (const auto& range : ranges)
+    {
+        if (range.isEmpty())
+            continue;
+
+        if (!merged.isEmpty() && range.getStart() <= merged.getReference (merged.size() - 1).getEnd() + mergeGapSeconds)
+        {
+            auto& last = merged.getReference (merged.size() - 1);
+            last = last.withEnd (juce::jmax (last.getEnd(), range.getEnd()));
+        }
+        else
+        {
+            merged.add (range);
+        }
+    }
+
+    return merged;
+}
+
+SourceRanges::RangeList SourceRanges::subtract (const RangeList& from, const RangeList& toRemove)
+{
+    RangeList result;
+
+    for (auto range : normalise (from))
+    {
+        for (const auto& removed : normalise (toRemove))
+        {
+            if (removed.getEnd() <= range.getStart() || removed.getStart() >= range.getEnd())
+                continue;
+
+            if (removed.getStart() > range.getStart())
+                result.add ({ range.getStart(), removed.getStart() });
+
+            range = range.withStart (juce::jmin (range.getEnd(), removed.getEnd()));
+        }
+
+        if (!range.isEmpty())
+            result.add (range);
+    }
+
+    return result;
+}
+
+bool SourceRanges::covers (const RangeList& ranges, const RangeList& subset)
+{
+    // Tolerate rounding at the edges (ranges come from sample positions)
+    constexpr double tolerance = 0.001;
+    return getTotalLength (subtract (subset, ranges)) < tolerance;
+}
+
+double SourceRanges::getTotalLength (const RangeList& ranges) noexcept
+{
+    double total = 0.0;
+
+    for (const auto& range : ranges)
+        total += range.getLength();
+
+    return total;
+}
+
+juce::String SourceRanges::toString (const RangeList& ranges)
+{
+    juce::StringArray parts;
+
+    for (const auto& range : ranges)
+        parts.add (juce::String (range.getStart(), 2) + "-" + juce::String (range.getEnd(), 2));
+
+    return parts.joinIntoString (",");
+}
+
+bool SourceRanges::contains (const RangeList& ranges, double time) noexcept
+{
+    return std::any_of (ranges.begin(), ranges.end(), [time] (const juce::Range<double>& r) { return r.contains (time); });
+}
+
+void SourceRanges::pack (const std::vector<float>& sourcePcm, const RangeList& ranges, std::vector<float>& packed)
+{
+    packed.clear();
+
+    for (const auto& range : ranges)
+    {
+        const auto first = juce::jmin (sourcePcm.size(), toSample (range.getStart()));
+        const auto last = juce::jmin (sourcePcm.size(), toSample (range.getEnd()));
+
+        if (!packed.empty())
+            packed.insert (packed.end(), toSample (guardSeconds), 0.0f);
+
+        packed.insert (packed.end(), sourcePcm.begin() + static_cast<std::ptrdiff_t> (first),
+                                     sourcePcm.begin() + static_cast<std::ptrdiff_t> (last));
+    }
+}
+
+VoxSequence SourceRanges::unpack (const VoxSequence& packedResult, const RangeList& ranges)
+{
+    // Where each range starts in the packed buffer (same rounding as pack())
+    std::vector<juce::Range<double>> packedRanges;
+    size_t position = 0;
+
+    for (const auto& range : ranges)
+    {
+        if (!packedRanges.empty())
+            position += toSample (guardSeconds);
+
+        const auto length = toSample (range.getEnd()) - juce::jmin (toSample (range.getEnd()), toSample (range.getStart()));
+        packedRanges.push_back ({ position / packedSampleRate, (position + length) / packedSampleRate });
+        position += length;
+    }
+
+    VoxSequence result;
+
+    for (const auto& segment : packedResult.getSegments())
+    {
+        VoxSegment mapped;
+        int currentRange = -1;
+
+        auto flush = [&]
+        {
+            if (!mapped.words.isEmpty())
+            {
+                mapped.startTime = mapped.words.getFirst().startTime;
+                mapped.endTime = mapped.words.getLast().endTime;
+                result.addSegment (mapped);
+            }
+
+            mapped = {};
+        };
+
+        for (auto word : segment.words)
+        {
+            const double centre = 0.5 * (word.startTime + word.endTime);
+            int index = -1;
+
+            for (size_t k = 0; k < packedRanges.size(); ++k)
+                if (packedRanges[k].contains (centre))
+                    index = static_cast<int> (k);
+
+            if (index < 0)
+                continue; // Heard in the silence between ranges
+
+            // A segment never spans two ranges in source time
+            if (index != currentRange)
+                flush();
+
+            currentRange = index;
+
+            const double offset = ranges.getReference (index).getStart() - packedRanges[(size_t) index].getStart();
+            word.startTime += offset;
+            word.endTime += offset;
+            mapped.text += word.text;
+            mapped.words.add (word);
+        }
+
+        flush();
+    }
+
+    return result;
+}
+
+VoxSequence SourceRanges::splice (const VoxSequence& base, const VoxSequence& partial, const RangeList& ranges)
+{
+    juce::Array<VoxSegment> segments;
+
+    for (const auto& segment : base.getSegments())
+        if (!contains (ranges, 0.5 * (segment.startTime + segment.endTime)))
+            segments.add (segment);
+
+    for (const auto& segment : partial.getSegments())
+        segments.add (segment);
+
+    std::stable_sort (segments.begin(), segments.end(),
+                      [] (const VoxSegment& a, const VoxSegment& b) { return a.startTime < b.startTime; });
+
+    VoxSequence result;
+
+    for (const auto& segment : segments)
+        result.addSegment (segment);
+
+    return result;
+}
+
+} // namespace VoxScript
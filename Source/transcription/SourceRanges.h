@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+    SourceRanges.h
+
+    Sets of time ranges within an audio source, and the packing that lets
+    whisper transcribe only those ranges. Hosts often use a few seconds of
+    a long recording; the parts the playback regions play are packed into
+    one buffer with silence between them, and the result is mapped back to
+    source time and spliced into the source's transcript.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "VoxSequence.h"
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Helpers for lists of source time ranges (seconds).
+ *
+ * A RangeList is kept sorted and non-overlapping (see normalise()); an
+ * empty list means "the whole source" wherever a job or file is concerned.
+ *
+ * Packed layout: [range 0][guard][range 1][guard]... at 16 kHz, the guards
+ * being guardSeconds of silence so whisper doesn't run words of two ranges
+ * together.
+ */
+class SourceRanges
+{
+public:
+    using RangeList = juce::Array<juce::Range<double>>;
+
+    /** Silence between packed ranges. */
+    static constexpr double guardSeconds = 1.0;
+
+    /** Sorted, with overlapping ranges (or ranges closer than mergeGapSeconds) joined. */
+    static RangeList normalise (RangeList ranges, double mergeGapSeconds = 0.0);
+
+    /** Parts of from that are not in toRemove. */
+    static RangeList subtract (const RangeList& from, const RangeList& toRemove);
+
+    /** True if every range of subset lies within ranges. */
+    static bool covers (const RangeList& ranges, const RangeList& subset);
+
+    static double getTotalLength (const RangeList& ranges) noexcept;
+
+    /** Short text form, e.g. "0.00-12.50,60.00-75.25" (for cache keys and logs). */
+    static juce::String toString (const RangeList& ranges);
+
+    /** Copy the ranges out of 16 kHz source audio, with guards between them. */
+    static void pack (const std::vector<float>& sourcePcm, const RangeList& ranges, std::vector<float>& packed);
+
+    /** Map a transcript of pack()ed audio back to source time; words in the guards are dropped. */
+    static VoxSequence unpack (const VoxSequence& packedResult, const RangeList& ranges);
+
+    /**
+     * Replace what base says inside the ranges with partial (source time).
+     * Segments are assigned by their midpoint; the result is in time order.
+     */
+    static VoxSequence splice (const VoxSequence& base, const VoxSequence& partial, const RangeList& ranges);
+
+private:
+    static bool contains (const RangeList& ranges, double time) noexcept;
+
+    SourceRanges() = delete;
+};
+
+} // namespace VoxScript
@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+    TranscriptStitcher.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptStitcher.h"
+#include <cmath>
+#include <limits>
+
+namespace VoxScript
+{
+
+std::vector<juce::Range<double>> TranscriptStitcher::planWindows (double totalSeconds, double windowSeconds,
+                                                                  double overlapSeconds)
+{
+    std::vector<juce::Range<double>> windows;
+
+    if (totalSeconds <= 0.0 || windowSeconds <= 0.0)
+        return windows;
+
+    // Overlap can't eat the whole window, or the plan never advances
+    overlapSeconds = juce::jlimit (0.0, windowSeconds * 0.5, overlapSeconds);
+
+    for (double start = 0.0; ; start += windowSeconds - overlapSeconds)
+    {
+        const double end = juce::jmin (totalSeconds, start + windowSeconds);
+        windows.push_back ({ start, end });
+
+        if (end >= totalSeconds)
+            break;
+    }
+
+    return windows;
+}
+
+void TranscriptStitcher::addWindow (const VoxSequence& windowResult, juce::Range<double> window)
+{
+    auto incoming = windowResult.getSegments().toArray();
+
+    if (!hasWindow || segments.isEmpty() || window.getStart() >= previousWindow.getEnd())
+    {
+        // Nothing to overlap with
+        segments.addArray (incoming);
+    }
+    else
+    {
+        const auto newWords = flatten (incoming);
+        const auto oldWords = flatten (segments);
+        const auto seam = findSeam (oldWords, incoming, newWords, window);
+
+        // Old side: keep words up to the seam (and the matched word, unless
+        // the new window's copy of it is better)
+        const int oldEnd = seam.lastOldWord + (seam.useNewCopyOfMatch ? 0 : 1);
+
+        for (int s = segments.size(); --s >= 0;)
+        {
+            int firstDropped = segments.getReference (s).words.size();
+
+            for (int i = juce::jmax (0, oldEnd); i < static_cast<int> (oldWords.size()); ++i)
+                if (oldWords[static_cast<size_t> (i)].segment == s)
+                    firstDropped = juce::jmin (firstDropped, oldWords[static_cast<size_t> (i)].word);
+
+            trimSegment (segments.getReference (s), 0, firstDropped);
+
+            if (segments.getReference (s).words.isEmpty())
+                segments.remove (s);
+        }
+
+        // New side: everything from the seam on
+        const int newStart = seam.firstNewWord - (seam.useNewCopyOfMatch ? 1 : 0);
+
+        for (int s = 0; s < incoming.size(); ++s)
+        {
+            int firstKept = incoming.getReference (s).words.size();
+
+            for (int i = juce::jmax (0, newStart); i < static_cast<int> (newWords.size()); ++i)
+                if (newWords[static_cast<size_t> (i)].segment == s)
+                {
+                    firstKept = newWords[static_cast<size_t> (i)].word;
+                    break;
+                }
+
+            trimSegment (incoming.getReference (s), firstKept, incoming.getReference (s).words.size());
+
+            if (!incoming.getReference (s).words.isEmpty())
+                segments.add (incoming.getReference (s));
+        }
+    }
+
+    previousWindow = window;
+    hasWindow = true;
+}
+
+int TranscriptStitcher::getNumSettledSegments (double nextWindowStart) const noexcept
+{
+    const double limit = nextWindowStart - maxMatchDistanceSeconds;
+    int numSettled = 0;
+
+    while (numSettled < segments.size() && segments.getReference (numSettled).endTime < limit)
+        ++numSettled;
+
+    return numSettled;
+}
+
+TranscriptStitcher::Seam TranscriptStitcher::findSeam (const std::vector<WordRef>& oldWords,
+                                                       const juce::Array<VoxSegment>& incoming,
+                                                       const std::vector<WordRef>& newWords,
+                                                       juce::Range<double> window) const
+{
+    const juce::Range<double> overlap (window.getStart(), juce::jmax (window.getStart(), previousWindow.getEnd()));
+    const double cut = overlap.getStart() + 0.5 * overlap.getLength();
+
+    auto oldWord = [&] (int i) -> const VoxWord& { return segments.getReference (oldWords[static_cast<size_t> (i)].segment).words.getReference (oldWords[static_cast<size_t> (i)].word); };
+    auto newWord = [&] (int i) -> const VoxWord& { return incoming.getReference (newWords[static_cast<size_t> (i)].segment).words.getReference (newWords[static_cast<size_t> (i)].word); };
+
+    // Anchor: a word both windows heard at (about) the same time. The one
+    // closest to the middle of the overlap is furthest from both windows'
+    // edges, where words get cut or invented.
+    Seam best;
+    double bestDistance = std::numeric_limits<double>::max();
+    bool anchored = false;
+
+    for (int i = 0; i < static_cast<int> (oldWords.size()); ++i)
+    {
+        const auto& a = oldWord (i);
+        if (a.endTime < overlap.getStart() - maxMatchDistanceSeconds)
+            continue;
+
+        const auto textA = normalise (a.text);
+        if (textA.isEmpty())
+            continue;
+
+        for (int j = 0; j < static_cast<int> (newWords.size()); ++j)
+        {
+            const auto& b = newWord (j);
+            if (b.startTime > overlap.getEnd() + maxMatchDistanceSeconds)
+                break;
+
+            if (std::abs (centre (a) - centre (b)) > maxMatchDistanceSeconds || normalise (b.text) != textA)
+                continue;
+
+            const double distance = std::abs (0.5 * (centre (a) + centre (b)) - cut);
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best.lastOldWord = i;
+                best.firstNewWord = j + 1;
+                best.useNewCopyOfMatch = b.confidence > a.confidence;
+                anchored = true;
+            }
+        }
+    }
+
+    if (anchored)
+        return best;
+
+    // No shared word: cut in the middle of the overlap, each word going to
+    // the window that saw more of it
+    Seam timed;
+    for (int i = 0; i < static_cast<int> (oldWords.size()); ++i)
+        if (centre (oldWord (i)) < cut)
+            timed.lastOldWord = i;
+
+    timed.firstNewWord = static_cast<int> (newWords.size());
+    for (int j = 0; j < static_cast<int> (newWords.size()); ++j)
+    {
+        if (centre (newWord (j)) >= cut)
+        {
+            timed.firstNewWord = j;
+            break;
+        }
+    }
+
+    return timed;
+}
+
+juce::String TranscriptStitcher::getPromptText (int maxWords) const
+{
+    juce::StringArray tail;
+
+    for (int s = segments.size(); --s >= 0 && tail.size() < maxWords;)
+    {
+        const auto& words = segments.getReference (s).words;
+
+        for (int w = words.size(); --w >= 0 && tail.size() < maxWords;)
+            tail.insert (0, words.getReference (w).text.trim());
+    }
+
+    tail.removeEmptyStrings();
+    return tail.joinIntoString (" ");
+}
+
+VoxSequence TranscriptStitcher::getResult() const
+{
+    VoxSequence sequence;
+
+    for (const auto& segment : segments)
+        sequence.addSegment (segment);
+
+    return sequence;
+}
+
+void TranscriptStitcher::resume (const Progress& progress)
+{
+    reset();
+
+    segments = progress.stitched.getSegments().toArray();
+    previousWindow = progress.lastWindow;
+    hasWindow = !progress.lastWindow.isEmpty();
+}
+
+void TranscriptStitcher::reset()
+{
+    segments.clear();
+    previousWindow = {};
+    hasWindow = false;
+}
+
+//==============================================================================
+std::vector<TranscriptStitcher::WordRef> TranscriptStitcher::flatten (const juce::Array<VoxSegment>& segmentList)
+{
+    std::vector<WordRef> refs;
+
+    for (int s = 0; s < segmentList.size(); ++s)
+        for (int w = 0; w < segmentList.getReference (s).words.size(); ++w)
+            refs.push_back ({ s, w });
+
+    return refs;
+}
+
+juce::String TranscriptStitcher::normalise (const juce::String& wordText)
+{
+    // "Hello," and " hello" are the same word
+    auto stripped = wordText.toLowerCase().removeCharacters (" .,!?;:\"()-");
+    return stripped.isNotEmpty() ? stripped : wordText.trim();
+}
+
+void TranscriptStitcher::trimSegment (VoxSegment& segment, int firstWord, int endWord)
+{
+    const int numWords = segment.words.size();
+    firstWord = juce::jlimit (0, numWords, firstWord);
+    endWord = juce::jlimit (firstWord, numWords, endWord);
+
+    if (firstWord == 0 && endWord == numWords)
+        return;
+
+    segment.words.removeRange (endWord, numWords - endWord);
+    segment.words.removeRange (0, firstWord);
+
+    if (segment.words.isEmpty())
+        return;
+
+    // Text and bounds follow the words that are left
+    segment.text = {};
+    for (const auto& word : segment.words)
+        segment.text += word.text;
+
+    segment.startTime = segment.words.getFirst().startTime;
+    segment.endTime = juce::jmax (segment.words.getFirst().startTime, segment.words.getLast().endTime);
+}
+
+} // namespace VoxScript
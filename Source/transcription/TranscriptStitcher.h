@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+    TranscriptStitcher.h
+
+    Joins transcripts of overlapping audio windows into one sequence.
+    Words that both windows heard in the overlap are matched by text and
+    time; the seam goes through the best match and keeps whichever copy
+    was decoded more confidently, so neither window's ragged edge (cut
+    or repeated words) ends up in the result.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "VoxSequence.h"
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Incremental stitcher for windowed transcription.
+ *
+ * Usage: planWindows() splits a source; each window's result (times relative
+ * to the source) is passed to addWindow() in order. getPromptText() gives the
+ * tail of what has been stitched so far, to condition the next window's
+ * decoder on it (whisper's initial_prompt).
+ *
+ * Thread Safety:
+ * - None; one stitcher per job.
+ */
+class TranscriptStitcher
+{
+public:
+    /** Overlap between neighbouring windows; enough to hold one or two words. */
+    static constexpr double defaultOverlapSeconds = 1.0;
+
+    /** Words further apart than this (centre to centre) are never the same word. */
+    static constexpr double maxMatchDistanceSeconds = 0.4;
+
+    /**
+     * Windows of windowSeconds covering [0, totalSeconds), each starting
+     * overlapSeconds before the previous one ends. The last window is
+     * shortened rather than padded.
+     */
+    static std::vector<juce::Range<double>> planWindows (double totalSeconds, double windowSeconds,
+                                                         double overlapSeconds = defaultOverlapSeconds);
+
+    /**
+     * Append one window's transcript.
+     * @param windowResult Segments with times relative to the source
+     * @param window       The audio range the window covered
+     */
+    void addWindow (const VoxSequence& windowResult, juce::Range<double> window);
+
+    /** The last few stitched words, as a decoder prompt (empty at the start). */
+    juce::String getPromptText (int maxWords = 32) const;
+
+    /** Everything stitched so far. */
+    VoxSequence getResult() const;
+
+    /** The stitched segments, without a copy. */
+    const juce::Array<VoxSegment>& getSegments() const noexcept { return segments; }
+
+    /**
+     * Number of leading segments no later window can change: those ending
+     * before the seam search of a window starting at nextWindowStart reaches.
+     */
+    int getNumSettledSegments (double nextWindowStart) const noexcept;
+
+    /** What a stitcher has done so far; enough to continue in another one. */
+    struct Progress
+    {
+        VoxSequence stitched;
+        juce::Range<double> lastWindow; // Last window added
+        int numSettled = 0;             // Leading segments of stitched no later window changes
+    };
+
+    Progress getProgress() const
+    {
+        return { getResult(), previousWindow, getNumSettledSegments (previousWindow.getEnd() - defaultOverlapSeconds) };
+    }
+
+    /**
+     * Continue from getProgress() of another stitcher, e.g. after a job was
+     * interrupted. The next window to add is the one after progress.lastWindow.
+     */
+    void resume (const Progress& progress);
+
+    void reset();
+
+private:
+    /** Where the new window takes over: last kept old word, first kept new word. */
+    struct Seam
+    {
+        int lastOldWord = -1;    // Index into the flattened old words; -1 keeps none
+        int firstNewWord = 0;    // Index into the flattened new words
+        bool useNewCopyOfMatch = false;
+    };
+
+    struct WordRef
+    {
+        int segment = 0;
+        int word = 0;
+    };
+
+    static std::vector<WordRef> flatten (const juce::Array<VoxSegment>& segmentList);
+    static juce::String normalise (const juce::String& wordText);
+    static double centre (const VoxWord& word) noexcept { return 0.5 * (word.startTime + word.endTime); }
+
+    Seam findSeam (const std::vector<WordRef>& oldWords, const juce::Array<VoxSegment>& incoming,
+                   const std::vector<WordRef>& newWords, juce::Range<double> window) const;
+
+    /** Keep only words [firstWord, endWord); text and times follow them. */
+    static void trimSegment (VoxSegment& segment, int firstWord, int endWord);
+
+    juce::Array<VoxSegment> segments;
+    juce::Range<double> previousWindow;
+    bool hasWindow = false;
+};
+
+} // namespace VoxScript
@@ -0,0 +1,370 @@
+/*
+  ==============================================================================
+    TranscriptionResultCache.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "TranscriptionResultCache.h"
+#include "WhisperModelCatalogue.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <algorithm>
+#include <cstring>
+
+namespace VoxScript
+{
+
+namespace
+{
+    constexpr juce::uint32 entryMagic = 0x43545856; // "VXTC"
+    constexpr const char* entryExtension = ".vxtc";
+    constexpr const char* languageExtension = ".vxtl";
+    constexpr const char* allEntriesPattern = "*.vxtc;*.vxtl";
+
+    /** 64-bit FNV-1a; fast and stable across platforms and runs. */
+    struct Fnv1a
+    {
+        juce::uint64 hash = 0xcbf29ce484222325ULL;
+
+        void add (const void* data, size_t numBytes) noexcept
+        {
+            auto* bytes = static_cast<const juce::uint8*> (data);
+
+            for (size_t i = 0; i < numBytes; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ULL;
+            }
+        }
+
+        juce::String toString() const { return juce::String::toHexString ((juce::int64) hash).paddedLeft ('0', 16); }
+    };
+
+    /** Start of a fingerprint: the format, then the samples (see fingerprintAudioFile()). */
+    void addFormat (Fnv1a& h, juce::int64 sampleRate, juce::int64 numChannels, juce::int64 lengthInSamples)
+    {
+        h.add (&sampleRate, sizeof (sampleRate));
+        h.add (&numChannels, sizeof (numChannels));
+        h.add (&lengthInSamples, sizeof (lengthInSamples));
+    }
+
+    void addQuantised (Fnv1a& h, const float* samples, int numSamples, std::vector<juce::int16>& quantised)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            quantised[(size_t) i] = (juce::int16) juce::roundToInt (juce::jlimit (-1.0f, 1.0f, samples[i]) * 32767.0f);
+
+        h.add (quantised.data(), (size_t) numSamples * sizeof (juce::int16));
+    }
+
+    /** A language entry sits next to the results of the same audio and model. */
+    juce::File getLanguageFile (const juce::String& contentHash, const juce::String& modelId)
+    {
+        const TranscriptionCacheKey key { contentHash, modelId, "language" };
+        return TranscriptionResultCache::getCacheDirectory().getChildFile (key.getFileName()).withFileExtension (languageExtension);
+    }
+}
+
+//==============================================================================
+juce::String TranscriptionCacheKey::getFileName() const
+{
+    Fnv1a h;
+
+    for (const auto* part : { &contentHash, &modelId, &decodeSignature })
+    {
+        auto utf8 = part->toRawUTF8();
+        h.add (utf8, std::strlen (utf8) + 1); // Include the terminator as a separator
+    }
+
+    return h.toString() + entryExtension;
+}
+
+//==============================================================================
+TranscriptionResultCache::TranscriptionResultCache()
+{
+    getCacheDirectory().createDirectory();
+}
+
+juce::File TranscriptionResultCache::getCacheDirectory()
+{
+    // Next to the models folder: <AppData>/VoxScript/cache/transcripts
+    return WhisperModelCatalogue::getModelsDirectory().getParentDirectory()
+               .getChildFile ("cache").getChildFile ("transcripts");
+}
+
+juce::String TranscriptionResultCache::fingerprintAudioFile (const juce::File& audioFile)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (audioFile));
+
+    if (reader == nullptr)
+        return {};
+
+    Fnv1a h;
+
+    const auto lengthInSamples = reader->lengthInSamples;
+    addFormat (h, (juce::int64) reader->sampleRate, (juce::int64) reader->numChannels, lengthInSamples);
+
+    // Hash samples quantised to 16 bit, so a different container bit depth
+    // of the same audio still matches
+    constexpr int blockSize = 32768;
+    juce::AudioBuffer<float> block ((int) reader->numChannels, blockSize);
+    std::vector<juce::int16> quantised ((size_t) blockSize);
+
+    for (juce::int64 pos = 0; pos < lengthInSamples; pos += blockSize)
+    {
+        const int numSamples = (int) juce::jmin ((juce::int64) blockSize, lengthInSamples - pos);
+        reader->read (&block, 0, numSamples, pos, true, true);
+
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            addQuantised (h, block.getReadPointer (ch), numSamples, quantised);
+    }
+
+    return h.toString();
+}
+
+juce::String TranscriptionResultCache::getFingerprint (const juce::File& audioFile, const std::vector<float>* pcm16k)
+{
+    const auto identity = audioFile.getFullPathName() + "|" + juce::String (audioFile.getSize())
+                        + "|" + juce::String (audioFile.getLastModificationTime().toMilliseconds());
+
+    {
+        std::lock_guard<std::mutex> guard (fingerprintLock);
+
+        auto it = fingerprints.find (identity);
+        if (it != fingerprints.end())
+            return it->second;
+    }
+
+    juce::String fingerprint;
+
+    if (pcm16k != nullptr && !pcm16k->empty())
+    {
+        // Only the header is read here. For a 16 kHz mono file, readPcm16k()
+        // returns the reader's samples unchanged, so they hash the same.
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (audioFile));
+
+        if (reader != nullptr && reader->sampleRate == 16000.0 && reader->numChannels == 1
+            && reader->lengthInSamples == (juce::int64) pcm16k->size())
+        {
+            Fnv1a h;
+            addFormat (h, 16000, 1, reader->lengthInSamples);
+
+            constexpr int blockSize = 32768;
+            std::vector<juce::int16> quantised ((size_t) blockSize);
+
+            for (size_t pos = 0; pos < pcm16k->size(); pos += blockSize)
+                addQuantised (h, pcm16k->data() + pos, (int) juce::jmin ((size_t) blockSize, pcm16k->size() - pos), quantised);
+
+            fingerprint = h.toString();
+        }
+    }
+
+    if (fingerprint.isEmpty())
+        fingerprint = fingerprintAudioFile (audioFile);
+
+    if (fingerprint.isNotEmpty())
+    {
+        std::lock_guard<std::mutex> guard (fingerprintLock);
+
+        if (fingerprints.size() >= maxFingerprints)
+            fingerprints.clear(); // Job files are temporary; old ones won't be asked for again
+
+        fingerprints[identity] = fingerprint;
+    }
+
+    return fingerprint;
+}
+
+std::optional<VoxSequence> TranscriptionResultCache::lookup (const TranscriptionCacheKey& key)
+{
+    if (!key.isValid() || getMaxSizeBytes() <= 0)
+        return std::nullopt;
+
+    auto file = getCacheDirectory().getChildFile (key.getFileName());
+
+    if (!file.existsAsFile())
+        return std::nullopt;
+
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData (data))
+        return std::nullopt;
+
+    juce::MemoryInputStream in (data, false);
+
+    const auto magic = (juce::uint32) in.readInt();
+    const auto version = (juce::uint32) in.readInt();
+    const auto payloadSize = in.readInt64();
+    const auto checksum = (juce::uint64) in.readInt64();
+
+    auto isValidEntry = [&]
+    {
+        if (magic != entryMagic || version != formatVersion)
+            return false;
+
+        if (payloadSize < 0 || payloadSize != in.getNumBytesRemaining())
+            return false;
+
+        Fnv1a h;
+        h.add (static_cast<const char*> (data.getData()) + in.getPosition(), (size_t) payloadSize);
+        return h.hash == checksum;
+    };
+
+    VoxSequence sequence;
+
+    if (!isValidEntry() || !sequence.fromValueTree (juce::ValueTree::readFromStream (in)))
+    {
+        DBG ("TranscriptionResultCache: Discarding stale or corrupt entry " + file.getFileName());
+        file.deleteFile();
+        return std::nullopt;
+    }
+
+    // Keep recently used entries out of the way of trimLocked()
+    file.setLastModificationTime (juce::Time::getCurrentTime());
+
+    return sequence;
+}
+
+void TranscriptionResultCache::store (const TranscriptionCacheKey& key, const VoxSequence& sequence)
+{
+    if (!key.isValid() || sequence.getWordCount() == 0)
+        return;
+
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (maxSizeBytes <= 0)
+        return;
+
+    juce::MemoryOutputStream payload;
+    sequence.toValueTree().writeToStream (payload);
+
+    Fnv1a h;
+    h.add (payload.getData(), payload.getDataSize());
+
+    auto dir = getCacheDirectory();
+    dir.createDirectory();
+
+    // Write next to the target and move into place: readers see the old
+    // entry or the complete new one, never a partial file.
+    juce::TemporaryFile temp (dir.getChildFile (key.getFileName()));
+
+    {
+        juce::FileOutputStream out (temp.getFile());
+
+        if (!out.openedOk())
+            return;
+
+        out.writeInt ((int) entryMagic);
+        out.writeInt ((int) formatVersion);
+        out.writeInt64 ((juce::int64) payload.getDataSize());
+        out.writeInt64 ((juce::int64) h.hash);
+        out.write (payload.getData(), payload.getDataSize());
+        out.flush();
+
+        if (out.getStatus().failed())
+            return;
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+    {
+        DBG ("TranscriptionResultCache: Failed to write entry " + key.getFileName());
+        return;
+    }
+
+    trimLocked();
+}
+
+juce::String TranscriptionResultCache::lookupLanguage (const juce::String& contentHash, const juce::String& modelId)
+{
+    if (contentHash.isEmpty() || getMaxSizeBytes() <= 0)
+        return {};
+
+    auto file = getLanguageFile (contentHash, modelId);
+
+    if (!file.existsAsFile())
+        return {};
+
+    // A language code is a few ASCII letters; anything else is a torn write
+    const auto language = file.loadFileAsString().trim();
+
+    if (language.isEmpty() || language.length() > 8 || !language.containsOnly ("abcdefghijklmnopqrstuvwxyz"))
+    {
+        file.deleteFile();
+        return {};
+    }
+
+    file.setLastModificationTime (juce::Time::getCurrentTime());
+    return language;
+}
+
+void TranscriptionResultCache::storeLanguage (const juce::String& contentHash, const juce::String& modelId, const juce::String& language)
+{
+    if (contentHash.isEmpty() || language.isEmpty())
+        return;
+
+    std::lock_guard<std::mutex> guard (lock);
+
+    if (maxSizeBytes <= 0)
+        return;
+
+    getCacheDirectory().createDirectory();
+
+    if (!getLanguageFile (contentHash, modelId).replaceWithText (language))
+        DBG ("TranscriptionResultCache: Failed to write language for " + contentHash);
+}
+
+void TranscriptionResultCache::setMaxSizeBytes (juce::int64 newMaxSize)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    maxSizeBytes = juce::jmax ((juce::int64) 0, newMaxSize);
+    trimLocked();
+}
+
+juce::int64 TranscriptionResultCache::getMaxSizeBytes() const
+{
+    std::lock_guard<std::mutex> guard (lock);
+    return maxSizeBytes;
+}
+
+void TranscriptionResultCache::clear()
+{
+    std::lock_guard<std::mutex> guard (lock);
+
+    for (const auto& file : getCacheDirectory().findChildFiles (juce::File::findFiles, false, allEntriesPattern))
+        file.deleteFile();
+}
+
+void TranscriptionResultCache::trimLocked()
+{
+    auto files = getCacheDirectory().findChildFiles (juce::File::findFiles, false, allEntriesPattern);
+
+    juce::int64 totalSize = 0;
+    for (const auto& file : files)
+        totalSize += file.getSize();
+
+    if (totalSize <= maxSizeBytes)
+        return;
+
+    std::sort (files.begin(), files.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (const auto& file : files)
+    {
+        if (totalSize <= maxSizeBytes)
+            break;
+
+        totalSize -= file.getSize();
+        file.deleteFile();
+    }
+}
+
+} // namespace VoxScript
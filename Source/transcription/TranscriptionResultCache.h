@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+    TranscriptionResultCache.h
+
+    Persistent on-disk cache of finished transcriptions, keyed by the audio
+    content, the model and the decode settings. Reopening a project,
+    duplicating a track or re-importing a take finds the earlier result here
+    instead of running whisper again.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "VoxSequence.h"
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Identifies one cached transcription.
+ */
+struct TranscriptionCacheKey
+{
+    juce::String contentHash;      // From TranscriptionResultCache::fingerprintAudioFile()
+    juce::String modelId;          // Resolved WhisperModelCatalogue id
+    juce::String decodeSignature;  // From WhisperEngine::getDecodeSignature()
+
+    bool isValid() const noexcept { return contentHash.isNotEmpty() && modelId.isNotEmpty(); }
+
+    /** Entry file name: a hash over all three parts. */
+    juce::String getFileName() const;
+};
+
+/**
+ * @brief Shared, size-limited result cache in <AppData>/VoxScript/cache/transcripts.
+ *
+ * Use through juce::SharedResourcePointer<TranscriptionResultCache>.
+ *
+ * Entries:
+ * - One file per key: a small header (magic, format version, payload size,
+ *   payload checksum) followed by the VoxSequence as a binary ValueTree.
+ * - Written to a temporary file and moved into place, so a crash never
+ *   leaves a half-written entry under the final name.
+ * - Entries with the wrong version, size or checksum are treated as misses
+ *   and deleted.
+ * - When the folder grows past the size limit, the least recently used
+ *   entries (by file modification time, refreshed on every hit) are removed.
+ *
+ * Thread Safety:
+ * - All methods may be called from any background thread. Not for the audio thread.
+ */
+class TranscriptionResultCache
+{
+public:
+    /** Bump when the entry layout or VoxSequence serialisation changes. */
+    static constexpr juce::uint32 formatVersion = 1;
+
+    TranscriptionResultCache();
+    ~TranscriptionResultCache() = default;
+
+    /**
+     * Content hash of an audio file's samples (not its header), so the same
+     * take extracted twice gives the same key. Empty if the file can't be read.
+     */
+    static juce::String fingerprintAudioFile (const juce::File& audioFile);
+
+    /**
+     * fingerprintAudioFile(), remembered per file (path, size, modification
+     * time) for the session, so the passes and ranges of one job file are
+     * hashed once. Given the file's samples as decoded by
+     * WhisperEngine::readPcm16k(), a 16 kHz mono file (what AudioExtractor
+     * writes) is hashed from them instead of being read again; the hash is
+     * the same.
+     */
+    juce::String getFingerprint (const juce::File& audioFile, const std::vector<float>* pcm16k = nullptr);
+
+    /** Cached result, or nullopt on a miss. */
+    std::optional<VoxSequence> lookup (const TranscriptionCacheKey& key);
+
+    /** Store a result. Empty results are not cached. */
+    void store (const TranscriptionCacheKey& key, const VoxSequence& sequence);
+
+    /**
+     * Language detected in this audio with this model, or empty. Lets a job
+     * that doesn't know its language yet find the cached result without
+     * running detection first.
+     */
+    juce::String lookupLanguage (const juce::String& contentHash, const juce::String& modelId);
+
+    /** Remember a detected language for lookupLanguage(). */
+    void storeLanguage (const juce::String& contentHash, const juce::String& modelId, const juce::String& language);
+
+    /** Maximum total size of the cache folder. Default 64 MB; 0 disables the cache. */
+    void setMaxSizeBytes (juce::int64 newMaxSize);
+    juce::int64 getMaxSizeBytes() const;
+
+    /** Remove every entry. */
+    void clear();
+
+    static juce::File getCacheDirectory();
+
+private:
+    /** Delete least recently used entries until the folder fits the limit. Caller holds lock. */
+    void trimLocked();
+
+    mutable std::mutex lock;
+    juce::int64 maxSizeBytes = 64 * 1024 * 1024;
+
+    std::mutex fingerprintLock;
+    std::map<juce::String, juce::String> fingerprints; // File identity -> fingerprint
+    static constexpr size_t maxFingerprints = 1024;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TranscriptionResultCache)
+};
+
+} // namespace VoxScript
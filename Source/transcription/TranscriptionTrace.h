@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+    TranscriptionTrace.h
+
+    Per-stage timestamps of one transcription job: where the time between
+    an edit in the host and the transcript in the Script View went.
+    Filled in by the controller, the job queue and WhisperEngine, and
+    aggregated by TranscriptionMetrics.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace VoxScript
+{
+
+/** Stages of a transcription job, in the order they normally happen. */
+enum class TranscriptionStage
+{
+    CacheFill,          // Reading the source into the AudioCache
+    Extraction,         // Writing the job's audio file, decoding it to 16 kHz
+    QueueWait,          // Enqueued (or preempted) until a worker takes the job
+    ModelLoad,          // Loading the model and creating the inference state
+    Encoder,            // whisper's encoder, including its mel spectrogram
+    Decoder,            // Token decoding, until the next window's encoder
+    RemoteInference,    // Encoder and decoder in a VoxScriptWorker process (not split)
+    Publication,        // Result handed over until the store has it
+    NumStages
+};
+
+/**
+ * @brief Timestamps of one job, as spans on juce::Time::getMillisecondCounterHiRes().
+ *
+ * A stage may occur several times (e.g. encoder and decoder per window).
+ *
+ * Thread Safety:
+ * - None; a trace travels with its job and is filled by whoever runs it.
+ */
+struct TranscriptionTrace
+{
+    struct Span
+    {
+        TranscriptionStage stage;
+        double startMs = 0.0;
+        double endMs = 0.0;
+    };
+
+    uint64_t sourceID = 0;
+    juce::String label;             // Pass and model, for the trace viewer
+    double queuedAtMs = 0.0;        // Start of the current QueueWait
+    std::vector<Span> spans;
+
+    static double now() noexcept { return juce::Time::getMillisecondCounterHiRes(); }
+
+    void add (TranscriptionStage stage, double startMs, double endMs)
+    {
+        spans.push_back ({ stage, startMs, juce::jmax (startMs, endMs) });
+    }
+
+    /** Add a span from startMs until now. */
+    void addUntilNow (TranscriptionStage stage, double startMs) { add (stage, startMs, now()); }
+
+    /** Time spent in a stage, over all its spans. */
+    double getTotalMs (TranscriptionStage stage) const noexcept
+    {
+        double total = 0.0;
+
+        for (const auto& span : spans)
+            if (span.stage == stage)
+                total += span.endMs - span.startMs;
+
+        return total;
+    }
+
+    /** From the first span's start to the last span's end. */
+    double getElapsedMs() const noexcept
+    {
+        if (spans.empty())
+            return 0.0;
+
+        double first = spans.front().startMs, last = spans.front().endMs;
+
+        for (const auto& span : spans)
+        {
+            first = juce::jmin (first, span.startMs);
+            last = juce::jmax (last, span.endMs);
+        }
+
+        return last - first;
+    }
+
+    static const char* getStageName (TranscriptionStage stage) noexcept
+    {
+        switch (stage)
+        {
+            case TranscriptionStage::CacheFill:         return "cache fill";
+            case TranscriptionStage::Extraction:        return "extraction";
+            case TranscriptionStage::QueueWait:         return "queue wait";
+            case TranscriptionStage::ModelLoad:         return "model load";
+            case TranscriptionStage::Encoder:           return "encoder";
+            case TranscriptionStage::Decoder:           return "decoder";
+            case TranscriptionStage::RemoteInference:   return "remote inference";
+            case TranscriptionStage::Publication:       return "publication";
+            case TranscriptionStage::NumStages:
+            default:                                    return "?";
+        }
+    }
+};
+
+} // namespace VoxScript
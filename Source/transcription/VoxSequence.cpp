@@ -17,55 +17,155 @@ namespace VoxScript
 
 void VoxSequence::addSegment (const VoxSegment& segment)
 {
-    segments.add (segment);
+    segmentStarts.push_back (segment.startTime);
+    segmentEnds.push_back (segment.endTime);
+    segmentTexts.push_back (addText (segment.text));
+    segmentFirstWords.push_back (getNumWords());
+
+    for (const auto& word : segment.words)
+    {
+        wordStarts.push_back (word.startTime);
+        wordEnds.push_back (word.endTime);
+        wordConfidences.push_back (word.confidence);
+        wordTexts.push_back (addText (word.text));
+    }
 }
 
 void VoxSequence::clear()
 {
-    segments.clear();
+    segmentStarts.clear();
+    segmentEnds.clear();
+    segmentTexts.clear();
+    segmentFirstWords.clear();
+    wordStarts.clear();
+    wordEnds.clear();
+    wordConfidences.clear();
+    wordTexts.clear();
+    textArena.clear();
+}
+
+void VoxSequence::truncate (int numSegments)
+{
+    if (numSegments >= getNumSegments())
+        return;
+
+    const auto keep = static_cast<size_t> (juce::jmax (0, numSegments));
+
+    // addSegment() writes a segment's text, then its words' texts: the arena
+    // and the word columns of the segments dropped start at the first one
+    const auto keepWords = static_cast<size_t> (segmentFirstWords[keep]);
+    const auto keepBytes = static_cast<size_t> (segmentTexts[keep].offset);
+
+    segmentStarts.resize (keep);
+    segmentEnds.resize (keep);
+    segmentTexts.resize (keep);
+    segmentFirstWords.resize (keep);
+    wordStarts.resize (keepWords);
+    wordEnds.resize (keepWords);
+    wordConfidences.resize (keepWords);
+    wordTexts.resize (keepWords);
+    textArena.resize (keepBytes);
+}
+
+void VoxSequence::reserve (int numSegments, int numWords, int numTextBytes)
+{
+    const auto segmentCapacity = segmentStarts.size() + static_cast<size_t> (juce::jmax (0, numSegments));
+    const auto wordCapacity = wordStarts.size() + static_cast<size_t> (juce::jmax (0, numWords));
+
+    segmentStarts.reserve (segmentCapacity);
+    segmentEnds.reserve (segmentCapacity);
+    segmentTexts.reserve (segmentCapacity);
+    segmentFirstWords.reserve (segmentCapacity);
+    wordStarts.reserve (wordCapacity);
+    wordEnds.reserve (wordCapacity);
+    wordConfidences.reserve (wordCapacity);
+    wordTexts.reserve (wordCapacity);
+    textArena.reserve (textArena.size() + static_cast<size_t> (juce::jmax (0, numTextBytes)));
+}
+
+VoxSequence::TextRef VoxSequence::addText (const juce::String& text)
+{
+    TextRef ref;
+    ref.offset = static_cast<juce::uint32> (textArena.size());
+    ref.numBytes = static_cast<juce::uint32> (text.getNumBytesAsUTF8());
+
+    const auto* utf8 = text.toRawUTF8();
+    textArena.insert (textArena.end(), utf8, utf8 + ref.numBytes);
+    return ref;
+}
+
+juce::String VoxSequence::getText (TextRef ref) const
+{
+    if (ref.numBytes == 0)
+        return {};
+
+    return juce::String::fromUTF8 (textArena.data() + ref.offset, static_cast<int> (ref.numBytes));
+}
+
+//==============================================================================
+juce::Range<int> VoxSequence::getSegmentWords (int segmentIndex) const noexcept
+{
+    const auto index = static_cast<size_t> (segmentIndex);
+    const int end = index + 1 < segmentFirstWords.size() ? segmentFirstWords[index + 1] : getNumWords();
+    return { segmentFirstWords[index], end };
 }
 
-const juce::Array<VoxSegment>& VoxSequence::getSegments() const
+VoxSegment VoxSequence::getSegment (int segmentIndex) const
 {
-    return segments;
+    VoxSegment segment;
+    segment.startTime = getSegmentStart (segmentIndex);
+    segment.endTime = getSegmentEnd (segmentIndex);
+    segment.text = getSegmentText (segmentIndex);
+
+    const auto words = getSegmentWords (segmentIndex);
+    segment.words.ensureStorageAllocated (words.getLength());
+
+    for (int w = words.getStart(); w < words.getEnd(); ++w)
+        segment.words.add ({ getWordStart (w), getWordEnd (w), getWordText (w), getWordConfidence (w) });
+
+    return segment;
+}
+
+juce::Array<VoxSegment> VoxSequence::SegmentList::toArray() const
+{
+    juce::Array<VoxSegment> result;
+    result.ensureStorageAllocated (size());
+
+    for (int i = 0; i < size(); ++i)
+        result.add (sequence.getSegment (i));
+
+    return result;
 }
 
+//==============================================================================
 juce::String VoxSequence::getFullText() const
 {
-    juce::String result;
-    
-    for (int i = 0; i < segments.size(); ++i)
+    // Segment texts separated by single spaces, straight from the arena
+    juce::MemoryOutputStream text (textArena.size() + segmentTexts.size());
+
+    for (size_t i = 0; i < segmentTexts.size(); ++i)
     {
-        result += segments[i].text;
-        
-        // Add space between segments (but not after last segment)
-        if (i < segments.size() - 1)
-            result += " ";
+        if (i > 0)
+            text.writeByte (' ');
+
+        text.write (textArena.data() + segmentTexts[i].offset, segmentTexts[i].numBytes);
     }
-    
-    return result;
+
+    return text.toUTF8();
 }
 
 int VoxSequence::getWordCount() const
 {
-    int count = 0;
-    
-    for (const auto& segment : segments)
-        count += segment.words.size();
-    
-    return count;
+    return getNumWords();
 }
 
 double VoxSequence::getTotalDuration() const
 {
-    if (segments.isEmpty())
+    if (segmentStarts.empty())
         return 0.0;
     
     // Duration from start of first segment to end of last segment
-    double start = segments.getFirst().startTime;
-    double end = segments.getLast().endTime;
-    
-    return end - start;
+    return segmentEnds.back() - segmentStarts.front();
 }
 
 juce::ValueTree VoxSequence::toValueTree() const
@@ -73,21 +173,23 @@ juce::ValueTree VoxSequence::toValueTree() const
     juce::ValueTree vt("SEQUENCE");
     vt.setProperty("duration", getTotalDuration(), nullptr);
     
-    for (const auto& seg : segments)
+    for (int i = 0; i < getNumSegments(); ++i)
     {
         juce::ValueTree segNode("SEGMENT");
-        segNode.setProperty("start", seg.startTime, nullptr);
-        segNode.setProperty("end", seg.endTime, nullptr);
-        segNode.setProperty("text", seg.text, nullptr);
+        segNode.setProperty("start", getSegmentStart(i), nullptr);
+        segNode.setProperty("end", getSegmentEnd(i), nullptr);
+        segNode.setProperty("text", getSegmentText(i), nullptr);
         
         // Serialize words
-        for (const auto& w : seg.words)
+        const auto words = getSegmentWords(i);
+
+        for (int w = words.getStart(); w < words.getEnd(); ++w)
         {
              juce::ValueTree wordNode("WORD");
-             wordNode.setProperty("s", w.startTime, nullptr);
-             wordNode.setProperty("e", w.endTime, nullptr);
-             wordNode.setProperty("t", w.text, nullptr);
-             wordNode.setProperty("c", w.confidence, nullptr);
+             wordNode.setProperty("s", getWordStart(w), nullptr);
+             wordNode.setProperty("e", getWordEnd(w), nullptr);
+             wordNode.setProperty("t", getWordText(w), nullptr);
+             wordNode.setProperty("c", getWordConfidence(w), nullptr);
              segNode.addChild(wordNode, -1, nullptr);
         }
         
@@ -102,6 +204,7 @@ bool VoxSequence::fromValueTree(const juce::ValueTree& vt)
         return false;
         
     clear();
+    reserve(vt.getNumChildren(), 0, 0);
     
     // Iterate over SEGMENT children
     for (const auto& segNode : vt)
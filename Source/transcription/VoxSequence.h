@@ -1,5 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
+#include <iterator>
+#include <vector>
 
 namespace VoxScript
 {
@@ -20,16 +22,82 @@ struct VoxSegment
     juce::Array<VoxWord> words;
 };
 
+/**
+ * @brief A transcript: segments of timed words.
+ *
+ * Stored column by column rather than as VoxSegment objects: start, end and
+ * confidence arrays for segments and words, and all their text in one UTF-8
+ * arena addressed by offsets. An hour of speech is then a dozen allocations
+ * instead of tens of thousands, and copying a sequence (every store
+ * snapshot does) is a handful of memcpys.
+ *
+ * VoxSegment and VoxWord remain the way to build and read a sequence:
+ * getSegments() hands out segments built from the columns on access. Code
+ * that walks many words can read the columns directly instead (getNumWords(),
+ * getWordStart(), ...), which allocates nothing but the text it asks for.
+ */
 class VoxSequence
 {
 public:
+    /**
+     * @brief Segments of a sequence, built on access (see VoxSequence).
+     * Reads like the juce::Array it replaces, but yields segments by value;
+     * it refers to the sequence, which must outlive it.
+     */
+    class SegmentList
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = VoxSegment;
+            using difference_type = int;
+            using pointer = void;
+            using reference = VoxSegment;
+
+            Iterator (const VoxSequence& s, int i) noexcept : sequence (&s), index (i) {}
+
+            VoxSegment operator*() const { return sequence->getSegment (index); }
+            Iterator& operator++() noexcept { ++index; return *this; }
+            bool operator== (const Iterator& other) const noexcept { return index == other.index; }
+            bool operator!= (const Iterator& other) const noexcept { return index != other.index; }
+
+        private:
+            const VoxSequence* sequence;
+            int index;
+        };
+
+        explicit SegmentList (const VoxSequence& s) noexcept : sequence (s) {}
+
+        int size() const noexcept { return sequence.getNumSegments(); }
+        bool isEmpty() const noexcept { return size() == 0; }
+
+        /** A segment, or an empty one if the index is out of range (like juce::Array). */
+        VoxSegment operator[] (int index) const { return juce::isPositiveAndBelow (index, size()) ? sequence.getSegment (index) : VoxSegment(); }
+        VoxSegment getFirst() const { return (*this)[0]; }
+        VoxSegment getLast() const { return (*this)[size() - 1]; }
+
+        Iterator begin() const noexcept { return { sequence, 0 }; }
+        Iterator end() const noexcept { return { sequence, size() }; }
+
+        /** All segments as objects, for code that edits them. */
+        juce::Array<VoxSegment> toArray() const;
+
+    private:
+        const VoxSequence& sequence;
+    };
+
     VoxSequence() = default;
-    
+
     // Existing API (implemented in VoxSequence.cpp)
-    const juce::Array<VoxSegment>& getSegments() const;
+    SegmentList getSegments() const noexcept { return SegmentList (*this); }
     void addSegment(const VoxSegment& segment);
     void clear();
-    
+
+    /** Keep only the first numSegments segments and their words. */
+    void truncate (int numSegments);
+
     // Restored methods (implemented in VoxSequence.cpp)
     juce::String getFullText() const;
     int getWordCount() const;
@@ -44,13 +112,58 @@ public:
         s.text = text;
         addSegment(s);
     }
-    
+
     // Serialization
     juce::ValueTree toValueTree() const;
     bool fromValueTree(const juce::ValueTree& vt);
 
+    //==========================================================================
+    // Columns (indices are not range-checked)
+
+    int getNumSegments() const noexcept { return static_cast<int> (segmentStarts.size()); }
+    double getSegmentStart (int segmentIndex) const noexcept { return segmentStarts[static_cast<size_t> (segmentIndex)]; }
+    double getSegmentEnd (int segmentIndex) const noexcept { return segmentEnds[static_cast<size_t> (segmentIndex)]; }
+    juce::String getSegmentText (int segmentIndex) const { return getText (segmentTexts[static_cast<size_t> (segmentIndex)]); }
+
+    /** Indices of a segment's words in the word columns. */
+    juce::Range<int> getSegmentWords (int segmentIndex) const noexcept;
+
+    int getNumWords() const noexcept { return static_cast<int> (wordStarts.size()); }
+    double getWordStart (int wordIndex) const noexcept { return wordStarts[static_cast<size_t> (wordIndex)]; }
+    double getWordEnd (int wordIndex) const noexcept { return wordEnds[static_cast<size_t> (wordIndex)]; }
+    float getWordConfidence (int wordIndex) const noexcept { return wordConfidences[static_cast<size_t> (wordIndex)]; }
+    juce::String getWordText (int wordIndex) const { return getText (wordTexts[static_cast<size_t> (wordIndex)]); }
+
+    /** One segment as an object, with its words. */
+    VoxSegment getSegment (int segmentIndex) const;
+
+    /** Room for this much more, to avoid regrowing while a sequence is built. */
+    void reserve (int numSegments, int numWords, int numTextBytes);
+
 private:
-    juce::Array<VoxSegment> segments;
+    /** A string in the arena. */
+    struct TextRef
+    {
+        juce::uint32 offset = 0;
+        juce::uint32 numBytes = 0;
+    };
+
+    TextRef addText (const juce::String& text);
+    juce::String getText (TextRef ref) const;
+
+    // Segments
+    std::vector<double> segmentStarts;
+    std::vector<double> segmentEnds;
+    std::vector<TextRef> segmentTexts;
+    std::vector<int> segmentFirstWords;   // A segment's words run up to the next segment's first word
+
+    // Words
+    std::vector<double> wordStarts;
+    std::vector<double> wordEnds;
+    std::vector<float> wordConfidences;
+    std::vector<TextRef> wordTexts;
+
+    std::vector<char> textArena;          // UTF-8, not terminated
 };
 
 } // namespace VoxScript
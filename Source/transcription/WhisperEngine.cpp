@@ -13,8 +13,12 @@
 
 #include "WhisperEngine.h"
 #include "../engine/AudioCache.h"
+#include "WhisperSystemInfo.h"
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <whisper.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace VoxScript
 {
@@ -22,6 +26,9 @@ namespace VoxScript
 WhisperEngine::WhisperEngine()
 {
     DBG ("WhisperEngine: Initializing");
+
+    // See setSelectiveBeamSearch()
+    selectiveBeamSearch = juce::SystemStats::getEnvironmentVariable ("VOXSCRIPT_SELECTIVE_BEAM", {}) != "0";
 }
 
 WhisperEngine::~WhisperEngine()
@@ -31,12 +38,8 @@ WhisperEngine::~WhisperEngine()
     // Signal to stop any ongoing process (if called from another thread)
     cancelTranscription();
     
-    // Free whisper context
-    if (ctx != nullptr)
-    {
-        whisper_free (ctx);
-        ctx = nullptr;
-    }
+    // Free our state and release the shared model
+    unloadModel();
     
     DBG ("WhisperEngine: Destroyed");
 }
@@ -44,223 +47,287 @@ WhisperEngine::~WhisperEngine()
 //==============================================================================
 // Public API
 
-VoxSequence WhisperEngine::processSync (const juce::File& audioFile)
+VoxSequence WhisperEngine::processSync (const juce::File& audioFile, AudioSourceID sourceID)
 {
-    // Reset cancel flag at start of new job
-    shouldCancel = false;
-
     if (!audioFile.existsAsFile())
     {
         DBG ("WhisperEngine: Audio file does not exist: " + audioFile.getFullPathName());
         return {};
     }
 
-    // Load model if not already loaded (Lazy Loading)
-    if (ctx == nullptr)
-    {
-        loadModel();
-        if (ctx == nullptr)
-        {
-            // Error already logged
-            return {}; 
-        }
-    }
+    if (!ensureModelLoaded())
+        return {};
     
     DBG ("================================================");
     DBG ("WhisperEngine: Processing audio file");
     DBG ("File: " + audioFile.getFullPathName());
     DBG ("================================================");
-    
-    // Read audio file using JUCE
-    juce::AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
-    
-    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (audioFile));
-    
-    if (reader == nullptr)
-    {
-        DBG ("WhisperEngine: Failed to read audio file (unsupported format?)");
+
+    forgetHeldAudio();
+
+    if (!readPcm16k (audioFile, pcmArena)) // Reused across jobs, see readPcm16k()
         return {};
-    }
-    
-    // Get audio properties
-    auto sampleRate = reader->sampleRate;
-    auto numChannels = reader->numChannels;
-    auto numSamples = reader->lengthInSamples;
-    
-    DBG ("WhisperEngine: Audio properties:");
-    DBG ("  Sample rate: " + juce::String (sampleRate) + " Hz");
-    DBG ("  Channels: " + juce::String (numChannels));
-    DBG ("  Samples: " + juce::String (numSamples));
-    
-    // Read audio into buffer
-    juce::AudioBuffer<float> audioBuffer (static_cast<int> (numChannels), 
-                                          static_cast<int> (numSamples));
-    reader->read (&audioBuffer, 0, static_cast<int> (numSamples), 0, true, true);
+
+    auto sequence = transcribePcm (sourceID);
+
+    if (sequence.getNumSegments() > 0)
+        heldSourceID = sourceID; // For redecode()
+
+    return sequence;
+}
+
+VoxSequence WhisperEngine::processRanges (const juce::File& audioFile, const SourceRanges::RangeList& ranges, AudioSourceID sourceID)
+{
+    if (ranges.isEmpty())
+        return processSync (audioFile, sourceID);
+
+    if (!audioFile.existsAsFile() || !ensureModelLoaded())
+        return {};
+
+    forgetHeldAudio();
+
+    if (!readPcm16k (audioFile, pcmArena))
+        return {};
+
+    std::vector<float> packed;
+    SourceRanges::pack (pcmArena, ranges, packed);
+    pcmArena.swap (packed);
+
+    // The Detail View's spectrogram describes the whole source, not the packed ranges
+    if (needsDetailSpectrogram (sourceID))
+        detailAudio[sourceID] = std::move (packed);
+
+    DBG ("WhisperEngine: Transcribing " + juce::String (SourceRanges::getTotalLength (ranges), 1) + " s in "
+         + juce::String (ranges.size()) + " ranges of " + audioFile.getFileName());
+
+    auto packedSequence = transcribePcm (0);
+
+    if (packedSequence.getNumSegments() == 0)
+        return {};
+
+    // For redecode(), which decodes the packed audio and unpacks it the same way
+    heldSourceID = sourceID;
+    heldRanges = ranges;
+
+    return SourceRanges::unpack (packedSequence, ranges);
+}
+
+VoxSequence WhisperEngine::processSamples (const float* samples, size_t numSamples, AudioSourceID sourceID)
+{
+    if (samples == nullptr || numSamples == 0 || !ensureModelLoaded())
+        return {};
+
+    forgetHeldAudio();
+    pcmArena.assign (samples, samples + numSamples);
+    return transcribePcm (sourceID);
+}
+
+VoxSequence WhisperEngine::transcribePcm (AudioSourceID sourceID)
+{
+    auto& pcmData = pcmArena;
+    preemptedProgress.reset();
+
+    // Only meaningful for the windowed pass; never carried into another job
+    auto resumeFrom = std::move (resumeProgress);
+
+    // The beam refinement encodes from the source's spectrogram if the
+    // language probe already computed it; none is computed for it, since
+    // whisper_full computes its own mel internally and can't take ours
+    std::shared_ptr<const MelSpectrogram> spectrogram;
+
+    if (spectrogramService != nullptr && sourceID != 0)
+        spectrogram = spectrogramService->find (sourceID);
     
-    // Convert to mono
-    std::vector<float> pcmData;
-    pcmData.resize (static_cast<size_t> (numSamples));
+    if (shouldCancel) return {}; 
     
-    if (numChannels == 1)
+    VoxSequence sequence;
+
+    if (overlappedWindows.load() && static_cast<double> (pcmData.size()) / WHISPER_SAMPLE_RATE > maxBatchSeconds)
     {
-        std::copy (audioBuffer.getReadPointer (0), 
-                   audioBuffer.getReadPointer (0) + numSamples,
-                   pcmData.begin());
+        sequence = transcribeWindowed (pcmData, resumeFrom.get());
+
+        if (preemptedProgress != nullptr)
+            return {};
     }
     else
     {
-        // Mix to mono
-        for (juce::int64 i = 0; i < numSamples; ++i)
+        auto params = makeDefaultParams();
+
+        // whisper seeks through long audio itself; hand out each segment as it is decoded
+        if (segmentCallback != nullptr && static_cast<double> (pcmData.size()) / WHISPER_SAMPLE_RATE > maxBatchSeconds)
         {
-            float sum = 0.0f;
-            for (unsigned int ch = 0; ch < numChannels; ++ch)
-                sum += audioBuffer.getSample (static_cast<int> (ch), static_cast<int> (i));
-            pcmData[static_cast<size_t> (i)] = sum / static_cast<float> (numChannels);
+            params.new_segment_callback = [] (whisper_context*, whisper_state* segmentState, int numNew, void* userData)
+            {
+                auto* engine = static_cast<WhisperEngine*> (userData);
+                const int numSegments = whisper_full_n_segments_from_state (segmentState);
+
+                for (int i = juce::jmax (0, numSegments - numNew); i < numSegments; ++i)
+                    engine->segmentCallback (engine->makeSegment (i, 0.0));
+            };
+            params.new_segment_callback_user_data = this;
         }
-    }
-    
-    // Resample to 16kHz
-    if (sampleRate != 16000.0)
-    {
-        DBG ("WhisperEngine: Resampling from " + juce::String (sampleRate) + " to 16000 Hz");
         
-        double ratio = 16000.0 / sampleRate;
-        size_t newSize = static_cast<size_t> (pcmData.size() * ratio);
-        std::vector<float> resampled (newSize);
+        if (!runInference (params, pcmData.data(), static_cast<int> (pcmData.size())))
+            return {};
         
-        for (size_t i = 0; i < newSize; ++i)
-        {
-            if (shouldCancel) return {}; 
+        DBG ("WhisperEngine: Transcription complete, extracting results");
+        
+        int numSegments = whisper_full_n_segments_from_state (state);
 
-            double srcIndex = static_cast<double> (i) / ratio;
-            size_t idx0 = static_cast<size_t> (srcIndex);
-            size_t idx1 = juce::jmin (idx0 + 1, pcmData.size() - 1);
-            float frac = static_cast<float> (srcIndex - idx0);
+        // Extract results
+        for (int i = 0; i < numSegments; ++i)
+        {
+            if (shouldCancel) return {};
             
-            resampled[i] = pcmData[idx0] * (1.0f - frac) + pcmData[idx1] * frac;
+            sequence.addSegment (makeSegment (i, 0.0));
         }
-        
-        pcmData = std::move (resampled);
     }
-    
-    if (shouldCancel) return {}; 
-    
-    // Configure whisper parameters
-    // Change 1: Revert to Greedy (Mission 5 fix caused crash with Beam)
-    whisper_full_params params = whisper_full_default_params (WHISPER_SAMPLING_GREEDY);
-    
-    params.print_realtime   = false;
-    params.print_progress   = false;
-    params.print_timestamps = true;
-    params.print_special    = false;
-    params.translate        = false;
-    params.language         = "en";
-    params.detect_language  = false;
-    params.n_threads        = 4;
-    params.offset_ms        = 0;
-    params.duration_ms      = 0;
-    
-    // Anti-Hallucination settings (Updated for Mission 5, Kept for Mission 5.1)
-    params.suppress_blank   = true;
-    params.suppress_non_speech_tokens = true;
-    params.no_context       = true;
-    params.audio_ctx        = 0; 
-    params.entropy_thold    = 2.0f;
-
-    // Change 4: Stricter gating (Kept)
-    params.logprob_thold    = -1.0f; // More conservative (was -0.5f)
-    params.no_speech_thold  = 0.6f;  // Higher threshold for silence (was 0.3f)
 
-    params.max_len          = 0;
-    params.token_timestamps = true;
-    params.split_on_word    = true;
-    
-    // Change 2: Beam search settings (Reverted/Ignored for Greedy)
-    params.beam_search.beam_size = -1; // Default/Disabled
-    params.greedy.best_of        = 5; 
-    
-    params.temperature      = 0.0f;
-    params.temperature_inc  = 0.0f;
-    
-    // Change 3: Neutral prompt (Kept)
-    params.initial_prompt   = "Transcribe the vocal words you can clearly hear. If unsure, output nothing.";
-    
-    DBG ("WhisperEngine: Running whisper inference...");
-    
-    // Run transcription
-    // Note: whisper_full is blocking. We can't easily cancel it mid-inference unless we use a callback
-    // or if whisper supports an abort flag in params.
-    // For now, we check cancellation before.
-    
-    int result = whisper_full (ctx, params, pcmData.data(), static_cast<int> (pcmData.size()));
-    
-    if (result != 0)
-    {
-        DBG ("WhisperEngine: Transcription failed with code: " + juce::String (result));
-        return {};
-    }
-    
-    if (shouldCancel) return {}; 
-    
-    DBG ("WhisperEngine: Transcription complete, extracting results");
-    
-    int numSegments = whisper_full_n_segments (ctx);
+    if (shouldCancel) return {};
 
     // Change 5: Post-run guard for empty/junk results
-    if (numSegments == 0)
+    if (sequence.getSegments().isEmpty())
     {
         DBG ("WhisperEngine: No segments found.");
         return {};
     }
     
-    // Extract results
-    VoxSequence sequence;
-    juce::String combinedText;
+    if (isJunkResult (sequence))
+        return {};
+
+    if (selectiveBeamSearch.load())
+        sequence = refineLowConfidenceSegments (sequence, pcmData, spectrogram.get());
+
+    if (shouldCancel) return {};
     
-    for (int i = 0; i < numSegments; ++i)
+    DBG ("WhisperEngine: Success. " + juce::String(sequence.getWordCount()) + " words.");
+    return sequence;
+}
+
+std::vector<VoxSequence> WhisperEngine::processBatch (const std::vector<juce::File>& audioFiles,
+                                                     const std::vector<AudioSourceID>& sourceIDs)
+{
+    std::vector<VoxSequence> results (audioFiles.size());
+
+    if (audioFiles.empty() || !ensureModelLoaded())
+        return results;
+
+    forgetHeldAudio(); // The clips are read into pcmArena
+
+    // Pack all clips into one buffer: [guard][clip 0][guard][clip 1]...[guard]
+    // The silence guards keep whisper from running words of two takes together.
+    const auto guardSamples = static_cast<size_t> (batchGuardSeconds * WHISPER_SAMPLE_RATE);
+
+    std::vector<float> packed (guardSamples, 0.0f);
+    std::vector<juce::Range<double>> itemRanges; // Position of each clip in the packed buffer (seconds)
+    auto& clip = pcmArena;
+
+    for (const auto& file : audioFiles)
     {
-        if (shouldCancel) return {};
-        
-        const char* text = whisper_full_get_segment_text (ctx, i);
-        int64_t t0 = whisper_full_get_segment_t0 (ctx, i);
-        int64_t t1 = whisper_full_get_segment_t1 (ctx, i);
-        
-        VoxSegment segment;
-        segment.text = juce::String::fromUTF8 (text);
-        combinedText += segment.text;
+        clip.clear();
 
-        segment.startTime = static_cast<double> (t0) / 100.0;
-        segment.endTime = static_cast<double> (t1) / 100.0;
-        
-        // Single word approximation for Phase II/III parity to previous impl
-        VoxWord word;
-        word.text = segment.text;
-        word.startTime = segment.startTime;
-        word.endTime = segment.endTime;
-        word.confidence = 1.0f;
-        
-        segment.words.add (word);
-        sequence.addSegment (segment);
+        if (!file.existsAsFile() || !readPcm16k (file, clip))
+            clip.clear(); // Keep the slot so indices line up; an empty clip gets an empty result
+
+        if (!clip.empty() && itemRanges.size() < sourceIDs.size() && needsDetailSpectrogram (sourceIDs[itemRanges.size()]))
+            detailAudio[sourceIDs[itemRanges.size()]] = clip;
+
+        const double start = static_cast<double> (packed.size()) / WHISPER_SAMPLE_RATE;
+        packed.insert (packed.end(), clip.begin(), clip.end());
+        itemRanges.push_back ({ start, static_cast<double> (packed.size()) / WHISPER_SAMPLE_RATE });
+        packed.insert (packed.end(), guardSamples, 0.0f);
+
+        if (shouldCancel) return results;
     }
-    
-    // Change 5b: Check total text length to filter out noise/junk
-    // Using a minimal length check (e.g. < 2 chars)
-    if (combinedText.trim().length() < 2)
+
+    DBG ("WhisperEngine: Batch of " + juce::String ((int) audioFiles.size()) + " clips, "
+         + juce::String (static_cast<double> (packed.size()) / WHISPER_SAMPLE_RATE, 1) + " s packed");
+
+    auto params = makeDefaultParams();
+
+    if (!runInference (params, packed.data(), static_cast<int> (packed.size())))
+        return results;
+
+    // Demultiplex: assign each word to the clip whose range contains its midpoint
+    // (words in a guard go to the nearest clip), then shift to clip-local time.
+    auto findItem = [&itemRanges] (double time)
     {
-        DBG ("WhisperEngine: Result too short ('" + combinedText + "'), treating as silence.");
-        return {};
+        size_t best = 0;
+        double bestDistance = std::numeric_limits<double>::max();
+
+        for (size_t k = 0; k < itemRanges.size(); ++k)
+        {
+            const auto& r = itemRanges[k];
+            const double distance = r.contains (time) ? 0.0
+                                  : juce::jmin (std::abs (time - r.getStart()), std::abs (time - r.getEnd()));
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best = k;
+            }
+        }
+
+        return best;
+    };
+
+    const int numSegments = whisper_full_n_segments_from_state (state);
+
+    for (int i = 0; i < numSegments; ++i)
+    {
+        if (shouldCancel) return std::vector<VoxSequence> (audioFiles.size());
+
+        auto segment = makeSegment (i, 0.0);
+
+        VoxSegment current;
+        size_t currentItem = 0;
+        bool hasCurrent = false;
+
+        auto flush = [&]
+        {
+            if (hasCurrent && !current.words.isEmpty())
+            {
+                const double offset = itemRanges[currentItem].getStart();
+                current.startTime = juce::jmax (0.0, current.words.getFirst().startTime - offset);
+                current.endTime = juce::jmax (current.startTime, current.words.getLast().endTime - offset);
+
+                for (auto& w : current.words)
+                {
+                    w.startTime = juce::jmax (0.0, w.startTime - offset);
+                    w.endTime = juce::jmax (w.startTime, w.endTime - offset);
+                }
+
+                results[currentItem].addSegment (current);
+            }
+
+            current = {};
+            hasCurrent = false;
+        };
+
+        for (const auto& word : segment.words)
+        {
+            const auto item = findItem (0.5 * (word.startTime + word.endTime));
+
+            if (hasCurrent && item != currentItem)
+                flush();
+
+            currentItem = item;
+            hasCurrent = true;
+            current.text += word.text;
+            current.words.add (word);
+        }
+
+        flush();
     }
-    
-    DBG ("WhisperEngine: Success. " + juce::String(sequence.getWordCount()) + " words.");
-    return sequence;
+
+    for (auto& result : results)
+        if (isJunkResult (result))
+            result.clear();
+
+    return results;
 }
 
 VoxSequence WhisperEngine::processSync (juce::ARAAudioSource* source)
 {
-    // Reset cancel flag
-    shouldCancel = false;
-
     if (source == nullptr) return {};
     if (audioCache == nullptr)
     {
@@ -298,44 +365,1015 @@ VoxSequence WhisperEngine::processSync (juce::ARAAudioSource* source)
     return result;
 }
 
-void WhisperEngine::cancelTranscription()
+void WhisperEngine::setLanguage (const juce::String& languageCode)
 {
-    shouldCancel = true;
+    language = languageCode.isNotEmpty() ? languageCode.toLowerCase() : juce::String ("en");
 }
 
-//==============================================================================
-// Internal
-void WhisperEngine::loadModel()
+juce::String WhisperEngine::detectLanguage (const juce::File& audioFile, AudioSourceID sourceID)
 {
-    DBG ("WhisperEngine: Loading whisper model");
-    
-    juce::File appData = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory);
-    
-#if JUCE_MAC
-    appData = appData.getChildFile ("Application Support");
-#endif
+    if (!ensureModelLoaded())
+        return {};
 
-    juce::File modelFile = appData.getChildFile ("VoxScript")
-                                 .getChildFile ("models")
-                                 .getChildFile ("ggml-base.en.bin");
-    
-    if (!modelFile.existsAsFile())
+    auto* ctx = model->getContext();
+
+    if (!whisper_is_multilingual (ctx))
+        return "en";
+
+    forgetHeldAudio();
+
+    if (!readPcm16k (audioFile, pcmArena)) // Reused across jobs, see readPcm16k()
+        return {};
+
+    return detectLanguageInPcm (sourceID);
+}
+
+juce::String WhisperEngine::detectLanguage (const float* samples, size_t numSamples, AudioSourceID sourceID)
+{
+    if (samples == nullptr || numSamples == 0 || !ensureModelLoaded())
+        return {};
+
+    if (!whisper_is_multilingual (model->getContext()))
+        return "en";
+
+    forgetHeldAudio();
+    pcmArena.assign (samples, samples + numSamples);
+    return detectLanguageInPcm (sourceID);
+}
+
+juce::String WhisperEngine::detectLanguageInPcm (AudioSourceID sourceID)
+{
+    auto* ctx = model->getContext();
+    auto& pcmData = pcmArena;
+
+    // The probe runs on the first speech region, found by the spectrogram VAD.
+    // The same spectrogram is the encoder input, so whisper computes no mel here.
+    auto spectrogram = getSpectrogram (sourceID, pcmData);
+    if (spectrogram == nullptr)
+        return {};
+
+    const auto speech = spectrogram->findSpeechRegions();
+    const double speechStart = speech.isEmpty() ? 0.0 : juce::jmax (0.0, speech.getFirst().getStart() - 0.1); // Keep 100 ms of lead-in
+    const int numThreads = getNumThreads();
+
+    const auto speechFrame = static_cast<int> (speechStart / MelSpectrogram::secondsPerFrame);
+
+    // whisper_full leaves its audio_ctx in the state and only whisper_full
+    // sets it, but the probe must encode the full window: after a reduced
+    // pass, start over with a fresh state (the next pass sets it again)
+    if (stateHasReducedContext)
     {
-        DBG ("WhisperEngine: Model not found at " + modelFile.getFullPathName());
-        return;
+        whisper_free_state (state);
+        state = whisper_init_state (ctx);
+        stateHasReducedContext = false;
+
+        if (state == nullptr)
+        {
+            DBG ("WhisperEngine: Failed to allocate whisper state.");
+            releaseEncodedWindows();
+            model.reset();
+            return {};
+        }
     }
-    
-    whisper_context_params cparams = whisper_context_default_params();
-    ctx = whisper_init_from_file_with_params (modelFile.getFullPathName().toRawUTF8(), cparams);
-    
-    if (ctx == nullptr)
+
+    // Models with more mel bands (large-v3) need whisper's own mel
+    if (!setMelWindow (state, *spectrogram, speechFrame))
     {
-        DBG ("WhisperEngine: Failed to init whisper context.");
+        const auto first = juce::jmin (pcmData.size(), static_cast<size_t> (speechFrame) * MelSpectrogram::hopSize);
+        const auto count = juce::jmin (pcmData.size() - first, static_cast<size_t> (WHISPER_SAMPLE_RATE * 30));
+
+        if (whisper_pcm_to_mel_with_state (ctx, state, pcmData.data() + first, static_cast<int> (count), numThreads) != 0)
+            return {};
+    }
+
+    std::vector<float> probabilities (static_cast<size_t> (whisper_lang_max_id() + 1));
+    const int langId = whisper_lang_auto_detect_with_state (ctx, state, 0, numThreads, probabilities.data());
+
+    if (langId < 0 || shouldCancel)
+    {
+        DBG ("WhisperEngine: Language detection failed");
+        return {};
+    }
+
+    const juce::String code (whisper_lang_str (langId));
+    DBG ("WhisperEngine: Detected language '" + code + "' (p = "
+         + juce::String (probabilities[static_cast<size_t> (langId)], 2) + ")");
+    return code;
+}
+
+juce::String WhisperEngine::getDecodeSignature (bool batched) const
+{
+    const auto params = makeDefaultParams();
+
+    juce::StringArray parts;
+    parts.add ("strategy=" + juce::String ((int) params.strategy));
+    parts.add ("lang=" + language);
+    parts.add ("best_of=" + juce::String (params.greedy.best_of));
+    parts.add ("beam=" + juce::String (params.beam_search.beam_size));
+    parts.add ("temp=" + juce::String (params.temperature) + "/" + juce::String (params.temperature_inc));
+    parts.add ("thold=" + juce::String (params.entropy_thold) + "/" + juce::String (params.logprob_thold)
+               + "/" + juce::String (params.no_speech_thold));
+    parts.add ("suppress=" + juce::String ((int) params.suppress_blank) + juce::String ((int) params.suppress_non_speech_tokens));
+    parts.add ("ctx=" + juce::String (adaptiveAudioContext.load() ? "adaptive" : "full"));
+    parts.add ("windows=" + juce::String (overlappedWindows.load() ? juce::String (TranscriptStitcher::defaultOverlapSeconds) : juce::String ("off")));
+    parts.add ("rebeam=" + juce::String (selectiveBeamSearch.load() && !batched ? juce::String (beamConfidenceThreshold) : juce::String ("off")));
+    parts.add ("prompt=" + juce::String (juce::String (params.initial_prompt != nullptr ? params.initial_prompt : "").hashCode64()));
+    return parts.joinIntoString (";");
+}
+
+const WhisperEngine::EncodedWindow* WhisperEngine::retainEncodedWindow (const juce::String& windowKey, const std::vector<float>& pcmData,
+                                                                        const MelSpectrogram* spectrogram, double startSeconds)
+{
+    auto existing = std::find_if (encodedWindows.begin(), encodedWindows.end(),
+                                  [&] (const EncodedWindow& w) { return w.key == windowKey; });
+
+    if (existing != encodedWindows.end())
+        return &*existing;
+
+    if (model == nullptr)
+        return nullptr;
+
+    const auto windowSamples = static_cast<size_t> (maxBatchSeconds * WHISPER_SAMPLE_RATE);
+    const auto first = juce::jmin (pcmData.size(), static_cast<size_t> (juce::jmax (0.0, startSeconds) * WHISPER_SAMPLE_RATE));
+    const auto count = juce::jmin (windowSamples, pcmData.size() - first);
+
+    if (count == 0)
+        return nullptr;
+
+    auto* ctx = model->getContext();
+
+    // Full: reuse the least recently used window's state (a state is large)
+    ::whisper_state* windowState = nullptr;
+
+    if (static_cast<int> (encodedWindows.size()) >= maxRetainedWindows)
+    {
+        auto oldest = std::min_element (encodedWindows.begin(), encodedWindows.end(),
+                                        [] (const EncodedWindow& a, const EncodedWindow& b) { return a.lastUsedMs < b.lastUsedMs; });
+        windowState = oldest->state;
+        encodedWindows.erase (oldest);
     }
     else
     {
-        DBG ("WhisperEngine: Model loaded.");
+        windowState = whisper_init_state (ctx);
     }
+
+    if (windowState == nullptr)
+    {
+        DBG ("WhisperEngine: Failed to allocate state for encoded window");
+        return nullptr;
+    }
+
+    const int numThreads = getNumThreads();
+    const auto startFrame = static_cast<int> (first / MelSpectrogram::hopSize);
+    const bool melSet = spectrogram != nullptr && setMelWindow (windowState, *spectrogram, startFrame);
+
+    if ((!melSet && whisper_pcm_to_mel_with_state (ctx, windowState, pcmData.data() + first, static_cast<int> (count), numThreads) != 0)
+        || shouldCancel
+        || whisper_encode_with_state (ctx, windowState, 0, numThreads) != 0)
+    {
+        DBG ("WhisperEngine: Encoding window '" + windowKey + "' failed");
+        whisper_free_state (windowState);
+        return nullptr;
+    }
+
+    EncodedWindow window;
+    window.key = windowKey;
+    window.state = windowState;
+    window.startSeconds = static_cast<double> (first) / WHISPER_SAMPLE_RATE;
+    window.lengthSeconds = static_cast<double> (count) / WHISPER_SAMPLE_RATE;
+    window.lastUsedMs = juce::Time::getMillisecondCounter();
+    encodedWindows.push_back (window);
+
+    return &encodedWindows.back();
+}
+
+VoxSequence WhisperEngine::redecodeWindow (const juce::String& windowKey, const WindowDecodeOptions& options)
+{
+    auto it = std::find_if (encodedWindows.begin(), encodedWindows.end(),
+                            [&] (const EncodedWindow& w) { return w.key == windowKey; });
+
+    if (it == encodedWindows.end() || model == nullptr)
+        return {};
+
+    it->lastUsedMs = juce::Time::getMillisecondCounter();
+    model->markUsed();
+
+    // Decoder only: the encoder output in the window's state is reused as is
+    return WhisperWindowDecoder::decode (model->getContext(), it->state, options,
+                                        it->startSeconds, it->lengthSeconds, shouldCancel);
+}
+
+void WhisperEngine::releaseEncodedWindows()
+{
+    for (auto& window : encodedWindows)
+        whisper_free_state (window.state);
+
+    encodedWindows.clear();
+}
+
+void WhisperEngine::forgetHeldAudio()
+{
+    heldSourceID = 0;
+    heldRanges.clear();
+    detailAudio.clear();
+    releaseEncodedWindows();
+}
+
+void WhisperEngine::computeDetailSpectrogram (AudioSourceID sourceID, juce::uint64 generation)
+{
+    auto kept = detailAudio.find (sourceID);
+    const std::vector<float>* audio = nullptr;
+
+    if (kept != detailAudio.end())
+        audio = &kept->second;
+    else if (holdsAudioOf (sourceID)) // The whole file is in pcmArena
+        audio = &pcmArena;
+
+    if (audio != nullptr && needsDetailSpectrogram (sourceID))
+        spectrogramService->getOrCompute (sourceID, *audio, generation, &shouldCancel);
+
+    if (kept != detailAudio.end())
+        detailAudio.erase (kept);
+}
+
+bool WhisperEngine::needsDetailSpectrogram (AudioSourceID sourceID) const
+{
+    return spectrogramService != nullptr && sourceID != 0 && spectrogramService->find (sourceID) == nullptr;
+}
+
+VoxSequence WhisperEngine::redecode (const juce::String& languageCode, const juce::String& initialPrompt)
+{
+    if (heldSourceID == 0 || pcmArena.empty() || !ensureModelLoaded())
+        return {};
+
+    setLanguage (languageCode);
+
+    const auto& pcmData = pcmArena;
+    const double audioSeconds = static_cast<double> (pcmData.size()) / WHISPER_SAMPLE_RATE;
+    constexpr double minTailSeconds = 0.1;
+
+    VoxSequence sequence;
+    double position = 0.0;
+    int numReused = 0;
+    int numEncoded = 0;
+
+    // Whole windows from the start; a retained window covering the position
+    // (the beam refinement's) is decoded from there instead of encoding one
+    while (position + minTailSeconds < audioSeconds)
+    {
+        if (shouldCancel)
+            return {};
+
+        auto covering = std::find_if (encodedWindows.begin(), encodedWindows.end(), [position] (const EncodedWindow& w)
+        {
+            return w.startSeconds <= position && position + minTailSeconds < w.startSeconds + w.lengthSeconds;
+        });
+
+        const EncodedWindow* window = nullptr;
+
+        if (covering != encodedWindows.end())
+        {
+            window = &*covering;
+            ++numReused;
+        }
+        else
+        {
+            window = retainEncodedWindow (juce::String (position, 2), pcmData, nullptr, position);
+            ++numEncoded;
+        }
+
+        if (window == nullptr)
+            return {};
+
+        const auto windowKey = window->key;
+        const double windowEnd = window->startSeconds + window->lengthSeconds;
+
+        WindowDecodeOptions options;
+        options.language = language;
+        options.fromSeconds = position - window->startSeconds;
+        options.numThreads = getNumThreads();
+
+        // Prompted with the text so far, as whisper's own windows are
+        options.initialPrompt = sequence.getNumSegments() > 0 ? sequence.getSegmentText (sequence.getNumSegments() - 1)
+                                                              : initialPrompt;
+
+        const auto decoded = redecodeWindow (windowKey, options);
+
+        for (int i = 0; i < decoded.getNumSegments(); ++i)
+            sequence.addSegment (decoded.getSegment (i));
+
+        position = windowEnd;
+    }
+
+    if (shouldCancel || sequence.getNumSegments() == 0 || isJunkResult (sequence))
+        return {};
+
+    DBG ("WhisperEngine: Re-decoded in '" + language + "', " + juce::String (numReused) + " retained windows, "
+         + juce::String (numEncoded) + " encoded");
+
+    return heldRanges.isEmpty() ? sequence : SourceRanges::unpack (sequence, heldRanges);
+}
+
+void WhisperEngine::releaseModel()
+{
+    forgetHeldAudio();
+    unloadModel();
+
+    // Idle: give the PCM arena back too
+    pcmArena = {};
+    monoBlock = {};
+    readBlock.setSize (0, 0);
+}
+
+void WhisperEngine::cancelTranscription()
+{
+    shouldCancel = true;
+}
+
+void WhisperEngine::setModel (const juce::String& modelId)
+{
+    auto newId = modelId.isNotEmpty() ? modelId : juce::String (WhisperModelCatalogue::defaultModelId);
+
+    if (newId == requestedModelId)
+        return;
+
+    DBG ("WhisperEngine: Model changed from " + requestedModelId + " to " + newId);
+    requestedModelId = newId;
+
+    // Drop our reference now; the new model is loaded lazily by the next job.
+    // (The shared cache may keep the old one for other engines.)
+    if (model != nullptr && WhisperModelCatalogue::resolve (requestedModelId).id != model->getInfo().id)
+        unloadModel();
+}
+
+//==============================================================================
+// Internal
+std::shared_ptr<const MelSpectrogram> WhisperEngine::getSpectrogram (AudioSourceID sourceID, const std::vector<float>& pcmData)
+{
+    if (spectrogramService != nullptr && sourceID != 0)
+        return spectrogramService->getOrCompute (sourceID, pcmData, spectrogramGeneration, &shouldCancel);
+
+    return MelSpectrogram::compute (pcmData.data(), pcmData.size(), &shouldCancel);
+}
+
+bool WhisperEngine::setMelWindow (::whisper_state* targetState, const MelSpectrogram& spectrogram, int startFrame)
+{
+    if (whisper_model_n_mels (model->getContext()) != MelSpectrogram::numBands)
+        return false;
+
+    // One encoder window, padded with silence like whisper's own mel
+    std::vector<float> melInput;
+    spectrogram.getWhisperInput (startFrame, MelSpectrogram::framesPerTile, melInput);
+
+    if (whisper_set_mel_with_state (model->getContext(), targetState, melInput.data(),
+                                    MelSpectrogram::framesPerTile, MelSpectrogram::numBands) != 0)
+    {
+        DBG ("WhisperEngine: whisper_set_mel rejected the spectrogram");
+        return false;
+    }
+
+    return true;
+}
+
+bool WhisperEngine::ensureModelLoaded()
+{
+    // Load model if not already loaded (Lazy Loading)
+    // A model switch via setModel() has already released the old model.
+    // If the warm-up thread is still loading it, this waits for that load.
+    if (state == nullptr)
+    {
+        const auto loadStartMs = TranscriptionTrace::now();
+        loadModel();
+
+        if (trace != nullptr)
+            trace->addUntilNow (TranscriptionStage::ModelLoad, loadStartMs);
+
+        if (state == nullptr)
+        {
+            // Error already logged
+            return false; 
+        }
+    }
+
+    model->markUsed();
+    return true;
+}
+
+bool WhisperEngine::readPcm16k (const juce::File& audioFile, std::vector<float>& pcmData)
+{
+    const auto readStartMs = TranscriptionTrace::now();
+    const bool succeeded = decodePcm16k (audioFile, pcmData);
+
+    if (trace != nullptr)
+        trace->addUntilNow (TranscriptionStage::Extraction, readStartMs);
+
+    return succeeded;
+}
+
+bool WhisperEngine::decodePcm16k (const juce::File& audioFile, std::vector<float>& pcmData)
+{
+    // Streaming decode: read, downmix and resample block by block straight into
+    // pcmData, so the only full-length allocation is the 16 kHz mono result.
+    // pcmData is normally pcmArena, whose capacity is kept between jobs.
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (audioFile));
+    
+    if (reader == nullptr)
+    {
+        DBG ("WhisperEngine: Failed to read audio file (unsupported format?)");
+        return false;
+    }
+    
+    // Get audio properties
+    const auto sampleRate = reader->sampleRate;
+    const auto numChannels = static_cast<int> (reader->numChannels);
+    const auto numSamples = reader->lengthInSamples;
+    
+    DBG ("WhisperEngine: Audio properties:");
+    DBG ("  Sample rate: " + juce::String (sampleRate) + " Hz");
+    DBG ("  Channels: " + juce::String (numChannels));
+    DBG ("  Samples: " + juce::String (numSamples));
+
+    pcmData.clear();
+
+    if (numSamples <= 0 || numChannels <= 0 || sampleRate <= 0.0)
+        return false;
+
+    // Linear resampling to 16kHz: output i sits at source position i * step
+    const double step = sampleRate / WHISPER_SAMPLE_RATE;
+    const auto outputLength = static_cast<size_t> (static_cast<double> (numSamples) / step);
+    pcmData.reserve (outputLength);
+
+    if (sampleRate != WHISPER_SAMPLE_RATE)
+        DBG ("WhisperEngine: Resampling from " + juce::String (sampleRate) + " to 16000 Hz");
+
+    constexpr int blockSize = 65536;
+    readBlock.setSize (numChannels, blockSize, false, false, true);
+    monoBlock.resize (static_cast<size_t> (blockSize));
+
+    float previousSample = 0.0f; // Last mono sample of the previous block
+
+    for (juce::int64 blockStart = 0; blockStart < numSamples; blockStart += blockSize)
+    {
+        if (shouldCancel) return false;
+
+        const int n = static_cast<int> (juce::jmin (static_cast<juce::int64> (blockSize), numSamples - blockStart));
+        reader->read (&readBlock, 0, n, blockStart, true, true);
+
+        // Convert to mono
+        std::copy (readBlock.getReadPointer (0), readBlock.getReadPointer (0) + n, monoBlock.begin());
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::add (monoBlock.data(), readBlock.getReadPointer (ch), n);
+
+        if (numChannels > 1)
+            juce::FloatVectorOperations::multiply (monoBlock.data(), 1.0f / static_cast<float> (numChannels), n);
+
+        const juce::int64 blockEnd = blockStart + n;
+        const bool isLastBlock = blockEnd >= numSamples;
+
+        auto sampleAt = [&] (juce::int64 index)
+        {
+            index = juce::jmin (index, numSamples - 1);
+            return index < blockStart ? previousSample : monoBlock[static_cast<size_t> (index - blockStart)];
+        };
+
+        while (pcmData.size() < outputLength)
+        {
+            const double srcIndex = static_cast<double> (pcmData.size()) * step;
+            const auto idx0 = static_cast<juce::int64> (srcIndex);
+
+            // The next source sample is in the next block
+            if (idx0 + 1 >= blockEnd && !isLastBlock)
+                break;
+
+            const float frac = static_cast<float> (srcIndex - static_cast<double> (idx0));
+            pcmData.push_back (sampleAt (idx0) * (1.0f - frac) + sampleAt (idx0 + 1) * frac);
+        }
+
+        previousSample = monoBlock[static_cast<size_t> (n - 1)];
+    }
+
+    return !pcmData.empty();
+}
+
+int WhisperEngine::getNumThreads() const
+{
+    const int threads = numThreads.load();
+    return threads > 0 ? threads : WhisperSystemInfo::getRecommendedThreadCount();
+}
+
+whisper_full_params WhisperEngine::makeDefaultParams() const
+{
+    // Configure whisper parameters
+    // Change 1: Revert to Greedy (Mission 5 fix caused crash with Beam)
+    whisper_full_params params = whisper_full_default_params (WHISPER_SAMPLING_GREEDY);
+    
+    params.print_realtime   = false;
+    params.print_progress   = false;
+    params.print_timestamps = true;
+    params.print_special    = false;
+    params.translate        = false;
+    params.language         = (model != nullptr && whisper_is_multilingual (model->getContext())) ? language.toRawUTF8() : "en";
+    params.detect_language  = false;
+    params.n_threads        = getNumThreads();
+    params.offset_ms        = 0;
+    params.duration_ms      = 0;
+    
+    // Anti-Hallucination settings (Updated for Mission 5, Kept for Mission 5.1)
+    params.suppress_blank   = true;
+    params.suppress_non_speech_tokens = true;
+    params.no_context       = true;
+    params.audio_ctx        = 0; 
+    params.entropy_thold    = 2.0f;
+
+    // Change 4: Stricter gating (Kept)
+    params.logprob_thold    = -1.0f; // More conservative (was -0.5f)
+    params.no_speech_thold  = 0.6f;  // Higher threshold for silence (was 0.3f)
+
+    params.max_len          = 0;
+    params.token_timestamps = true;
+    params.split_on_word    = true;
+    
+    // Change 2: Beam search settings (Reverted/Ignored for Greedy)
+    params.beam_search.beam_size = -1; // Default/Disabled
+    params.greedy.best_of        = 5; 
+    
+    params.temperature      = 0.0f;
+    params.temperature_inc  = 0.0f;
+    
+    // Change 3: Neutral prompt (Kept)
+    params.initial_prompt   = "Transcribe the vocal words you can clearly hear. If unsure, output nothing.";
+
+    // whisper_full is blocking; the abort callback lets cancelTranscription() stop it between graph evaluations.
+    params.abort_callback = [] (void* userData) { return static_cast<const WhisperEngine*> (userData)->shouldCancel.load(); };
+    params.abort_callback_user_data = const_cast<WhisperEngine*> (this);
+
+    return params;
+}
+
+bool WhisperEngine::runInference (whisper_full_params params, const float* samples, int numSamples)
+{
+    const double audioSeconds = static_cast<double> (numSamples) / WHISPER_SAMPLE_RATE;
+
+    // Short clips: encode only the frames that hold audio instead of the full 30 s window
+    if (params.audio_ctx == 0 && adaptiveAudioContext.load())
+        params.audio_ctx = chooseAudioContext (audioSeconds);
+
+    DBG ("WhisperEngine: Running whisper inference (audio_ctx "
+         + (params.audio_ctx > 0 ? juce::String (params.audio_ctx) : juce::String ("full")) + ")...");
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    // Tracing: an encoder runs from its begin callback to the first token's
+    // logits; decoding from there to the next encoder (or the end)
+    if (trace != nullptr)
+    {
+        params.encoder_begin_callback = [] (whisper_context*, whisper_state*, void* userData)
+        {
+            auto* engine = static_cast<WhisperEngine*> (userData);
+            engine->closeTraceSpans();
+            engine->encoderStartMs = TranscriptionTrace::now();
+            return !engine->shouldCancel.load();
+        };
+        params.encoder_begin_callback_user_data = this;
+
+        params.logits_filter_callback = [] (whisper_context*, whisper_state*, const whisper_token_data*, int, float*, void* userData)
+        {
+            auto* engine = static_cast<WhisperEngine*> (userData);
+
+            if (engine->encoderStartMs > 0.0)
+            {
+                engine->decoderStartMs = TranscriptionTrace::now();
+                engine->trace->add (TranscriptionStage::Encoder, engine->encoderStartMs, engine->decoderStartMs);
+                engine->encoderStartMs = 0.0;
+            }
+        };
+        params.logits_filter_callback_user_data = this;
+    }
+    
+    // Each engine has its own state, so the shared model context is never written to here.
+    stateHasReducedContext = params.audio_ctx > 0;
+    int result = whisper_full_with_state (model->getContext(), state, params, samples, numSamples);
+    closeTraceSpans();
+    
+    if (result == 0 && !shouldCancel && params.audio_ctx > 0 && resultLooksDegraded (audioSeconds))
+    {
+        // A truncated context can make whisper loop or drift; pay for the full window instead
+        DBG ("WhisperEngine: Reduced context result looks wrong, retrying with full context");
+        params.audio_ctx = 0;
+        stateHasReducedContext = false;
+        result = whisper_full_with_state (model->getContext(), state, params, samples, numSamples);
+        closeTraceSpans();
+    }
+
+    if (result != 0)
+    {
+        DBG ("WhisperEngine: Transcription failed with code: " + juce::String (result));
+        return false;
+    }
+
+    DBG ("WhisperEngine: Inference took " + juce::String (juce::Time::getMillisecondCounterHiRes() - startTime, 0)
+         + " ms for " + juce::String (audioSeconds, 1) + " s of audio");
+    
+    return !shouldCancel;
+}
+
+void WhisperEngine::closeTraceSpans()
+{
+    if (trace == nullptr)
+        return;
+
+    // An encoder with no token after it (silence, cancel) still took its time
+    if (encoderStartMs > 0.0)
+        trace->addUntilNow (TranscriptionStage::Encoder, encoderStartMs);
+
+    if (decoderStartMs > 0.0)
+        trace->addUntilNow (TranscriptionStage::Decoder, decoderStartMs);
+
+    encoderStartMs = 0.0;
+    decoderStartMs = 0.0;
+}
+
+int WhisperEngine::chooseAudioContext (double audioSeconds) noexcept
+{
+    // The encoder produces 50 frames per second, 1500 for a full 30 s window.
+    // Round up (with a little slack) to a bucket so that the graph shapes stay
+    // few and the model always sees some trailing silence; very small
+    // contexts are unreliable, so never go below one bucket.
+    constexpr int framesPerSecond = 50;
+    constexpr int fullContext = 1500;
+    constexpr int bucket = 256;
+    constexpr int slackFrames = 64;
+
+    const int needed = static_cast<int> (std::ceil (audioSeconds * framesPerSecond)) + slackFrames;
+    const int bucketed = juce::jmax (bucket, ((needed + bucket - 1) / bucket) * bucket);
+
+    return bucketed >= fullContext ? 0 : bucketed;
+}
+
+bool WhisperEngine::resultLooksDegraded (double audioSeconds) const
+{
+    const int numSegments = whisper_full_n_segments_from_state (state);
+
+    // No speech is a normal outcome for a short clip, not a failure
+    if (numSegments == 0)
+        return false;
+
+    const auto eot = whisper_token_eot (model->getContext());
+    float probabilitySum = 0.0f;
+    int numTokens = 0;
+    juce::String previousText;
+
+    for (int i = 0; i < numSegments; ++i)
+    {
+        // Timestamps past the end of the audio: the decoder is inventing content
+        if (static_cast<double> (whisper_full_get_segment_t1_from_state (state, i)) / 100.0 > audioSeconds + 1.0)
+            return true;
+
+        // The same line over and over: the classic repetition loop
+        auto text = juce::String::fromUTF8 (whisper_full_get_segment_text_from_state (state, i)).trim();
+        if (text.isNotEmpty() && text == previousText)
+            return true;
+        previousText = text;
+
+        for (int j = 0; j < whisper_full_n_tokens_from_state (state, i); ++j)
+        {
+            const auto data = whisper_full_get_token_data_from_state (state, i, j);
+
+            if (data.id < eot)
+            {
+                probabilitySum += data.p;
+                ++numTokens;
+            }
+        }
+    }
+
+    return numTokens > 0 && probabilitySum / static_cast<float> (numTokens) < 0.45f;
+}
+
+VoxSegment WhisperEngine::makeSegment (int segmentIndex, double timeOffsetSeconds) const
+{
+    auto* ctx = model->getContext();
+    const auto eot = whisper_token_eot (ctx);
+
+    VoxSegment segment;
+    segment.text = juce::String::fromUTF8 (whisper_full_get_segment_text_from_state (state, segmentIndex));
+    segment.startTime = timeOffsetSeconds + static_cast<double> (whisper_full_get_segment_t0_from_state (state, segmentIndex)) / 100.0;
+    segment.endTime = timeOffsetSeconds + static_cast<double> (whisper_full_get_segment_t1_from_state (state, segmentIndex)) / 100.0;
+
+    // One VoxWord per word, built from token timestamps: a token starting with
+    // a space begins a new word, others continue the current one.
+    // Confidence is the mean token probability of the word.
+    const int numTokens = whisper_full_n_tokens_from_state (state, segmentIndex);
+    int tokensInWord = 0;
+    float probabilitySum = 0.0f;
+
+    auto finishWord = [&]
+    {
+        if (tokensInWord > 0 && !segment.words.isEmpty())
+            segment.words.getReference (segment.words.size() - 1).confidence = probabilitySum / static_cast<float> (tokensInWord);
+
+        tokensInWord = 0;
+        probabilitySum = 0.0f;
+    };
+
+    for (int j = 0; j < numTokens; ++j)
+    {
+        const auto data = whisper_full_get_token_data_from_state (state, segmentIndex, j);
+
+        if (data.id >= eot) // Special and timestamp tokens
+            continue;
+
+        const auto tokenText = juce::String::fromUTF8 (whisper_full_get_token_text_from_state (ctx, state, segmentIndex, j));
+        const double t0 = data.t0 >= 0 ? timeOffsetSeconds + static_cast<double> (data.t0) / 100.0 : segment.startTime;
+        const double t1 = data.t1 >= 0 ? timeOffsetSeconds + static_cast<double> (data.t1) / 100.0 : segment.endTime;
+
+        if (segment.words.isEmpty() || tokenText.startsWithChar (' '))
+        {
+            finishWord();
+
+            VoxWord word;
+            word.text = tokenText;
+            word.startTime = t0;
+            word.endTime = t1;
+            segment.words.add (word);
+        }
+        else
+        {
+            auto& word = segment.words.getReference (segment.words.size() - 1);
+            word.text += tokenText;
+            word.endTime = juce::jmax (word.endTime, t1);
+        }
+
+        ++tokensInWord;
+        probabilitySum += data.p;
+    }
+
+    finishWord();
+
+    // No usable tokens (shouldn't happen): fall back to one word for the whole segment
+    if (segment.words.isEmpty() && segment.text.isNotEmpty())
+    {
+        VoxWord word;
+        word.text = segment.text;
+        word.startTime = segment.startTime;
+        word.endTime = segment.endTime;
+        word.confidence = 1.0f;
+        segment.words.add (word);
+    }
+
+    return segment;
+}
+
+VoxSequence WhisperEngine::transcribeWindowed (const std::vector<float>& pcmData, const TranscriptStitcher::Progress* resumeFrom)
+{
+    const double audioSeconds = static_cast<double> (pcmData.size()) / WHISPER_SAMPLE_RATE;
+    const auto windows = TranscriptStitcher::planWindows (audioSeconds, maxBatchSeconds);
+
+    DBG ("WhisperEngine: Transcribing " + juce::String (audioSeconds, 1) + " s as "
+         + juce::String ((int) windows.size()) + " overlapping windows");
+
+    TranscriptStitcher stitcher;
+    double resumeAfterSeconds = 0.0;
+
+    if (resumeFrom != nullptr)
+    {
+        stitcher.resume (*resumeFrom);
+        resumeAfterSeconds = resumeFrom->lastWindow.getEnd();
+    }
+
+    bool transcribedWindow = false;
+    int numStreamed = 0;
+
+    for (const auto& window : windows)
+    {
+        // Done before the pass was preempted
+        if (window.getEnd() <= resumeAfterSeconds)
+            continue;
+
+        // Window boundary: give way to more relevant work, keeping what is done
+        if (transcribedWindow && preemptionCheck != nullptr && preemptionCheck())
+        {
+            DBG ("WhisperEngine: Preempted at " + juce::String (window.getStart(), 1) + " s");
+            preemptedProgress = std::make_shared<const TranscriptStitcher::Progress> (stitcher.getProgress());
+            return {};
+        }
+
+        auto params = makeDefaultParams();
+
+        // Carry the text so far into the next window, so words cut at the
+        // seam are continued rather than guessed (whisper's own seeking
+        // discards this context with no_context set)
+        const auto prompt = stitcher.getPromptText();
+        if (prompt.isNotEmpty())
+            params.initial_prompt = prompt.toRawUTF8();
+
+        const auto first = juce::jmin (pcmData.size(), static_cast<size_t> (window.getStart() * WHISPER_SAMPLE_RATE));
+        const auto count = juce::jmin (pcmData.size() - first, static_cast<size_t> (window.getLength() * WHISPER_SAMPLE_RATE));
+
+        if (!runInference (params, pcmData.data() + first, static_cast<int> (count)))
+            return {};
+
+        VoxSequence windowResult;
+        for (int i = 0; i < whisper_full_n_segments_from_state (state); ++i)
+            windowResult.addSegment (makeSegment (i, window.getStart()));
+
+        stitcher.addWindow (windowResult, window);
+        transcribedWindow = true;
+
+        if (checkpointCallback != nullptr && window != windows.back())
+            checkpointCallback (stitcher.getProgress());
+
+        // Segments the next seam can't reach are final for this pass
+        if (segmentCallback != nullptr)
+        {
+            const auto& stitched = stitcher.getSegments();
+            const int numSettled = stitcher.getNumSettledSegments (window.getEnd() - TranscriptStitcher::defaultOverlapSeconds);
+
+            for (; numStreamed < numSettled; ++numStreamed)
+                segmentCallback (stitched.getReference (numStreamed));
+        }
+    }
+
+    return stitcher.getResult();
+}
+
+float WhisperEngine::getSegmentConfidence (const VoxSegment& segment)
+{
+    if (segment.words.isEmpty())
+        return 0.0f;
+
+    float sum = 0.0f;
+    for (const auto& word : segment.words)
+        sum += word.confidence;
+
+    return sum / static_cast<float> (segment.words.size());
+}
+
+VoxSequence WhisperEngine::refineLowConfidenceSegments (const VoxSequence& greedy, const std::vector<float>& pcmData,
+                                                       const MelSpectrogram* spectrogram)
+{
+    // Beam search only where greedy decoding was unsure. The 30 s window
+    // around an unsure segment is encoded once and retained; the beam search
+    // itself (WhisperWindowDecoder's, not whisper_full's, which crashed, see
+    // makeDefaultParams) only runs the decoder, over the segment's time range.
+    // Later unsure segments in the same window reuse its encoder output.
+    const double audioSeconds = static_cast<double> (pcmData.size()) / WHISPER_SAMPLE_RATE;
+    double budgetSeconds = audioSeconds * maxBeamFraction;
+    constexpr double paddingSeconds = 0.3;
+
+    VoxSequence refined;
+    int numRedecoded = 0;
+    int numImproved = 0;
+    int numEncoded = 0;
+    double windowStart = -1.0;
+
+    for (const auto& segment : greedy.getSegments())
+    {
+        const float confidence = getSegmentConfidence (segment);
+        const double start = juce::jmax (0.0, segment.startTime - paddingSeconds);
+        const double end = juce::jmin (audioSeconds, segment.endTime + paddingSeconds);
+
+        if (confidence >= beamConfidenceThreshold || end - start > budgetSeconds || end <= start || shouldCancel)
+        {
+            refined.addSegment (segment);
+            continue;
+        }
+
+        // A new window only once the segment runs past the current one
+        if (windowStart < 0.0 || start < windowStart || end > windowStart + maxBatchSeconds)
+        {
+            windowStart = start;
+            ++numEncoded;
+        }
+
+        const auto windowKey = juce::String (windowStart, 2);
+
+        if (retainEncodedWindow (windowKey, pcmData, spectrogram, windowStart) == nullptr)
+        {
+            refined.addSegment (segment);
+            continue;
+        }
+
+        budgetSeconds -= end - start;
+        ++numRedecoded;
+
+        WindowDecodeOptions options;
+        options.language = language;
+        options.beamSize = refineBeamSize;
+        options.fromSeconds = start - windowStart;
+        options.toSeconds = end - windowStart;
+        options.numThreads = getNumThreads();
+
+        // The text before it, as whisper's windows are prompted
+        if (!refined.getSegments().isEmpty())
+            options.initialPrompt = refined.getSegmentText (refined.getNumSegments() - 1);
+
+        const auto decoded = redecodeWindow (windowKey, options);
+        VoxSequence candidate;
+
+        for (auto beamSegment : decoded.getSegments())
+        {
+            // Keep the replacement inside the original segment's slot
+            beamSegment.startTime = juce::jmax (beamSegment.startTime, segment.startTime);
+            beamSegment.endTime = juce::jmin (beamSegment.endTime, segment.endTime);
+
+            if (beamSegment.text.trim().isNotEmpty())
+                candidate.addSegment (beamSegment);
+        }
+
+        float candidateConfidence = 0.0f;
+        for (const auto& s : candidate.getSegments())
+            candidateConfidence += getSegmentConfidence (s) / static_cast<float> (candidate.getSegments().size());
+
+        if (!candidate.getSegments().isEmpty() && candidateConfidence > confidence)
+        {
+            for (const auto& s : candidate.getSegments())
+                refined.addSegment (s);
+
+            ++numImproved;
+        }
+        else
+        {
+            refined.addSegment (segment);
+        }
+    }
+
+    if (numRedecoded > 0)
+        DBG ("WhisperEngine: Beam re-decoded " + juce::String (numRedecoded) + " low-confidence segments in "
+             + juce::String (numEncoded) + " encoded windows, " + juce::String (numImproved) + " improved");
+
+    return refined;
+}
+
+bool WhisperEngine::isJunkResult (const VoxSequence& sequence)
+{
+    // Change 5b: Check total text length to filter out noise/junk
+    // Using a minimal length check (e.g. < 2 chars)
+    juce::String combinedText;
+
+    for (const auto& segment : sequence.getSegments())
+        combinedText += segment.text;
+
+    if (combinedText.trim().length() < 2)
+    {
+        DBG ("WhisperEngine: Result too short ('" + combinedText + "'), treating as silence.");
+        return true;
+    }
+
+    return false;
+}
+
+void WhisperEngine::loadModel()
+{
+    auto info = WhisperModelCatalogue::resolve (requestedModelId);
+
+    if (!info.isValid())
+    {
+        DBG ("WhisperEngine: No model installed in " + WhisperModelCatalogue::getModelsDirectory().getFullPathName());
+        return;
+    }
+
+    if (info.id != requestedModelId)
+        DBG ("WhisperEngine: Model '" + requestedModelId + "' not installed, falling back to '" + info.id + "'");
+
+    model = modelCache->acquire (info, [this] { return shouldCancel.load(); });
+
+    if (model == nullptr)
+    {
+        DBG ("WhisperEngine: Failed to init whisper context.");
+        return;
+    }
+
+    state = whisper_init_state (model->getContext());
+
+    if (state == nullptr)
+    {
+        DBG ("WhisperEngine: Failed to allocate whisper state.");
+        model.reset();
+    }
+    else
+    {
+        DBG ("WhisperEngine: Model ready (" + info.id + ").");
+    }
+}
+
+void WhisperEngine::unloadModel()
+{
+    // Retained windows belong to the model being released
+    releaseEncodedWindows();
+
+    if (state != nullptr)
+    {
+        whisper_free_state (state);
+        state = nullptr;
+        stateHasReducedContext = false;
+    }
+
+    model.reset();
 }
 
 } // namespace VoxScript
@@ -17,11 +17,23 @@
 #include <juce_events/juce_events.h>
 #include "VoxSequence.h"
 #include "../engine/AudioCache.h"
+#include "../engine/MelSpectrogramService.h"
 #include "AudioExtractor.h"
+#include "WhisperModelCatalogue.h"
+#include "WhisperModelCache.h"
+#include "WhisperWindowDecoder.h"
+#include "TranscriptStitcher.h"
+#include "SourceRanges.h"
+#include "TranscriptionTrace.h"
 #include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
 
-// Forward declare whisper_context from whisper.h (global namespace)
-struct whisper_context;
+// Forward declare whisper types from whisper.h (global namespace)
+struct whisper_state;
+struct whisper_full_params;
 
 namespace VoxScript
 {
@@ -41,7 +53,7 @@ namespace VoxScript
  * - No allocations on audio thread
  * 
  * Phase II: Basic transcription with ggml-base.en model
- * Phase III: Model selection, cancellation, queue management
+ * Phase III: Model selection (see WhisperModelCatalogue), cancellation, queue management
  */
 class WhisperEngine
 {
@@ -57,9 +69,34 @@ public:
      * This blocks until transcription is complete or cancelled.
      * 
      * @param audioFile Path to audio file
+     * @param sourceID  If set (and a spectrogram service is attached), the
+     *                  source's cached spectrogram is reused, and
+     *                  computeDetailSpectrogram() can compute it afterwards
      * @return VoxSequence Resulting transcription (empty on failure/cancel)
      */
-    VoxSequence processSync (const juce::File& audioFile);
+    VoxSequence processSync (const juce::File& audioFile, AudioSourceID sourceID = 0);
+
+    /**
+     * @brief Transcribe only some ranges of an audio file (see SourceRanges).
+     * The ranges are packed with silence between them and transcribed in one
+     * pass; the result is in file (source) time. The whole file's audio is
+     * kept for computeDetailSpectrogram() if the service has no spectrogram
+     * of it. Empty ranges: same as processSync().
+     */
+    VoxSequence processRanges (const juce::File& audioFile, const SourceRanges::RangeList& ranges, AudioSourceID sourceID = 0);
+
+    /**
+     * @brief Process mono 16 kHz samples synchronously (see processSync()).
+     * Used by the out-of-process worker, which receives audio already decoded.
+     */
+    VoxSequence processSamples (const float* samples, size_t numSamples, AudioSourceID sourceID = 0);
+
+    /**
+     * Read a file as mono float PCM at 16 kHz. False on failure or cancel.
+     * Decodes in blocks, so peak memory is the output plus one block.
+     * Needs no model.
+     */
+    bool readPcm16k (const juce::File& audioFile, std::vector<float>& pcmData);
 
     /**
      * @brief Process an audio source synchronously.
@@ -70,31 +107,415 @@ public:
      */
     VoxSequence processSync (juce::ARAAudioSource* source);
 
+    /**
+     * @brief Transcribe several short files in one whisper pass.
+     * The clips are packed into one buffer separated by silence guards, so a
+     * batch of short takes pays for a single 30 s encoder window instead of
+     * one each. Words are assigned back to their clip by time offset and
+     * returned in clip-local time.
+     * 
+     * Callers should keep the packed length (clips plus guards) within
+     * maxBatchSeconds; longer batches still work but lose the benefit.
+     * 
+     * @param audioFiles Files to transcribe
+     * @param sourceIDs  Optional, per file, as for processSync()
+     * @return One VoxSequence per input file, in order (empty on failure/cancel)
+     */
+    std::vector<VoxSequence> processBatch (const std::vector<juce::File>& audioFiles,
+                                           const std::vector<AudioSourceID>& sourceIDs = {});
+
+    /**
+     * @brief Decode the audio of the last pass again, e.g. in another language.
+     * The audio is still in memory, so nothing is read; windows the beam
+     * refinement kept encoded are decoder-only, the others are encoded
+     * again (WhisperWindowDecoder, greedy). The audio and its windows are
+     * held until the next pass, language probe or model release.
+     * @return In the same time as that pass's result; empty if no audio is
+     *         held (see holdsAudioOf()), on failure or on cancel
+     */
+    VoxSequence redecode (const juce::String& languageCode, const juce::String& initialPrompt = {});
+
+    /**
+     * True if the last pass was processSync() or processRanges() of this
+     * source with these ranges, and redecode() can decode it again.
+     */
+    bool holdsAudioOf (AudioSourceID sourceID, const SourceRanges::RangeList& ranges = {}) const
+    {
+        return sourceID != 0 && sourceID == heldSourceID && ranges == heldRanges;
+    }
+
+    /**
+     * @brief Compute a source's spectrogram for the Detail View, if the
+     * spectrogram service has none.
+     *
+     * The passes don't need it (whisper_full computes its own mel), so the
+     * queue calls this once their results are published. Reads the whole
+     * file's audio as the last processSync(), processRanges() or
+     * processBatch() decoded it; nothing if that wasn't this source.
+     * generation: see MelSpectrogramService::getGeneration().
+     */
+    void computeDetailSpectrogram (AudioSourceID sourceID, juce::uint64 generation);
+
+    //==========================================================================
+    // Language
+
+    /**
+     * @brief Language used by subsequent passes (whisper code, e.g. "de").
+     * Empty means English. English-only models always decode English.
+     */
+    void setLanguage (const juce::String& languageCode);
+    juce::String getLanguage() const { return language; }
+
+    /**
+     * @brief Detect the spoken language of a file, once.
+     * Runs whisper's language probe on the first 30 s window that contains
+     * speech (found by the spectrogram VAD) with the current model, feeding
+     * the shared spectrogram as encoder input. No decoding happens.
+     * @return Language code, "en" for English-only models, empty on failure
+     */
+    juce::String detectLanguage (const juce::File& audioFile, AudioSourceID sourceID = 0);
+
+    /** detectLanguage() on mono 16 kHz samples. */
+    juce::String detectLanguage (const float* samples, size_t numSamples, AudioSourceID sourceID = 0);
+
+    /**
+     * Content generation of the audio detectLanguage() is given, which its
+     * spectrogram is cached under (see MelSpectrogramService::getGeneration()).
+     */
+    void setSpectrogramGeneration (juce::uint64 generation) noexcept { spectrogramGeneration = generation; }
+
+    /**
+     * @brief Describes the decode settings that affect the transcript.
+     * Part of the TranscriptionResultCache key, so a settings change never
+     * returns results decoded the old way.
+     * @param batched   For processBatch(), which skips the beam refinement
+     */
+    juce::String getDecodeSignature (bool batched = false) const;
+
+    /**
+     * @brief Encode only as much audio context as the clip needs.
+     * whisper always encodes a 30 s window (1500 frames); for a 3 s ad-lib
+     * most of that is padding. When enabled (default), the encoder context is
+     * sized to the clip, and results that look wrong are re-run with the
+     * full context.
+     */
+    void setAdaptiveAudioContext (bool shouldAdapt) noexcept { adaptiveAudioContext.store (shouldAdapt); }
+
+    /**
+     * @brief Re-decode low-confidence segments with beam search.
+     * After the greedy pass, segments whose mean token probability is below
+     * beamConfidenceThreshold are decoded again with beam search, limited to
+     * maxBeamFraction of the audio per job. The window around a segment is
+     * encoded once and kept, so its other unsure segments and every beam
+     * hypothesis are decoder-only (WhisperWindowDecoder, not whisper_full's
+     * beam search). A re-decoded segment replaces the greedy one only if it
+     * is more confident. Default on (VOXSCRIPT_SELECTIVE_BEAM=0 turns it
+     * off); whisper_full's own beam search, which crashed (see
+     * makeDefaultParams()), stays unused. processSync() and processRanges()
+     * only, never processBatch(). "VoxScriptBenchmark rebeam" checks it.
+     */
+    void setSelectiveBeamSearch (bool shouldRefine) noexcept { selectiveBeamSearch.store (shouldRefine); }
+
+    /**
+     * @brief Transcribe long sources as overlapping windows (default on).
+     * Sources longer than one window are split into maxBatchSeconds windows
+     * overlapping by TranscriptStitcher::defaultOverlapSeconds; each window is
+     * prompted with the tail of the text so far, and the seams are stitched
+     * by TranscriptStitcher. Off: whisper seeks through the audio itself,
+     * without context between its windows.
+     */
+    void setOverlappedWindows (bool shouldOverlap) noexcept { overlappedWindows.store (shouldOverlap); }
+
+    /**
+     * @brief Let a windowed pass give way at window boundaries.
+     * Polled before each overlapped window after the first one the current
+     * call transcribed. Returning true stops the pass: processSync() returns
+     * an empty sequence and takePreemptedProgress() the windows done so far.
+     * Called on the thread running processSync(); nullptr disables.
+     */
+    void setPreemptionCheck (std::function<bool()> check) { preemptionCheck = std::move (check); }
+
+    /** Progress of the last pass if it was preempted, else nullptr. Cleared by the next pass. */
+    std::shared_ptr<const TranscriptStitcher::Progress> takePreemptedProgress() { return std::move (preemptedProgress); }
+
+    /**
+     * @brief Continue a preempted pass with the next processSync() of the same audio.
+     * Windows up to progress->lastWindow are skipped. Used once, then cleared.
+     */
+    void setResumeProgress (std::shared_ptr<const TranscriptStitcher::Progress> progress) { resumeProgress = std::move (progress); }
+
+    /**
+     * @brief Receive the progress of a windowed pass after each window but the last.
+     * Enough for setResumeProgress() to continue the pass after a crash; the
+     * job queue writes it to the TranscriptionJournal. Called on the thread
+     * running processSync(); nullptr disables.
+     */
+    void setCheckpointCallback (std::function<void (const TranscriptStitcher::Progress&)> callback) { checkpointCallback = std::move (callback); }
+
+    /**
+     * @brief Receive segments of a long pass while it is still running.
+     * Called on the thread running processSync(), in time order, with each
+     * segment once the pass itself won't change it: per whisper segment for
+     * a single pass, per settled stitched segment for overlapped windows.
+     * Audio that fits one window isn't streamed. The returned sequence may
+     * still differ (beam refinement, junk filter), so streamed segments are
+     * provisional. nullptr disables.
+     */
+    void setSegmentCallback (std::function<void (const VoxSegment&)> callback) { segmentCallback = std::move (callback); }
+
+    /**
+     * @brief Record model load, audio decode, encoder and decoder spans here.
+     * Not owned; set by the job queue around a job, nullptr (default) disables.
+     * The encoder/decoder split needs whisper callbacks, so they are only
+     * installed while tracing.
+     */
+    void setTrace (TranscriptionTrace* traceToFill) noexcept { trace = traceToFill; }
+
+    static constexpr float beamConfidenceThreshold = 0.6f;
+    static constexpr double maxBeamFraction = 0.25;
+    static constexpr int refineBeamSize = 4;
+
+    /** Encoder context (audio_ctx) for a clip of the given length; 0 means the full window. */
+    static int chooseAudioContext (double audioSeconds) noexcept;
+
+    /** Silence inserted before, between and after clips in a batch. */
+    static constexpr double batchGuardSeconds = 1.0;
+
+    /** Length of one whisper encoder window; the budget for a packed batch. */
+    static constexpr double maxBatchSeconds = 30.0;
+
+    /** Packed length of a batch with the given clip durations, guards included. */
+    static double getPackedBatchSeconds (double totalClipSeconds, int numClips) noexcept
+    {
+        return totalClipSeconds + batchGuardSeconds * (numClips + 1);
+    }
+
     /**
      * Cancel ongoing transcription
-     * Thread-safe.
+     * Thread-safe. The engine never clears the flag itself: it stays set,
+     * and every call returns early, until the owner calls
+     * resetCancellation() for its next job. A cancel that lands before a
+     * call starts is therefore never lost.
      */
     void cancelTranscription();
+
+    /**
+     * Clear a cancel, when the owner starts a new job. Call it where jobs
+     * are dequeued, under the same lock as the cancel, so a cancel meant
+     * for the new job can't be cleared by it. Thread-safe.
+     */
+    void resetCancellation() noexcept { shouldCancel = false; }
     
     /** Set the AudioCache to use for extraction */
     void setAudioCache(AudioCache* cache) { audioCache = cache; }
 
+    /**
+     * Threads per inference (0 = WhisperSystemInfo::getRecommendedThreadCount()).
+     * Lowered when several engines run side by side, so together they use the
+     * cores once rather than each using all of them.
+     */
+    void setNumThreads (int threads) noexcept { numThreads.store (threads); }
+
+    /** Share per-source spectrograms through this service (optional, not owned). */
+    void setSpectrogramService (MelSpectrogramService* service) { spectrogramService = service; }
+
+    //==========================================================================
+    // Model selection
+
+    /**
+     * @brief Select the model used by subsequent processSync() calls.
+     * The previous model is released and the new one is loaded lazily on the
+     * next job, so switching does not require a new engine instance.
+     * An empty id selects WhisperModelCatalogue::defaultModelId.
+     * Must be called from the thread that runs processSync().
+     */
+    void setModel (const juce::String& modelId);
+
+    /** Id of the model requested via setModel(). */
+    juce::String getRequestedModelId() const { return requestedModelId; }
+
+    /**
+     * @brief Free our inference state and drop the model reference.
+     * Called by the job queue after it has been idle for a while; the model
+     * is reloaded on demand by the next job.
+     */
+    void releaseModel();
+
+    /** True if a model and state are currently held. */
+    bool hasLoadedModel() const noexcept { return state != nullptr; }
+
+    /** Id of the model currently loaded (empty if none). */
+    juce::String getLoadedModelId() const { return model != nullptr ? model->getInfo().id : juce::String(); }
+
 private:
     //==========================================================================
     // Internal state
-    ::whisper_context* ctx = nullptr;
+    // The model weights are shared process-wide; the inference state is ours.
+    juce::SharedResourcePointer<WhisperModelCache> modelCache;
+    std::shared_ptr<WhisperModel> model;
+    ::whisper_state* state = nullptr;
+    bool stateHasReducedContext = false; // Its last whisper_full ran with audio_ctx below the full window
     
     //==========================================================================
     /**
-     * Load whisper model from disk
+     * Acquire the requested model from the shared cache and create our state
      */
     void loadModel();
+
+    /** Free our state and drop the model reference. */
+    void unloadModel();
+
+    //==========================================================================
+    // Encoded window retention (decode-only reruns)
+
+    /** A window whose encoder output lives in its own state. */
+    struct EncodedWindow
+    {
+        juce::String key;
+        ::whisper_state* state = nullptr;
+        double startSeconds = 0.0;
+        double lengthSeconds = 0.0;
+        juce::uint32 lastUsedMs = 0;
+    };
+
+    /**
+     * Encode up to 30 s of pcmData from startSeconds and keep the encoder
+     * output under windowKey, so redecodeWindow() can decode it again with
+     * other settings without the mel or encoder. The mel comes from the
+     * source's spectrogram if given. Beyond maxRetainedWindows, the least
+     * recently used window's state is re-encoded rather than reallocated.
+     * @return The retained window, or nullptr if encoding failed
+     */
+    const EncodedWindow* retainEncodedWindow (const juce::String& windowKey, const std::vector<float>& pcmData,
+                                              const MelSpectrogram* spectrogram, double startSeconds);
+
+    /**
+     * Decode a retained window again; options.fromSeconds/toSeconds are
+     * within the window.
+     * @return Times relative to the audio; empty if the window isn't retained or on cancel
+     */
+    VoxSequence redecodeWindow (const juce::String& windowKey, const WindowDecodeOptions& options);
+
+    /** Free all retained windows (also done when the model changes or is released). */
+    void releaseEncodedWindows();
+
+    /** pcmArena is about to be overwritten: redecode() and computeDetailSpectrogram() have nothing to read. */
+    void forgetHeldAudio();
+
+    std::vector<EncodedWindow> encodedWindows;
+
+    /**
+     * Two: the refinement walks the audio in order and never goes back a
+     * window, and redecode() can still start in the last window it used.
+     * Each one is a whole whisper_state.
+     */
+    static constexpr int maxRetainedWindows = 2;
+
+    // The audio in pcmArena, for redecode() (thread running processSync() only)
+    AudioSourceID heldSourceID = 0;
+    SourceRanges::RangeList heldRanges;
+
+    // Whole-file audio of the last pass that isn't in pcmArena (ranged pass,
+    // batched clips), until computeDetailSpectrogram() takes it
+    std::map<AudioSourceID, std::vector<float>> detailAudio;
+
+    /** True if the service should get this source's spectrogram after the pass. */
+    bool needsDetailSpectrogram (AudioSourceID sourceID) const;
+
+    /** The source's spectrogram from the service, or a private one. */
+    std::shared_ptr<const MelSpectrogram> getSpectrogram (AudioSourceID sourceID, const std::vector<float>& pcmData);
+
+    /** Feed one 30 s window of a spectrogram to whisper instead of its own mel. */
+    bool setMelWindow (::whisper_state* targetState, const MelSpectrogram& spectrogram, int startFrame);
+
+    /** setNumThreads(), or the recommended count. */
+    int getNumThreads() const;
+
+    /** readPcm16k() without the tracing. */
+    bool decodePcm16k (const juce::File& audioFile, std::vector<float>& pcmData);
+
+    /** End the open encoder or decoder span, if any (tracing only). */
+    void closeTraceSpans();
+
+    /** Load on first use; false if no model could be loaded. */
+    bool ensureModelLoaded();
+
+    /** processSync() and processSamples() once the audio is in pcmArena. */
+    VoxSequence transcribePcm (AudioSourceID sourceID);
+
+    /** detectLanguage() once the audio is in pcmArena. */
+    juce::String detectLanguageInPcm (AudioSourceID sourceID);
+
+    /** Decode settings shared by all passes. */
+    whisper_full_params makeDefaultParams() const;
+
+    /**
+     * Run whisper_full on our state. False on failure or cancel.
+     * Applies the adaptive encoder context unless params.audio_ctx is set.
+     */
+    bool runInference (whisper_full_params params, const float* samples, int numSamples);
+
+    /** Sanity check of a reduced-context result (loops, drift, low confidence). */
+    bool resultLooksDegraded (double audioSeconds) const;
+
+    /** Convert result segment i to a VoxSegment with one VoxWord per word. */
+    VoxSegment makeSegment (int segmentIndex, double timeOffsetSeconds) const;
+
+    /**
+     * Overlapping windows with prompt carry-over, see setOverlappedWindows().
+     * Continues after resumeFrom if given; may stop early, see setPreemptionCheck().
+     */
+    VoxSequence transcribeWindowed (const std::vector<float>& pcmData, const TranscriptStitcher::Progress* resumeFrom);
+
+    /**
+     * Second stage: beam search over segments the greedy pass was unsure of,
+     * on retained encoder windows. spectrogram (the source's, may be null)
+     * is their mel input. The windows stay retained for redecode().
+     */
+    VoxSequence refineLowConfidenceSegments (const VoxSequence& greedy, const std::vector<float>& pcmData,
+                                             const MelSpectrogram* spectrogram);
+
+    /** Mean word confidence of a segment. */
+    static float getSegmentConfidence (const VoxSegment& segment);
+
+    /** True if the text is too short to be anything but noise. */
+    static bool isJunkResult (const VoxSequence& sequence);
     
     //==========================================================================
     // Member Variables
     
     std::atomic<bool> shouldCancel { false };
+
+    // PCM arena: the 16 kHz buffer and read scratch space, kept between jobs
+    // so a long source doesn't reallocate for every pass (freed by releaseModel())
+    std::vector<float> pcmArena;
+    juce::AudioBuffer<float> readBlock;
+    std::vector<float> monoBlock;
+    std::atomic<bool> adaptiveAudioContext { true };
+    std::atomic<bool> selectiveBeamSearch { true };
+    std::atomic<bool> overlappedWindows { true };
+    std::atomic<int> numThreads { 0 };
+
+    // Stage timing of the current job (thread running processSync() only)
+    TranscriptionTrace* trace = nullptr;
+    double encoderStartMs = 0.0;
+    double decoderStartMs = 0.0;
+
+    // Streaming of settled segments (thread running processSync() only)
+    std::function<void (const VoxSegment&)> segmentCallback;
+
+    // Preemption at window boundaries (thread running processSync() only)
+    std::function<bool()> preemptionCheck;
+    std::shared_ptr<const TranscriptStitcher::Progress> resumeProgress;
+    std::shared_ptr<const TranscriptStitcher::Progress> preemptedProgress;
+    std::function<void (const TranscriptStitcher::Progress&)> checkpointCallback;
+
     AudioCache* audioCache = nullptr;
+    MelSpectrogramService* spectrogramService = nullptr;
+    juce::uint64 spectrogramGeneration = 0;
+
+    juce::String requestedModelId { WhisperModelCatalogue::defaultModelId };
+    juce::String language { "en" }; // Owns the string whisper_full_params::language points to
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WhisperEngine)
 };
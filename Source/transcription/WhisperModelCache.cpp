@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+    WhisperModelCache.cpp
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "WhisperModelCache.h"
+#include "WhisperSystemInfo.h"
+#include <whisper.h>
+#include <vector>
+
+namespace VoxScript
+{
+
+//==============================================================================
+WhisperModel::WhisperModel (const WhisperModelInfo& modelInfo, ::whisper_context* context)
+    : info (modelInfo), ctx (context)
+{
+    markUsed();
+    memoryBudget->addUsage (MemoryBudget::Category::Models, getFootprintBytes());
+}
+
+WhisperModel::~WhisperModel()
+{
+    if (ctx != nullptr)
+    {
+        DBG ("WhisperModelCache: Releasing model " + info.id);
+        whisper_free (ctx);
+        ctx = nullptr;
+    }
+
+    memoryBudget->addUsage (MemoryBudget::Category::Models, -getFootprintBytes());
+}
+
+//==============================================================================
+namespace
+{
+    /** whisper_model_loader over a JUCE stream, with an abort hook. */
+    struct AbortableModelReader
+    {
+        juce::InputStream& stream;
+        const std::function<bool()>& shouldAbort;
+
+        static size_t read (void* context, void* output, size_t readSize)
+        {
+            auto& self = *static_cast<AbortableModelReader*> (context);
+
+            // Returning short makes whisper.cpp fail the load cleanly
+            if (self.shouldAbort != nullptr && self.shouldAbort())
+                return 0;
+
+            return static_cast<size_t> (self.stream.read (output, static_cast<int> (readSize)));
+        }
+
+        static bool eof (void* context)
+        {
+            return static_cast<AbortableModelReader*> (context)->stream.isExhausted();
+        }
+
+        static void close (void*) {}
+    };
+}
+
+//==============================================================================
+WhisperModelCache::WhisperModelCache()
+{
+    DBG ("WhisperModelCache: Created");
+
+    reclaimerHandle = memoryBudget->addReclaimer ([this] { return releaseUnusedModels(); });
+}
+
+WhisperModelCache::~WhisperModelCache()
+{
+    memoryBudget->removeReclaimer (reclaimerHandle);
+
+    DBG ("WhisperModelCache: Destroyed");
+}
+
+std::shared_ptr<WhisperModel> WhisperModelCache::acquire (const WhisperModelInfo& info,
+                                                          std::function<bool()> shouldAbort)
+{
+    if (!info.isValid())
+        return nullptr;
+
+    if (auto loaded = findLoaded (info.id))
+    {
+        loaded->markUsed();
+        return loaded;
+    }
+
+    // Only one load at a time: a second caller for the same model waits here
+    // and then finds it in the cache.
+    std::lock_guard<std::mutex> loadLock (loadMutex);
+
+    if (auto loaded = findLoaded (info.id))
+    {
+        loaded->markUsed();
+        return loaded;
+    }
+
+    // The kernels are compiled for a fixed SIMD level; don't run them on a CPU without it
+    juce::String missingFeatures;
+    if (!WhisperSystemInfo::isCpuSupported (missingFeatures))
+    {
+        juce::Logger::writeToLog ("VoxScript: Transcription unavailable, this CPU lacks " + missingFeatures);
+        return nullptr;
+    }
+
+    WhisperSystemInfo::logBackendOnce();
+
+    // Let other consumers (audio caches, unused models) make room first
+    memoryBudget->requestHeadroom ((juce::int64) info.memoryMB * 1024 * 1024);
+
+    auto model = loadFromFile (info, shouldAbort);
+
+    if (model != nullptr)
+    {
+        std::lock_guard<std::mutex> lock (cacheMutex);
+        models[info.id] = model;
+    }
+
+    return model;
+}
+
+std::shared_ptr<WhisperModel> WhisperModelCache::findLoaded (const juce::String& modelId) const
+{
+    std::lock_guard<std::mutex> lock (cacheMutex);
+
+    auto it = models.find (modelId);
+    return it != models.end() ? it->second : nullptr;
+}
+
+juce::int64 WhisperModelCache::releaseIdleModels (juce::RelativeTime idleTimeout)
+{
+    std::vector<std::shared_ptr<WhisperModel>> released;
+    {
+        std::lock_guard<std::mutex> lock (cacheMutex);
+
+        for (auto it = models.begin(); it != models.end(); )
+        {
+            // use_count() == 1: only the cache holds it, no engine is using it
+            if (it->second.use_count() == 1
+                && it->second->getMillisecondsSinceLastUse() >= (juce::uint32) idleTimeout.inMilliseconds())
+            {
+                released.push_back (std::move (it->second));
+                it = models.erase (it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Free outside the lock
+    juce::int64 bytes = 0;
+    for (auto& model : released)
+        bytes += model->getFootprintBytes();
+
+    released.clear();
+    return bytes;
+}
+
+juce::int64 WhisperModelCache::releaseUnusedModels()
+{
+    return releaseIdleModels (juce::RelativeTime());
+}
+
+std::shared_ptr<WhisperModel> WhisperModelCache::loadFromFile (const WhisperModelInfo& info,
+                                                               const std::function<bool()>& shouldAbort)
+{
+    auto modelFile = WhisperModelCatalogue::getModelFile (info);
+
+    DBG ("WhisperModelCache: Loading " + info.displayName + " (~" + juce::String (info.memoryMB) + " MB)");
+
+    // Memory-mapped reads avoid an extra read buffer. whisper.cpp copies the
+    // tensors, so the mapping is only needed for the duration of the load and
+    // saves no model memory; a reload is quick only if the OS still has the
+    // file in its page cache.
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    std::unique_ptr<juce::InputStream> stream;
+
+    if (useMemoryMapping.load())
+    {
+        mappedFile = std::make_unique<juce::MemoryMappedFile> (modelFile, juce::MemoryMappedFile::readOnly);
+
+        if (mappedFile->getData() != nullptr)
+            stream = std::make_unique<juce::MemoryInputStream> (mappedFile->getData(), mappedFile->getSize(), false);
+    }
+
+    if (stream == nullptr)
+    {
+        auto fileStream = std::make_unique<juce::FileInputStream> (modelFile);
+        if (fileStream->openedOk())
+            stream = std::move (fileStream);
+    }
+
+    if (stream == nullptr)
+    {
+        DBG ("WhisperModelCache: Model not found at " + modelFile.getFullPathName());
+        return nullptr;
+    }
+
+    AbortableModelReader reader { *stream, shouldAbort };
+
+    whisper_model_loader loader;
+    loader.context = &reader;
+    loader.read = &AbortableModelReader::read;
+    loader.eof = &AbortableModelReader::eof;
+    loader.close = &AbortableModelReader::close;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    whisper_context_params cparams = whisper_context_default_params();
+    ::whisper_context* ctx = whisper_init_with_params_no_state (&loader, cparams);
+
+    if (ctx == nullptr)
+    {
+        DBG ("WhisperModelCache: Failed to load " + info.id
+             + ((shouldAbort != nullptr && shouldAbort()) ? " (aborted)" : ""));
+        return nullptr;
+    }
+
+    DBG ("WhisperModelCache: Loaded " + info.id + " in "
+         + juce::String (juce::Time::getMillisecondCounterHiRes() - startTime, 0) + " ms");
+
+    return std::make_shared<WhisperModel> (info, ctx);
+}
+
+} // namespace VoxScript
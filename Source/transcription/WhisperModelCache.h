@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    WhisperModelCache.h
+
+    Process-wide cache of loaded whisper.cpp models.
+    Every WhisperEngine (one per worker thread, one set per plugin instance)
+    shares the read-only model weights and only owns its own whisper_state,
+    so a model is loaded once per process no matter how many instances or
+    workers use it.
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "WhisperModelCatalogue.h"
+#include "../engine/MemoryBudget.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// Forward declare whisper_context from whisper.h (global namespace)
+struct whisper_context;
+
+namespace VoxScript
+{
+
+/**
+ * @brief A loaded model: whisper_context without inference state.
+ *
+ * The context only holds weights and vocabulary, which whisper.cpp treats as
+ * read-only during inference, so it can be shared between threads as long as
+ * each thread uses its own whisper_state.
+ */
+class WhisperModel
+{
+public:
+    WhisperModel (const WhisperModelInfo& info, ::whisper_context* ctx);
+    ~WhisperModel();
+
+    const WhisperModelInfo& getInfo() const noexcept { return info; }
+    ::whisper_context* getContext() const noexcept { return ctx; }
+
+    /** Approximate resident size, as accounted in the MemoryBudget. */
+    juce::int64 getFootprintBytes() const noexcept { return (juce::int64) info.memoryMB * 1024 * 1024; }
+
+    /** Record a use, for idle unloading. */
+    void markUsed() noexcept { lastUsedMs.store (juce::Time::getMillisecondCounter()); }
+    juce::uint32 getMillisecondsSinceLastUse() const noexcept { return juce::Time::getMillisecondCounter() - lastUsedMs.load(); }
+
+private:
+    WhisperModelInfo info;
+    ::whisper_context* ctx = nullptr;
+    std::atomic<juce::uint32> lastUsedMs { 0 };
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WhisperModel)
+};
+
+/**
+ * @brief Shared, lazily loading model cache.
+ *
+ * Use through juce::SharedResourcePointer<WhisperModelCache> so that all
+ * plugin instances in the host process see the same cache; the cache (and
+ * every model in it) is released when the last user goes away.
+ *
+ * Memory:
+ * - Models no engine holds are dropped by releaseIdleModels() once idle for
+ *   the given time, and immediately when the MemoryBudget asks for room.
+ * - Reloading a released model is a full load: whisper.cpp copies every
+ *   tensor out of the stream into its own buffers, so the model costs its
+ *   full size again. Reading through a memory mapping only saves the read
+ *   buffer, and the read itself is fast only while the file is still in the
+ *   OS page cache.
+ *
+ * Thread Safety:
+ * - acquire() may be called from any thread. Loads are serialised, so a
+ *   caller asking for a model that is already being loaded (e.g. by the
+ *   warm-up thread) waits for that load instead of starting a second one.
+ */
+class WhisperModelCache
+{
+public:
+    WhisperModelCache();
+    ~WhisperModelCache();
+
+    /**
+     * Get a loaded model, loading it from disk if needed. Blocking.
+     * @param info          Model to load (must be installed)
+     * @param shouldAbort   Optional, polled during the load; returning true aborts it
+     * @return The model, or nullptr if loading failed or was aborted
+     */
+    std::shared_ptr<WhisperModel> acquire (const WhisperModelInfo& info,
+                                           std::function<bool()> shouldAbort = nullptr);
+
+    /** Already loaded model, without loading. */
+    std::shared_ptr<WhisperModel> findLoaded (const juce::String& modelId) const;
+
+    /**
+     * Drop models that no engine holds and that were last used longer ago
+     * than idleTimeout. Returns the number of bytes released.
+     */
+    juce::int64 releaseIdleModels (juce::RelativeTime idleTimeout);
+
+    /** Drop every model no engine holds (memory pressure). Returns bytes released. */
+    juce::int64 releaseUnusedModels();
+
+    /** Load model files through a read-only memory mapping (default on). */
+    void setUseMemoryMappedLoading (bool shouldUseMapping) noexcept { useMemoryMapping.store (shouldUseMapping); }
+
+private:
+    std::shared_ptr<WhisperModel> loadFromFile (const WhisperModelInfo& info,
+                                                const std::function<bool()>& shouldAbort);
+
+    mutable std::mutex cacheMutex;
+    std::mutex loadMutex; // Serialises loads; never held together with cacheMutex while loading
+    std::map<juce::String, std::shared_ptr<WhisperModel>> models;
+
+    std::atomic<bool> useMemoryMapping { true };
+    juce::SharedResourcePointer<MemoryBudget> memoryBudget;
+    int reclaimerHandle = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WhisperModelCache)
+};
+
+} // namespace VoxScript
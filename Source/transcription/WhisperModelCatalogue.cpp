@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+    WhisperModelCatalogue.cpp
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "WhisperModelCatalogue.h"
+
+namespace VoxScript
+{
+
+namespace
+{
+    WhisperModelInfo makeModel (const char* id, const char* fileName, const char* displayName,
+                                WhisperModelInfo::Tier tier, const char* quantisation,
+                                int diskSizeMB, int memoryMB, float relativeSpeed, bool englishOnly)
+    {
+        WhisperModelInfo info;
+        info.id = id;
+        info.fileName = fileName;
+        info.displayName = displayName;
+        info.tier = tier;
+        info.quantisation = quantisation;
+        info.diskSizeMB = diskSizeMB;
+        info.memoryMB = memoryMB;
+        info.relativeSpeed = relativeSpeed;
+        info.englishOnly = englishOnly;
+        return info;
+    }
+}
+
+const juce::Array<WhisperModelInfo>& WhisperModelCatalogue::getAllModels()
+{
+    using Tier = WhisperModelInfo::Tier;
+
+    // Ordered fastest first; resolve() and findInstalledForTier() rely on this.
+    static const juce::Array<WhisperModelInfo> models
+    {
+        makeModel ("tiny.en",        "ggml-tiny.en.bin",        "Tiny (English)",             Tier::Draft,    "f16",  75,   125, 3.0f,  true),
+        makeModel ("base.en-q5_1",   "ggml-base.en-q5_1.bin",   "Base Q5_1 (English)",        Tier::Draft,    "q5_1", 57,   110, 1.6f,  true),
+        makeModel ("base.en-q8_0",   "ggml-base.en-q8_0.bin",   "Base Q8_0 (English)",        Tier::Standard, "q8_0", 78,   135, 1.3f,  true),
+        makeModel ("base.en",        "ggml-base.en.bin",        "Base (English)",             Tier::Standard, "f16",  142,  210, 1.0f,  true),
+        makeModel ("base",           "ggml-base.bin",           "Base (Multilingual)",        Tier::Standard, "f16",  142,  210, 1.0f,  false),
+        makeModel ("small.en-q5_1",  "ggml-small.en-q5_1.bin",  "Small Q5_1 (English)",       Tier::Accurate, "q5_1", 181,  330, 0.45f, true),
+        makeModel ("small.en",       "ggml-small.en.bin",       "Small (English)",            Tier::Accurate, "f16",  466,  610, 0.35f, true),
+        makeModel ("small",          "ggml-small.bin",          "Small (Multilingual)",       Tier::Accurate, "f16",  466,  610, 0.35f, false),
+        makeModel ("medium.en-q5_0", "ggml-medium.en-q5_0.bin", "Medium Q5_0 (English)",      Tier::Accurate, "q5_0", 514,  900, 0.16f, true),
+        makeModel ("medium",         "ggml-medium.bin",         "Medium (Multilingual)",      Tier::Accurate, "f16",  1500, 1900, 0.12f, false)
+    };
+
+    return models;
+}
+
+WhisperModelInfo WhisperModelCatalogue::findModel (const juce::String& modelId)
+{
+    for (const auto& model : getAllModels())
+        if (model.id == modelId)
+            return model;
+
+    return {};
+}
+
+juce::File WhisperModelCatalogue::getModelsDirectory()
+{
+    juce::File appData = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory);
+
+#if JUCE_MAC
+    appData = appData.getChildFile ("Application Support");
+#endif
+
+    return appData.getChildFile ("VoxScript").getChildFile ("models");
+}
+
+juce::File WhisperModelCatalogue::getModelFile (const WhisperModelInfo& info)
+{
+    return getModelsDirectory().getChildFile (info.fileName);
+}
+
+bool WhisperModelCatalogue::isInstalled (const WhisperModelInfo& info)
+{
+    return info.isValid() && getModelFile (info).existsAsFile();
+}
+
+juce::Array<WhisperModelInfo> WhisperModelCatalogue::getInstalledModels()
+{
+    juce::Array<WhisperModelInfo> installed;
+
+    for (const auto& model : getAllModels())
+        if (isInstalled (model))
+            installed.add (model);
+
+    return installed;
+}
+
+WhisperModelInfo WhisperModelCatalogue::resolve (const juce::String& requestedModelId)
+{
+    auto requested = findModel (requestedModelId);
+    if (isInstalled (requested))
+        return requested;
+
+    // A missing Accurate model is better replaced by another Accurate one
+    // than by the default; multilingual stays multilingual if it can
+    if (requested.isValid())
+    {
+        for (const auto& model : getAllModels())
+            if (model.tier == requested.tier && model.englishOnly == requested.englishOnly && isInstalled (model))
+                return model;
+
+        auto sameTier = findInstalledForTier (requested.tier);
+        if (sameTier.isValid())
+            return sameTier;
+    }
+
+    auto fallback = findModel (defaultModelId);
+    if (isInstalled (fallback))
+        return fallback;
+
+    auto installed = getInstalledModels();
+    return installed.isEmpty() ? WhisperModelInfo() : installed.getFirst();
+}
+
+WhisperModelInfo WhisperModelCatalogue::findInstalledForTier (WhisperModelInfo::Tier tier)
+{
+    for (const auto& model : getAllModels())
+        if (model.tier == tier && isInstalled (model))
+            return model;
+
+    return {};
+}
+
+} // namespace VoxScript
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+    WhisperModelCatalogue.h
+
+    Catalogue of the whisper.cpp models VoxScript knows how to use, with
+    footprint and speed metadata so callers can pick a model per document
+    or per job (quantized models for fast drafts, larger ones for accuracy).
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace VoxScript
+{
+
+/**
+ * @brief Static description of a single ggml whisper model file.
+ *
+ * Footprint numbers are approximate values for whisper.cpp on CPU and are
+ * only used for ranking and budgeting, never for correctness.
+ */
+struct WhisperModelInfo
+{
+    enum class Tier
+    {
+        Draft,      // Fastest, lowest accuracy (tiny / quantized base)
+        Standard,   // Default trade-off (base)
+        Accurate    // Slow, highest accuracy (small / medium)
+    };
+
+    juce::String id;            // Stable identifier, e.g. "base.en-q5_1"
+    juce::String fileName;      // File inside the models folder
+    juce::String displayName;
+    Tier tier = Tier::Standard;
+    juce::String quantisation;  // "f16", "q5_0", "q5_1", "q8_0"
+    int diskSizeMB = 0;
+    int memoryMB = 0;           // Approximate resident size once loaded
+    float relativeSpeed = 1.0f; // Throughput relative to base.en (higher is faster)
+    bool englishOnly = true;
+
+    bool isValid() const noexcept { return id.isNotEmpty(); }
+};
+
+/**
+ * @brief Lookup and discovery of whisper models on disk.
+ *
+ * Models live in <AppData>/VoxScript/models (on macOS under
+ * ~/Library/Application Support). The catalogue is a fixed list; a model is
+ * "installed" when its file exists in that folder.
+ *
+ * Thread Safety:
+ * - All methods are stateless and safe to call from any thread.
+ */
+class WhisperModelCatalogue
+{
+public:
+    /** Model used when no preference has been set (matches Phase II behaviour). */
+    static constexpr const char* defaultModelId = "base.en";
+
+    /** All models known to VoxScript, fastest first. */
+    static const juce::Array<WhisperModelInfo>& getAllModels();
+
+    /** Find a model by id. Returns an invalid info if unknown. */
+    static WhisperModelInfo findModel (const juce::String& modelId);
+
+    /** Folder searched for model files. */
+    static juce::File getModelsDirectory();
+
+    /** Full path of the model file (whether or not it exists). */
+    static juce::File getModelFile (const WhisperModelInfo& info);
+
+    /** True if the model file is present on disk. */
+    static bool isInstalled (const WhisperModelInfo& info);
+
+    /** Installed models, fastest first. */
+    static juce::Array<WhisperModelInfo> getInstalledModels();
+
+    /**
+     * Resolve a requested id to an installed model.
+     * Falls back to an installed model of the same tier (one that handles the
+     * same languages first), then to the default model, then to any
+     * installed model at all.
+     */
+    static WhisperModelInfo resolve (const juce::String& requestedModelId);
+
+    /** Fastest installed model of the given tier, or an invalid info. */
+    static WhisperModelInfo findInstalledForTier (WhisperModelInfo::Tier tier);
+
+private:
+    WhisperModelCatalogue() = delete;
+};
+
+} // namespace VoxScript
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+    WhisperModelWarmup.cpp
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "WhisperModelWarmup.h"
+#include <whisper.h>
+#include <vector>
+
+namespace VoxScript
+{
+
+WhisperModelWarmup::WhisperModelWarmup (const WhisperModelInfo& modelToWarm)
+    : juce::Thread ("WhisperModelWarmup"), info (modelToWarm)
+{
+}
+
+WhisperModelWarmup::~WhisperModelWarmup()
+{
+    // Loads and inference poll threadShouldExit(), so this returns promptly
+    signalThreadShouldExit();
+    stopThread (10000);
+}
+
+void WhisperModelWarmup::start()
+{
+    if (!info.isValid() || isThreadRunning())
+        return;
+
+    startThread (juce::Thread::Priority::background);
+}
+
+bool WhisperModelWarmup::isEnabledByEnvironment()
+{
+    const char* env = std::getenv ("VOXSCRIPT_PRELOAD_MODEL");
+    return env != nullptr && juce::String (env) == "1";
+}
+
+void WhisperModelWarmup::run()
+{
+    DBG ("WhisperModelWarmup: Preloading " + info.id);
+
+    auto loaded = modelCache->acquire (info, [this] { return threadShouldExit(); });
+
+    if (loaded == nullptr || threadShouldExit())
+    {
+        DBG ("WhisperModelWarmup: Cancelled or failed");
+        return;
+    }
+
+    prime (*loaded);
+
+    if (!threadShouldExit())
+    {
+        warm.store (true);
+        DBG ("WhisperModelWarmup: " + info.id + " is warm");
+    }
+}
+
+void WhisperModelWarmup::prime (WhisperModel& loadedModel)
+{
+    // A throwaway state: its compute buffers are freed again below, but the
+    // weights are now paged in and backend kernels are initialised.
+    auto* state = whisper_init_state (loadedModel.getContext());
+    if (state == nullptr)
+        return;
+
+    // One second of silence is enough to run the encoder and a decoder step
+    std::vector<float> silence (WHISPER_SAMPLE_RATE, 0.0f);
+
+    whisper_full_params params = whisper_full_default_params (WHISPER_SAMPLING_GREEDY);
+    params.print_realtime   = false;
+    params.print_progress   = false;
+    params.print_timestamps = false;
+    params.print_special    = false;
+    params.n_threads        = 1; // Stay out of the way of the host
+    params.no_context       = true;
+    params.single_segment   = true;
+    params.max_tokens       = 1;
+    params.language         = "en";
+    params.abort_callback   = [] (void* userData) { return static_cast<WhisperModelWarmup*> (userData)->threadShouldExit(); };
+    params.abort_callback_user_data = this;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    whisper_full_with_state (loadedModel.getContext(), state, params, silence.data(), static_cast<int> (silence.size()));
+
+    DBG ("WhisperModelWarmup: Primed in "
+         + juce::String (juce::Time::getMillisecondCounterHiRes() - startTime, 0) + " ms");
+
+    whisper_free_state (state);
+}
+
+} // namespace VoxScript
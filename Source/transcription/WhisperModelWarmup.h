@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+    WhisperModelWarmup.h
+
+    Optional background preload of the transcription model, so the first
+    job of a session does not pay for model load and cold caches.
+
+    Part of VoxScript Phase III: Model selection
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "WhisperModelCache.h"
+
+namespace VoxScript
+{
+
+/**
+ * @brief Low-priority thread that loads a model into the shared
+ * WhisperModelCache and primes it with one short inference.
+ *
+ * The warmed model stays in the cache like any other: the first real job
+ * picks it up, and it is subject to the usual idle unloading if none comes.
+ *
+ * Cancellation:
+ * - Destroying the object (e.g. plugin removed) aborts an in-flight load or
+ *   priming run and waits for the thread to finish.
+ *
+ * Opt-in: set VOXSCRIPT_PRELOAD_MODEL=1, or call
+ * VoxScriptDocumentController::warmUpTranscriptionModel().
+ */
+class WhisperModelWarmup : private juce::Thread
+{
+public:
+    explicit WhisperModelWarmup (const WhisperModelInfo& modelToWarm);
+    ~WhisperModelWarmup() override;
+
+    /** Start loading on a background-priority thread. */
+    void start();
+
+    /** True once the model is loaded and primed. */
+    bool isWarm() const noexcept { return warm.load(); }
+
+    const WhisperModelInfo& getModelInfo() const noexcept { return info; }
+
+    /** True if warm-up was requested through the environment. */
+    static bool isEnabledByEnvironment();
+
+private:
+    void run() override;
+
+    /** Run one short silent inference to allocate buffers and touch the weights. */
+    void prime (WhisperModel& loadedModel);
+
+    WhisperModelInfo info;
+    juce::SharedResourcePointer<WhisperModelCache> modelCache;
+    std::atomic<bool> warm { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WhisperModelWarmup)
+};
+
+} // namespace VoxScript
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+    WhisperSystemInfo.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "WhisperSystemInfo.h"
+#include <whisper.h>
+#include <atomic>
+
+namespace VoxScript
+{
+
+bool WhisperSystemInfo::isCpuSupported (juce::String& missingFeatures)
+{
+    juce::StringArray missing;
+
+    using Stats = juce::SystemStats;
+    const int level = VOXSCRIPT_WHISPER_CPU_LEVEL;
+
+    if (level >= 0 && !Stats::hasSSE3())      missing.add ("SSE3");
+    if (level >= 1 && !Stats::hasAVX())       missing.add ("AVX");
+    if (level >= 2 && !Stats::hasAVX2())      missing.add ("AVX2");
+    if (level >= 2 && !Stats::hasFMA3())      missing.add ("FMA");
+    if (level >= 3 && !Stats::hasAVX512F())   missing.add ("AVX-512F");
+    if (level >= 3 && !Stats::hasAVX512BW())  missing.add ("AVX-512BW");
+    if (level >= 3 && !Stats::hasAVX512VL())  missing.add ("AVX-512VL");
+
+    missingFeatures = missing.joinIntoString (", ");
+    return missing.isEmpty();
+}
+
+juce::String WhisperSystemInfo::getBackendDescription()
+{
+    static const char* levelNames[] = { "SSE3", "AVX", "AVX2", "AVX512" };
+    const int level = VOXSCRIPT_WHISPER_CPU_LEVEL;
+
+    juce::String description = "CPU level: ";
+    description << (level >= 0 && level < 4 ? levelNames[level] : "unchecked")
+                << ", threads: " << getRecommendedThreadCount()
+                << ", whisper: " << juce::String (whisper_print_system_info()).trim();
+    return description;
+}
+
+void WhisperSystemInfo::logBackendOnce()
+{
+    static std::atomic<bool> logged { false };
+
+    if (!logged.exchange (true))
+        juce::Logger::writeToLog ("VoxScript: whisper backend - " + getBackendDescription());
+}
+
+int WhisperSystemInfo::getRecommendedThreadCount()
+{
+    // More than 8 threads gives little for whisper's CPU kernels
+    return juce::jlimit (1, 8, juce::SystemStats::getNumPhysicalCpus());
+}
+
+} // namespace VoxScript
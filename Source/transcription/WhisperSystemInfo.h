@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    WhisperSystemInfo.h
+
+    CPU capability checks and thread tuning for the whisper.cpp CPU backend.
+    whisper.cpp is compiled for one SIMD level (VOXSCRIPT_WHISPER_CPU_LEVEL in
+    CMake/FetchWhisper.cmake); this verifies at runtime that the host CPU
+    supports it, so an unsupported machine gets an error message instead of
+    an illegal instruction crash inside the host.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#ifndef VOXSCRIPT_WHISPER_CPU_LEVEL
+ #define VOXSCRIPT_WHISPER_CPU_LEVEL -1 // Not checked (non-x86, native or unknown build)
+#endif
+
+namespace VoxScript
+{
+
+/**
+ * @brief Static helpers around the compiled whisper.cpp CPU backend.
+ *
+ * Thread Safety:
+ * - All methods are safe to call from any thread.
+ */
+class WhisperSystemInfo
+{
+public:
+    /**
+     * True if this CPU can run the compiled kernels.
+     * @param missingFeatures   Receives the missing instruction sets, if any
+     */
+    static bool isCpuSupported (juce::String& missingFeatures);
+
+    /** Compiled level name and whisper's own feature report. */
+    static juce::String getBackendDescription();
+
+    /** Log the backend description once per process. */
+    static void logBackendOnce();
+
+    /**
+     * Threads for one inference: physical cores, capped so a job doesn't
+     * starve the host's own threads.
+     */
+    static int getRecommendedThreadCount();
+
+private:
+    WhisperSystemInfo() = delete;
+};
+
+} // namespace VoxScript
@@ -0,0 +1,471 @@
+/*
+  ==============================================================================
+    WhisperWindowDecoder.cpp
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include "WhisperWindowDecoder.h"
+#include <whisper.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace VoxScript
+{
+
+namespace
+{
+    constexpr double secondsPerTimestamp = 0.02;
+    constexpr int maxInitialTimestamps = 50; // 1 s, whisper's max_initial_ts
+    constexpr float minusInf = -std::numeric_limits<float>::infinity();
+
+    struct DecodedToken
+    {
+        whisper_token id;
+        float probability;
+    };
+
+    using TokenList = std::vector<DecodedToken>;
+
+    /** Token ids the logit rules need. */
+    struct Vocabulary
+    {
+        int numVocab = 0;
+        whisper_token eot = 0;
+        whisper_token beg = 0;             // First timestamp token (0 s)
+        whisper_token firstTimestamp = 0;  // Decoding starts at this one or up to 1 s later
+        whisper_token lastTimestamp = 0;   // Later ones are suppressed
+    };
+
+    /** Prompt: [prev + prompt text] sot [language transcribe] */
+    std::vector<whisper_token> makePrompt (::whisper_context* ctx, const WindowDecodeOptions& options)
+    {
+        std::vector<whisper_token> prompt;
+
+        if (options.initialPrompt.isNotEmpty())
+        {
+            std::vector<whisper_token> promptTokens ((size_t) whisper_n_text_ctx (ctx));
+            int n = whisper_tokenize (ctx, options.initialPrompt.toRawUTF8(),
+                                      promptTokens.data(), (int) promptTokens.size());
+
+            // Too long for the buffer: whisper_tokenize returns minus the count needed
+            if (n < 0)
+            {
+                promptTokens.resize ((size_t) -n);
+                n = whisper_tokenize (ctx, options.initialPrompt.toRawUTF8(),
+                                      promptTokens.data(), (int) promptTokens.size());
+            }
+
+            if (n > 0)
+            {
+                // Same limit as whisper_full: at most half the text context
+                const int keep = juce::jmin (n, whisper_n_text_ctx (ctx) / 2 - 1);
+
+                prompt.push_back (whisper_token_prev (ctx));
+                prompt.insert (prompt.end(), promptTokens.begin() + (n - keep), promptTokens.begin() + n);
+            }
+        }
+
+        prompt.push_back (whisper_token_sot (ctx));
+
+        if (whisper_is_multilingual (ctx))
+        {
+            int langId = whisper_lang_id (options.language.toRawUTF8());
+            if (langId < 0)
+                langId = whisper_lang_id ("en");
+
+            prompt.push_back (whisper_token_lang (ctx, langId));
+            prompt.push_back (whisper_token_transcribe (ctx));
+        }
+
+        return prompt;
+    }
+
+    /** Logits of the last of the rows just decoded. */
+    void copyLogits (::whisper_state* state, int numRows, std::vector<float>& logits)
+    {
+        const float* raw = whisper_get_logits_from_state (state) + (size_t) (numRows - 1) * logits.size();
+        std::copy (raw, raw + logits.size(), logits.begin());
+    }
+
+    /** In place; suppressed (-inf) entries stay suppressed. */
+    void logSoftmax (std::vector<float>& values)
+    {
+        const float maxValue = *std::max_element (values.begin(), values.end());
+        if (!std::isfinite (maxValue))
+            return;
+
+        double sum = 0.0;
+        for (const auto v : values)
+            if (std::isfinite (v))
+                sum += std::exp (v - maxValue);
+
+        const float logSum = maxValue + static_cast<float> (std::log (sum));
+        for (auto& v : values)
+            v -= logSum;
+    }
+
+    /**
+     * whisper's logit rules (as in whisper_process_logits), then log-softmax,
+     * in place. All entries -inf means no token is allowed.
+     */
+    void toLogProbs (std::vector<float>& logits, const TokenList& generated, const Vocabulary& vocab)
+    {
+        const auto eot = vocab.eot;
+        const auto beg = vocab.beg;
+
+        // Only text, end-of-text and timestamp tokens; no special tokens
+        std::fill (logits.begin() + eot + 1, logits.begin() + beg, minusInf);
+        std::fill (logits.begin() + vocab.lastTimestamp + 1, logits.end(), minusInf);
+
+        if (generated.empty())
+        {
+            // Start with a timestamp near the start of the range to decode
+            const auto latestFirst = juce::jmin (vocab.lastTimestamp, vocab.firstTimestamp + maxInitialTimestamps);
+            std::fill (logits.begin(), logits.begin() + vocab.firstTimestamp, minusInf);
+            std::fill (logits.begin() + latestFirst + 1, logits.end(), minusInf);
+        }
+        else
+        {
+            const bool lastWasTimestamp = generated.back().id >= beg;
+            const bool penultimateWasTimestamp = generated.size() < 2 || generated[generated.size() - 2].id >= beg;
+
+            if (lastWasTimestamp)
+            {
+                if (penultimateWasTimestamp)
+                    std::fill (logits.begin() + beg, logits.end(), minusInf);      // Pair closed: text next
+                else
+                    std::fill (logits.begin(), logits.begin() + eot, minusInf);    // Close the pair
+            }
+
+            // Never go backwards
+            auto lastTimestamp = std::find_if (generated.rbegin(), generated.rend(),
+                                               [beg] (const DecodedToken& t) { return t.id >= beg; });
+
+            if (lastTimestamp != generated.rend())
+                std::fill (logits.begin() + beg, logits.begin() + juce::jmin (lastTimestamp->id, vocab.numVocab), minusInf);
+        }
+
+        logSoftmax (logits);
+
+        // If timestamps together are more likely than any single text token, pick one
+        double timestampMass = 0.0;
+        for (auto it = logits.begin() + beg; it != logits.end(); ++it)
+            if (std::isfinite (*it))
+                timestampMass += std::exp (*it);
+
+        const float maxTextLogProb = *std::max_element (logits.begin(), logits.begin() + beg);
+
+        if (timestampMass > 0.0 && std::log (timestampMass) > maxTextLogProb)
+        {
+            std::fill (logits.begin(), logits.begin() + beg, minusInf);
+            logSoftmax (logits);
+        }
+    }
+
+    whisper_token argMax (const std::vector<float>& values)
+    {
+        return (whisper_token) std::distance (values.begin(), std::max_element (values.begin(), values.end()));
+    }
+
+    /** One hypothesis, extended token by token over the KV cache. Greedy or sampling. */
+    std::optional<TokenList> decodeSingle (::whisper_context* ctx, ::whisper_state* state,
+                                           const WindowDecodeOptions& options, const std::vector<whisper_token>& prompt,
+                                           const Vocabulary& vocab, std::vector<float>& logits,
+                                           const std::atomic<bool>& shouldCancel)
+    {
+        if (whisper_decode_with_state (ctx, state, prompt.data(), (int) prompt.size(), 0, options.numThreads) != 0)
+        {
+            DBG ("WhisperWindowDecoder: Prompt decode failed");
+            return std::nullopt;
+        }
+
+        const int numTextCtx = whisper_n_text_ctx (ctx);
+        int numPast = (int) prompt.size();
+        int numRows = numPast;
+
+        TokenList generated;
+        std::mt19937 rng (options.seed);
+
+        for (int step = 0; step < options.maxTokens && numPast < numTextCtx; ++step)
+        {
+            if (shouldCancel.load())
+                return std::nullopt;
+
+            copyLogits (state, numRows, logits);
+            toLogProbs (logits, generated, vocab);
+
+            whisper_token token = argMax (logits);
+
+            if (options.temperature > 0.0f && std::isfinite (logits[(size_t) token]))
+            {
+                // p^(1/T), drawn from the cumulative sum; no per-step allocation
+                double total = 0.0;
+                for (const auto lp : logits)
+                    total += std::isfinite (lp) ? std::exp (lp / options.temperature) : 0.0;
+
+                double remaining = std::uniform_real_distribution<double> (0.0, total) (rng);
+
+                for (size_t t = 0; t < logits.size(); ++t)
+                {
+                    if (!std::isfinite (logits[t]))
+                        continue;
+
+                    token = (whisper_token) t;
+                    remaining -= std::exp (logits[t] / options.temperature);
+
+                    if (remaining <= 0.0)
+                        break;
+                }
+            }
+
+            if (!std::isfinite (logits[(size_t) token]) || token == vocab.eot)
+                break;
+
+            generated.push_back ({ token, std::exp (logits[(size_t) token]) });
+
+            if (whisper_decode_with_state (ctx, state, &token, 1, numPast, options.numThreads) != 0)
+            {
+                DBG ("WhisperWindowDecoder: Decode failed");
+                return std::nullopt;
+            }
+
+            ++numPast;
+            numRows = 1;
+        }
+
+        return generated;
+    }
+
+    /**
+     * Beam search: the beamSize most likely hypotheses are extended each step
+     * until beamSize of them have ended; the best by mean log-probability wins.
+     */
+    std::optional<TokenList> decodeBeams (::whisper_context* ctx, ::whisper_state* state,
+                                          const WindowDecodeOptions& options, const std::vector<whisper_token>& prompt,
+                                          const Vocabulary& vocab, std::vector<float>& logits,
+                                          const std::atomic<bool>& shouldCancel)
+    {
+        struct Hypothesis
+        {
+            TokenList tokens;
+            double sumLogProb = 0.0;
+        };
+
+        struct Candidate
+        {
+            size_t parent;
+            whisper_token token;
+            float logProb;
+            double sumLogProb;
+        };
+
+        const auto beamSize = (size_t) options.beamSize;
+        const int numTextCtx = whisper_n_text_ctx (ctx);
+
+        std::vector<Hypothesis> beams (1), nextBeams, finished;
+        std::vector<Candidate> candidates;
+        std::vector<whisper_token> input;
+
+        for (int step = 0; step < options.maxTokens && !beams.empty() && finished.size() < beamSize; ++step)
+        {
+            candidates.clear();
+
+            for (size_t b = 0; b < beams.size(); ++b)
+            {
+                if (shouldCancel.load())
+                    return std::nullopt;
+
+                input.assign (prompt.begin(), prompt.end());
+                for (const auto& token : beams[b].tokens)
+                    input.push_back (token.id);
+
+                // Out of text context: ends here
+                if ((int) input.size() >= numTextCtx)
+                {
+                    candidates.push_back ({ b, vocab.eot, 0.0f, beams[b].sumLogProb });
+                    continue;
+                }
+
+                // No KV cache per hypothesis, so the whole prefix each time
+                if (whisper_decode_with_state (ctx, state, input.data(), (int) input.size(), 0, options.numThreads) != 0)
+                {
+                    DBG ("WhisperWindowDecoder: Beam decode failed");
+                    return std::nullopt;
+                }
+
+                copyLogits (state, (int) input.size(), logits);
+                toLogProbs (logits, beams[b].tokens, vocab);
+
+                // This hypothesis' best continuations (the scratch logits are consumed)
+                for (size_t k = 0; k < beamSize; ++k)
+                {
+                    const auto token = argMax (logits);
+                    const float logProb = logits[(size_t) token];
+
+                    if (!std::isfinite (logProb))
+                        break;
+
+                    candidates.push_back ({ b, token, logProb, beams[b].sumLogProb + logProb });
+                    logits[(size_t) token] = minusInf;
+                }
+            }
+
+            std::sort (candidates.begin(), candidates.end(),
+                       [] (const Candidate& a, const Candidate& b) { return a.sumLogProb > b.sumLogProb; });
+
+            nextBeams.clear();
+
+            for (const auto& candidate : candidates)
+            {
+                const auto& parent = beams[candidate.parent];
+
+                if (candidate.token == vocab.eot)
+                {
+                    if (finished.size() < beamSize)
+                        finished.push_back ({ parent.tokens, candidate.sumLogProb });
+                }
+                else if (nextBeams.size() < beamSize)
+                {
+                    nextBeams.push_back (parent);
+                    nextBeams.back().tokens.push_back ({ candidate.token, std::exp (candidate.logProb) });
+                    nextBeams.back().sumLogProb = candidate.sumLogProb;
+                }
+            }
+
+            beams.swap (nextBeams);
+        }
+
+        // Hypotheses cut off by maxTokens count as well
+        if (finished.empty())
+            finished = std::move (beams);
+
+        if (finished.empty())
+            return TokenList();
+
+        auto meanLogProb = [] (const Hypothesis& h) { return h.sumLogProb / (double) juce::jmax ((size_t) 1, h.tokens.size()); };
+
+        return std::max_element (finished.begin(), finished.end(),
+                                 [&] (const Hypothesis& a, const Hypothesis& b) { return meanLogProb (a) < meanLogProb (b); })->tokens;
+    }
+}
+
+VoxSequence WhisperWindowDecoder::decode (::whisper_context* ctx, ::whisper_state* state,
+                                          const WindowDecodeOptions& options,
+                                          double windowStartSeconds, double windowLengthSeconds,
+                                          const std::atomic<bool>& shouldCancel)
+{
+    if (ctx == nullptr || state == nullptr)
+        return {};
+
+    // The part of the window to decode
+    const double endSeconds = options.toSeconds > options.fromSeconds ? juce::jmin (options.toSeconds, windowLengthSeconds)
+                                                                      : windowLengthSeconds;
+    const double fromSeconds = juce::jlimit (0.0, endSeconds, options.fromSeconds);
+
+    Vocabulary vocab;
+    vocab.numVocab = whisper_n_vocab (ctx);
+    vocab.eot = whisper_token_eot (ctx);
+    vocab.beg = whisper_token_beg (ctx);
+    vocab.lastTimestamp = juce::jmin (vocab.numVocab - 1, vocab.beg + juce::jmax (0, (int) std::ceil (endSeconds / secondsPerTimestamp)));
+    vocab.firstTimestamp = juce::jmin (vocab.lastTimestamp, vocab.beg + (int) std::round (fromSeconds / secondsPerTimestamp));
+
+    const auto prompt = makePrompt (ctx, options);
+    std::vector<float> logits ((size_t) vocab.numVocab); // Scratch for every step
+
+    // The state's batch and KV cache hold at most the text context
+    if ((int) prompt.size() >= whisper_n_text_ctx (ctx) || vocab.beg >= vocab.numVocab)
+    {
+        DBG ("WhisperWindowDecoder: Prompt doesn't fit the text context");
+        return {};
+    }
+
+    const auto generated = options.beamSize > 1 ? decodeBeams (ctx, state, options, prompt, vocab, logits, shouldCancel)
+                                                : decodeSingle (ctx, state, options, prompt, vocab, logits, shouldCancel);
+
+    if (!generated.has_value())
+        return {};
+
+    // Group into segments at timestamp pairs; interpolate word times inside each
+    VoxSequence sequence;
+    TokenList textTokens;
+    double segmentStart = fromSeconds;
+
+    auto flushSegment = [&] (double segmentEnd)
+    {
+        if (textTokens.empty())
+            return;
+
+        VoxSegment segment;
+        segment.startTime = windowStartSeconds + segmentStart;
+        segment.endTime = windowStartSeconds + juce::jmax (segmentStart, segmentEnd);
+
+        const double secondsPerToken = (segment.endTime - segment.startTime) / (double) textTokens.size();
+        int wordTokens = 0;
+
+        for (size_t i = 0; i < textTokens.size(); ++i)
+        {
+            const auto text = juce::String::fromUTF8 (whisper_token_to_str (ctx, textTokens[i].id));
+            const double t0 = segment.startTime + secondsPerToken * (double) i;
+            segment.text += text;
+
+            if (segment.words.isEmpty() || text.startsWithChar (' '))
+            {
+                if (!segment.words.isEmpty())
+                    segment.words.getReference (segment.words.size() - 1).confidence /= (float) wordTokens;
+
+                VoxWord word;
+                word.text = text;
+                word.startTime = t0;
+                word.endTime = t0 + secondsPerToken;
+                word.confidence = textTokens[i].probability;
+                segment.words.add (word);
+                wordTokens = 1;
+            }
+            else
+            {
+                auto& word = segment.words.getReference (segment.words.size() - 1);
+                word.text += text;
+                word.endTime = t0 + secondsPerToken;
+                word.confidence += textTokens[i].probability;
+                ++wordTokens;
+            }
+        }
+
+        if (!segment.words.isEmpty())
+            segment.words.getReference (segment.words.size() - 1).confidence /= (float) wordTokens;
+
+        sequence.addSegment (segment);
+        textTokens.clear();
+    };
+
+    for (const auto& token : *generated)
+    {
+        if (token.id >= vocab.beg)
+        {
+            const double time = (double) (token.id - vocab.beg) * secondsPerTimestamp;
+
+            if (textTokens.empty())
+                segmentStart = time;
+            else
+                flushSegment (time);
+        }
+        else
+        {
+            textTokens.push_back (token);
+        }
+    }
+
+    flushSegment (endSeconds);
+
+    return sequence;
+}
+
+} // namespace VoxScript
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+    WhisperWindowDecoder.h
+
+    Decode-only transcription of an already encoded whisper window.
+    Runs whisper's text decoder token by token against the encoder output
+    held in a whisper_state, so a window can be re-decoded with a different
+    language, prompt, temperature or beam width, or for just a part of it,
+    without running the encoder again.
+
+    Part of VoxScript Phase III: Transcription Engine
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "VoxSequence.h"
+#include "WhisperSystemInfo.h"
+#include <atomic>
+
+// Forward declare whisper types from whisper.h (global namespace)
+struct whisper_context;
+struct whisper_state;
+
+namespace VoxScript
+{
+
+/**
+ * @brief Settings for a decode-only pass.
+ */
+struct WindowDecodeOptions
+{
+    juce::String language { "en" };  // Ignored by English-only models
+    juce::String initialPrompt;      // Conditioning text, as whisper's initial_prompt
+    float temperature = 0.0f;        // 0 = greedy, otherwise sampling (beamSize 1 only)
+    int beamSize = 1;                // Above 1: beam search with this many hypotheses
+    double fromSeconds = 0.0;        // Within the window: decoding starts here (or up to 1 s later)
+    double toSeconds = 0.0;          // Within the window: no timestamps after it (0 = window end)
+    int maxTokens = 224;             // Per window
+    juce::uint32 seed = 0;           // For temperature sampling
+    int numThreads = WhisperSystemInfo::getRecommendedThreadCount();
+};
+
+/**
+ * @brief Greedy / temperature / beam decoder over whisper_decode_with_state().
+ *
+ * Follows whisper's timestamp rules (timestamps first, in pairs, never going
+ * backwards), so results are segmented like whisper_full's. Limiting the
+ * first and last timestamp restricts decoding to part of the window, e.g.
+ * one segment. Word timings are interpolated inside each
+ * segment, since token-level timestamps need the full pipeline.
+ *
+ * Beam search is this decoder's own, not whisper_full's. whisper's API
+ * can't fork the decoder's KV cache, so every hypothesis decodes its whole
+ * prefix again each step; meant for short ranges, not whole windows.
+ *
+ * Thread Safety:
+ * - Uses (and overwrites the decoder cache of) the given state; the caller
+ *   must not use that state from another thread at the same time.
+ */
+class WhisperWindowDecoder
+{
+public:
+    /**
+     * Decode the window currently encoded in state.
+     * @param windowStartSeconds    Added to every time in the result
+     * @param windowLengthSeconds   Audio length in the window; later timestamps are suppressed
+     * @param shouldCancel          Polled between tokens
+     * @return The transcription (empty on failure or cancel)
+     */
+    static VoxSequence decode (::whisper_context* ctx, ::whisper_state* state,
+                               const WindowDecodeOptions& options,
+                               double windowStartSeconds, double windowLengthSeconds,
+                               const std::atomic<bool>& shouldCancel);
+
+private:
+    WhisperWindowDecoder() = delete;
+};
+
+} // namespace VoxScript
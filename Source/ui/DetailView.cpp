@@ -49,6 +49,12 @@ void DetailView::paint (juce::Graphics& g)
     
     g.setColour (juce::Colour (0xff1a1a1a));
     g.fillRect (bounds);
+
+    if (spectrogram != nullptr)
+    {
+        paintSpectrogram (g, bounds);
+        return;
+    }
     
     // Draw center line
     g.setColour (juce::Colour (0xff3a3a3a));
@@ -108,17 +114,120 @@ void DetailView::setAudioData (const juce::AudioBuffer<float>& buffer)
     repaint();
 }
 
+void DetailView::setSpectrogram (std::shared_ptr<const MelSpectrogram> newSpectrogram)
+{
+    if (newSpectrogram == spectrogram)
+        return;
+
+    spectrogram = std::move (newSpectrogram);
+    speechRegions.clear();
+
+    if (spectrogram != nullptr)
+    {
+        speechRegions = spectrogram->findSpeechRegions();
+        displayStartTime = 0.0;
+        displayEndTime = spectrogram->getDurationSeconds();
+    }
+
+    infoLabel.setVisible (spectrogram == nullptr);
+    renderSpectrogramImage();
+    repaint();
+}
+
 void DetailView::setTimeRange (double startTime, double endTime)
 {
     displayStartTime = startTime;
     displayEndTime = endTime;
     
+    renderSpectrogramImage();
     repaint();
 }
 
 void DetailView::clear()
 {
-    repaint();
+    setSpectrogram (nullptr);
+}
+
+//==============================================================================
+// Spectrogram layer
+
+void DetailView::renderSpectrogramImage()
+{
+    spectrogramImage = {};
+
+    if (spectrogram == nullptr || displayEndTime <= displayStartTime)
+        return;
+
+    // One column per ~pixel; sampled, so long sources stay cheap to render
+    constexpr int maxColumns = 2048;
+    const int firstFrame = static_cast<int> (displayStartTime / MelSpectrogram::secondsPerFrame);
+    const int lastFrame = juce::jmin (spectrogram->getNumFrames(),
+                                      static_cast<int> (displayEndTime / MelSpectrogram::secondsPerFrame) + 1);
+    const int numColumns = juce::jlimit (1, maxColumns, lastFrame - firstFrame);
+
+    if (lastFrame <= firstFrame)
+        return;
+
+    // Same 80 dB window whisper sees
+    const float top = spectrogram->getMaxLogValue();
+    const float bottom = top - 8.0f;
+
+    const auto quiet = juce::Colour (0xff1a1a1a);
+    const auto loud = juce::Colour (0xff4a9eff);
+    const auto hot = juce::Colours::white;
+
+    juce::Image image (juce::Image::RGB, numColumns, MelSpectrogram::numBands, false);
+    const double framesPerColumn = static_cast<double> (lastFrame - firstFrame) / numColumns;
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        const int frameStart = firstFrame + static_cast<int> (column * framesPerColumn);
+        const int frameEnd = juce::jmax (frameStart + 1, firstFrame + static_cast<int> ((column + 1) * framesPerColumn));
+        const int step = juce::jmax (1, (frameEnd - frameStart) / 4);
+
+        for (int band = 0; band < MelSpectrogram::numBands; ++band)
+        {
+            float value = MelSpectrogram::silenceLogValue;
+            for (int frame = frameStart; frame < frameEnd; frame += step)
+                value = juce::jmax (value, spectrogram->getLogValue (band, frame));
+
+            const float level = juce::jlimit (0.0f, 1.0f, (value - bottom) / (top - bottom));
+            const auto colour = level < 0.7f ? quiet.interpolatedWith (loud, level / 0.7f)
+                                             : loud.interpolatedWith (hot, (level - 0.7f) / 0.3f);
+
+            image.setPixelAt (column, MelSpectrogram::numBands - 1 - band, colour); // Low bands at the bottom
+        }
+    }
+
+    spectrogramImage = image;
+}
+
+void DetailView::paintSpectrogram (juce::Graphics& g, juce::Rectangle<int> bounds)
+{
+    if (spectrogramImage.isValid())
+    {
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImage (spectrogramImage, bounds.toFloat());
+    }
+
+    const double range = displayEndTime - displayStartTime;
+    if (range <= 0.0)
+        return;
+
+    // Speech regions found by the VAD, as a strip along the bottom
+    auto strip = bounds.removeFromBottom (4);
+    g.setColour (juce::Colours::lightgreen.withAlpha (0.8f));
+
+    for (const auto& region : speechRegions)
+    {
+        const auto visible = region.getIntersectionWith ({ displayStartTime, displayEndTime });
+        if (visible.isEmpty())
+            continue;
+
+        const auto x1 = strip.getX() + static_cast<float> ((visible.getStart() - displayStartTime) / range) * strip.getWidth();
+        const auto x2 = strip.getX() + static_cast<float> ((visible.getEnd() - displayStartTime) / range) * strip.getWidth();
+        g.fillRect (juce::Rectangle<float> (x1, (float) strip.getY(), juce::jmax (1.0f, x2 - x1), (float) strip.getHeight()));
+    }
 }
 
 } // namespace VoxScript
@@ -13,6 +13,8 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include "../transcription/MelSpectrogram.h"
+#include <memory>
 
 namespace VoxScript
 {
@@ -54,6 +56,14 @@ public:
      */
     void setAudioData (const juce::AudioBuffer<float>& buffer);
     
+    /**
+     * Show a source's log-mel spectrogram (the one the VAD and the
+     * language probe use, see MelSpectrogramService) with its detected
+     * speech regions.
+     * Pass nullptr to go back to the placeholder.
+     */
+    void setSpectrogram (std::shared_ptr<const MelSpectrogram> newSpectrogram);
+
     /**
      * Set the time range to display (in seconds)
      */
@@ -80,6 +90,14 @@ private:
     
     double displayStartTime { 0.0 };
     double displayEndTime { 1.0 };
+
+    // Spectrogram layer: rendered once per time range, not per paint
+    std::shared_ptr<const MelSpectrogram> spectrogram;
+    juce::Array<juce::Range<double>> speechRegions;
+    juce::Image spectrogramImage;
+
+    void renderSpectrogramImage();
+    void paintSpectrogram (juce::Graphics& g, juce::Rectangle<int> bounds);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DetailView)
 };
@@ -50,7 +50,7 @@ void ScriptView::paint (juce::Graphics& g)
     g.drawText (statusText, 10, 10, getWidth() - 20, 20, juce::Justification::left);
     
     // Draw placeholder if no transcription
-    if (currentSequence.getSegments().isEmpty())
+    if (currentSequence.getNumSegments() == 0)
     {
         g.setColour (juce::Colours::lightgrey);
         g.setFont (juce::FontOptions (14.0f));
@@ -78,11 +78,20 @@ void ScriptView::setTranscription (const VoxSequence& sequence)
     currentSequence = sequence;
     transcriptionDisplay.setSequence(sequence);
     
-    DBG ("ScriptView: Received transcription with " + juce::String(sequence.getSegments().size()) + " segments");
+    DBG ("ScriptView: Received transcription with " + juce::String(sequence.getNumSegments()) + " segments");
     
     repaint();
 }
 
+void ScriptView::appendSegments (const juce::Array<VoxSegment>& segments)
+{
+    for (const auto& segment : segments)
+        currentSequence.addSegment(segment);
+
+    transcriptionDisplay.appendSegments(segments);
+    repaint();
+}
+
 void ScriptView::setStatus (const juce::String& status)
 {
     statusText = status;
@@ -118,36 +127,45 @@ void ScriptView::timerCallback()
     }
     
     // 2. Poll Store for Data
-    // We take a thread-safe snapshot
-    auto snapshot = documentController->getStore().makeSnapshot();
-    
-    // For this phase, we display the first available transcription found in the snapshot.
+    // The store revision changes on every update, including in-place refinements
+    auto& store = documentController->getStore();
+    const auto revision = store.getRevision();
+    if (revision == lastStoreRevision)
+        return;
+
+    lastStoreRevision = revision;
+
+    // For this phase, we display the first available transcription.
     // In future phases, we will track the 'selected' AudioSourceID.
-    if (!snapshot.transcriptions.empty())
+    const auto sourceIDs = store.getTranscribedSourceIDs();
+    if (sourceIDs.empty())
+        return;
+
+    if (sourceIDs.front() != displayedSourceID)
+    {
+        displayedSourceID = sourceIDs.front();
+        displayedGeneration = 0;
+    }
+
+    // Only the segments we don't have yet: a streamed transcription grows
+    // without copying what is already shown
+    TranscriptDelta delta;
+    if (!store.getTranscriptDelta(displayedSourceID, displayedGeneration, currentSequence.getNumSegments(), delta))
+        return;
+
+    displayedGeneration = delta.generation;
+
+    if (delta.firstIndex == 0)
+    {
+        VoxSequence sequence;
+        for (const auto& segment : delta.segments)
+            sequence.addSegment(segment);
+
+        setTranscription(sequence);
+    }
+    else if (!delta.segments.isEmpty())
     {
-        const auto& seq = snapshot.transcriptions.begin()->second;
-        
-        // Simple dirtiness check: segment count or just forced refresh if ready
-        if (seq.getSegments().size() != currentSequence.getSegments().size() || newStatus == "Ready")
-        {
-            // Only update if it looks different to avoid repaint spam, unless it's "Ready" (completed)
-             // A better dirtiness check would be version/timestamp, but segment count is a proxy for now.
-             // If equal count but content changed? We might miss it.
-             // Let's assume for now updates always grow or we only care when done.
-             // Actually, transcriptionComplete updates the store.
-             // Let's just update if counts differ OR if we are in a transient state.
-             // But to be safe for Mission 1 verification:
-             // If we have content in store and local is empty -> update.
-             if (currentSequence.getSegments().isEmpty() && !seq.getSegments().isEmpty())
-             {
-                 setTranscription(seq);
-             }
-             // If lengths differ -> update
-             else if (seq.getSegments().size() != currentSequence.getSegments().size())
-             {
-                 setTranscription(seq);
-             }
-        }
+        appendSegments(delta.segments);
     }
 }
 
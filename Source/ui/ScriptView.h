@@ -59,6 +59,12 @@ public:
      * Set the transcription data to display
      */
     void setTranscription (const VoxSequence& sequence);
+
+    /**
+     * Add segments after the ones shown (streamed transcription).
+     * Only the new segments are copied and measured.
+     */
+    void appendSegments (const juce::Array<VoxSegment>& segments);
     
     /**
      * Set status message (e.g., "Transcribing...", "Ready")
@@ -84,6 +90,11 @@ private:
     // Phase II: Display members
     juce::String statusText;
     VoxSequence currentSequence;
+    uint64_t lastStoreRevision = 0;
+
+    // What we show, to fetch only what is new (see VoxScriptDocumentStore::getTranscriptDelta())
+    uint64_t displayedSourceID = 0;
+    uint64_t displayedGeneration = 0;
     
     // Phase III: Document controller for status polling
     VoxScriptDocumentController* documentController = nullptr;
@@ -101,22 +112,38 @@ private:
             updateSize();
             repaint();
         }
+
+        void appendSegments(const juce::Array<VoxSegment>& segments)
+        {
+            for (const auto& segment : segments)
+                sequence.addSegment(segment);
+
+            // Grow by the new segments only; resized() re-measures only for a new width
+            for (const auto& segment : segments)
+                contentHeight += estimateHeight(segment.text);
+
+            setSize(getWidth(), contentHeight);
+            repaint();
+        }
         
         void paint(juce::Graphics& g) override
         {
             g.fillAll(juce::Colours::white);
             
-            if (sequence.getSegments().isEmpty())
+            const int numSegments = sequence.getNumSegments();
+            if (numSegments == 0)
                 return;
             
             int yPos = 10;
             g.setFont(juce::FontOptions(13.0f));
             
-            for (const auto& segment : sequence.getSegments())
+            // Straight from the columns: no VoxSegment (and its words) built per row
+            for (int i = 0; i < numSegments; ++i)
             {
                 // Format timestamp [MM:SS.mmm]
-                int minutes = (int)(segment.startTime / 60.0);
-                double seconds = segment.startTime - (minutes * 60.0);
+                const double startTime = sequence.getSegmentStart(i);
+                int minutes = (int)(startTime / 60.0);
+                double seconds = startTime - (minutes * 60.0);
                 juce::String timestamp = juce::String::formatted("[%02d:%06.3f] ", minutes, seconds);
                 
                 // Draw timestamp in grey
@@ -129,7 +156,7 @@ private:
                 
                 // Calculate how many lines this text needs
                 juce::AttributedString attrStr;
-                attrStr.append(segment.text, juce::FontOptions(13.0f));
+                attrStr.append(sequence.getSegmentText(i), juce::FontOptions(13.0f));
                 
                 juce::TextLayout layout;
                 layout.createLayout(attrStr, (float)(getWidth() - 145));
@@ -144,28 +171,36 @@ private:
         void updateSize()
         {
             // Calculate required height for all segments
-            int totalHeight = 10;
+            measuredWidth = getWidth();
+            contentHeight = 10;
             
-            for (const auto& segment : sequence.getSegments())
-            {
-                // Estimate lines needed (rough calculation)
-                int charsPerLine = (getWidth() - 145) / 7; // Approximate
-                if (charsPerLine < 20) charsPerLine = 20;
-                
-                int lines = juce::jmax(1, (int)std::ceil((float)segment.text.length() / (float)charsPerLine));
-                totalHeight += lines * 18 + 15; // 18px per line + 15px spacing
-            }
+            for (int i = 0; i < sequence.getNumSegments(); ++i)
+                contentHeight += estimateHeight(sequence.getSegmentText(i));
             
-            setSize(getWidth(), totalHeight);
+            setSize(getWidth(), contentHeight);
+        }
+
+        int estimateHeight(const juce::String& text) const
+        {
+            // Estimate lines needed (rough calculation)
+            int charsPerLine = (getWidth() - 145) / 7; // Approximate
+            if (charsPerLine < 20) charsPerLine = 20;
+            
+            int lines = juce::jmax(1, (int)std::ceil((float)text.length() / (float)charsPerLine));
+            return lines * 18 + 15; // 18px per line + 15px spacing
         }
         
         void resized() override
         {
-            updateSize();
+            // Our own setSize() from updateSize() and appendSegments() only changes the height
+            if (getWidth() != measuredWidth)
+                updateSize();
         }
         
     private:
         VoxSequence sequence;
+        int contentHeight = 10; // Estimated height of sequence, kept up to date as segments arrive
+        int measuredWidth = -1; // Width contentHeight was estimated for
     };
     
     TranscriptionDisplay transcriptionDisplay;
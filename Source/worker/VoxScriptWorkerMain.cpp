@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+    VoxScriptWorkerMain.cpp
+
+    The out-of-process transcription worker (VoxScriptWorker).
+    Launched by TranscriptionWorkerPool; receives audio through a
+    SharedAudioRing and jobs over the coordinator pipe, runs them on its own
+    WhisperEngine one at a time, and quits when the plugin goes away.
+
+    Part of VoxScript Mission 3: Isolate Whisper
+
+    Copyright (c) 2025 MelechDSP - All rights reserved.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../engine/SharedAudioRing.h"
+#include "../engine/TranscriptionWorkerProtocol.h"
+#include "../transcription/WhisperEngine.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace VoxScript
+{
+
+using namespace TranscriptionWorkerProtocol;
+
+/**
+ * @brief Worker side of the protocol.
+ *
+ * Pipe callbacks arrive on the connection thread; they only collect audio
+ * and queue jobs. Inference runs on this object's thread, so a cancel
+ * message can still be handled while a job runs.
+ */
+class TranscriptionWorkerService : public juce::ChildProcessWorker,
+                                   private juce::Thread
+{
+public:
+    TranscriptionWorkerService() : juce::Thread ("VoxScriptWorker") {}
+
+    ~TranscriptionWorkerService() override
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            signalThreadShouldExit();
+        }
+
+        engine.cancelTranscription();
+        cv.notify_all();
+        stopThread (4000);
+    }
+
+    void handleMessageFromCoordinator (const juce::MemoryBlock& data) override
+    {
+        Message message;
+        if (!decode (data, message))
+            return;
+
+        switch (message.type)
+        {
+            case MessageType::Hello:        handleHello (message); break;
+            case MessageType::BeginJob:     handleBeginJob (message); break;
+            case MessageType::AudioChunk:   handleAudioChunk (message); break;
+            case MessageType::CancelJob:    handleCancelJob (message); break;
+            default:                        break;
+        }
+    }
+
+    void handleConnectionLost() override
+    {
+        // The plugin (or the host) is gone; nobody wants our results
+        engine.cancelTranscription();
+        juce::JUCEApplicationBase::quit();
+    }
+
+private:
+    struct Job
+    {
+        Message request;
+        std::vector<float> samples;
+    };
+
+    void handleHello (const Message& message)
+    {
+        ring = SharedAudioRing::open (juce::File (message.ringPath));
+
+        if (ring == nullptr || message.protocolVersion != TranscriptionWorkerProtocol::version)
+        {
+            juce::JUCEApplicationBase::quit();
+            return;
+        }
+
+        startThread();
+
+        Message ready;
+        ready.type = MessageType::Ready;
+        sendMessageToCoordinator (encode (ready));
+    }
+
+    void handleBeginJob (const Message& message)
+    {
+        incoming = std::make_unique<Job>();
+        incoming->request = message;
+        incoming->samples.reserve (static_cast<size_t> (juce::jmax ((juce::int64) 0, message.numSamples)));
+    }
+
+    void handleAudioChunk (const Message& message)
+    {
+        if (ring != nullptr && incoming != nullptr && message.jobId == incoming->request.jobId)
+        {
+            const auto count = static_cast<size_t> (message.numSamples);
+            const auto start = incoming->samples.size();
+            incoming->samples.resize (start + count);
+            ring->read (static_cast<size_t> (message.offset), count, incoming->samples.data() + start);
+        }
+
+        // Always acknowledge, so the plugin can reuse the ring space
+        Message consumed;
+        consumed.type = MessageType::ChunkConsumed;
+        consumed.jobId = message.jobId;
+        consumed.numSamples = message.numSamples;
+        sendMessageToCoordinator (encode (consumed));
+
+        if (incoming != nullptr && static_cast<juce::int64> (incoming->samples.size()) >= incoming->request.numSamples)
+        {
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                jobs.push_back (std::move (incoming));
+            }
+
+            cv.notify_all();
+        }
+    }
+
+    void handleCancelJob (const Message& message)
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+
+        // Job ids only grow and the plugin runs one job at a time here, so
+        // everything up to this one is cancelled: also a job the run thread
+        // takes after this, which checks it before it starts
+        cancelledJobId = juce::jmax (cancelledJobId, message.jobId);
+
+        if (incoming != nullptr && incoming->request.jobId <= cancelledJobId)
+            incoming.reset();
+
+        for (auto it = jobs.begin(); it != jobs.end(); )
+            it = (*it)->request.jobId <= cancelledJobId ? jobs.erase (it) : std::next (it);
+
+        if (runningJobId != 0 && runningJobId <= cancelledJobId)
+            engine.cancelTranscription();
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock (mutex);
+                cv.wait (lock, [this] { return threadShouldExit() || !jobs.empty(); });
+
+                if (threadShouldExit())
+                    break;
+
+                job = std::move (jobs.front());
+                jobs.pop_front();
+
+                if (job->request.jobId <= cancelledJobId)
+                    continue; // Nobody waits for its result
+
+                runningJobId = job->request.jobId;
+                engine.resetCancellation(); // The engine no longer clears a cancel itself
+            }
+
+            Message result;
+            result.type = MessageType::JobResult;
+            result.jobId = job->request.jobId;
+            result.kind = job->request.kind;
+
+            engine.setModel (job->request.modelId);
+
+            if (job->request.kind == JobKind::DetectLanguage)
+            {
+                result.language = engine.detectLanguage (job->samples.data(), job->samples.size());
+                result.succeeded = result.language.isNotEmpty();
+            }
+            else
+            {
+                engine.setLanguage (job->request.language);
+                result.result = engine.processSamples (job->samples.data(), job->samples.size());
+                result.language = job->request.language;
+                result.succeeded = true; // An empty transcript is a valid answer (silence)
+            }
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                runningJobId = 0;
+            }
+
+            sendMessageToCoordinator (encode (result));
+        }
+    }
+
+    WhisperEngine engine;
+    std::unique_ptr<SharedAudioRing> ring;
+    std::unique_ptr<Job> incoming; // Only touched on the connection thread
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::unique_ptr<Job>> jobs;
+    juce::int64 runningJobId = 0;
+    juce::int64 cancelledJobId = 0; // Highest job id cancelled
+};
+
+//==============================================================================
+class VoxScriptWorkerApplication : public juce::JUCEApplicationBase
+{
+public:
+    const juce::String getApplicationName() override        { return "VoxScriptWorker"; }
+    const juce::String getApplicationVersion() override     { return ProjectInfo::versionString; }
+    bool moreThanOneInstanceAllowed() override              { return true; }
+
+    void initialise (const juce::String& commandLine) override
+    {
+        service = std::make_unique<TranscriptionWorkerService>();
+
+        // Not launched by the plugin: nothing to do
+        if (!service->initialiseFromCommandLine (commandLine, commandLineUID))
+        {
+            service.reset();
+            setApplicationReturnValue (1);
+            quit();
+        }
+    }
+
+    void shutdown() override                                { service.reset(); }
+    void anotherInstanceStarted (const juce::String&) override {}
+    void systemRequestedQuit() override                     { quit(); }
+    void suspended() override                               {}
+    void resumed() override                                 {}
+    void unhandledException (const std::exception*, const juce::String&, int) override {}
+
+private:
+    std::unique_ptr<TranscriptionWorkerService> service;
+};
+
+} // namespace VoxScript
+
+START_JUCE_APPLICATION (VoxScript::VoxScriptWorkerApplication)